@@ -46,6 +46,7 @@ namespace OpenMS
 
   class MassExplainer;
   class FeatureMap;
+  class LPWrapper;
 
   class OPENMS_DLLAPI ILPDCWrapper
   {
@@ -62,21 +63,29 @@ public:
 
     /// Compute optimal solution and return value of objective function
     /// If the input feature map is empty, a warning is issued and -1 is returned.
-    /// @return value of objective function
+    /// Independent components of the edge graph are solved in slices, each with its own LP.
+    /// With the CBC (Coin-Or) solver, the slices are solved in parallel (if OpenMP is enabled).
+    /// @return value of objective function (summed over all components)
     /// and @p pairs will have all realized edges set to "active"
-    double compute(const FeatureMap fm, PairsType& pairs, Size verbose_level) const;
+    double compute(const FeatureMap& fm, PairsType& pairs, Size verbose_level) const;
 
 private:
 
     /// slicing the problem into subproblems
-    double computeSlice_(const FeatureMap fm,
-                         PairsType& pairs,
+    /// Solves the edges [margin_left, margin_right) of @p pairs with the (empty) LP @p build.
+    /// @p pairs is not modified: the edge scores and the realized edges of the range
+    /// are written to @p edge_scores and @p edge_active (which are indexed like @p pairs).
+    double computeSlice_(const FeatureMap& fm,
+                         const PairsType& pairs,
                          const PairsIndex margin_left,
                          const PairsIndex margin_right,
-                         const Size verbose_level) const;
+                         const Size verbose_level,
+                         LPWrapper& build,
+                         std::vector<double>& edge_scores,
+                         std::vector<char>& edge_active) const;
 
     /// slicing the problem into subproblems
-    double computeSliceOld_(const FeatureMap fm,
+    double computeSliceOld_(const FeatureMap& fm,
                             PairsType& pairs,
                             const PairsIndex margin_left,
                             const PairsIndex margin_right,
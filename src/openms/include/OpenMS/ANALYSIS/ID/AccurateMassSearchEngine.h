@@ -78,7 +78,7 @@ namespace OpenMS
 
     /// checks if an adduct (e.g.a 'M+2K-H;1+') is valid, i.e if the losses (==negative amounts) can actually be lost by the compound given in @p db_entry.
     /// If the negative parts are present in @p db_entry, true is returned.
-    bool isCompatible(EmpiricalFormula db_entry) const;
+    bool isCompatible(const EmpiricalFormula& db_entry) const;
 
     /// get charge of adduct
     int getCharge() const;
@@ -336,8 +336,14 @@ private:
     void parseMappingFile_(const StringList&);
     void parseStructMappingFile_(const StringList&);
     void parseAdductsFile_(const String& filename, std::vector<AdductInfo>& result);
+    /// parse the chemical formula of each DB entry once and record which adducts it is compatible with (see AdductInfo::isCompatible());
+    /// entries whose formula cannot be parsed are left without a table and are checked (and reported) at query time, as before
+    void computeAdductCompatibility_();
     void searchMass_(double neutral_query_mass, double diff_mass, std::pair<Size, Size>& hit_indices) const;
 
+    /// query a single feature and compute the isotope pattern similarity of its hits (one iteration of run(FeatureMap&))
+    void queryAndScoreFeature_(const Feature& feature, const Size& feature_index, const String& ion_mode, std::vector<AccurateMassSearchResult>& results) const;
+
     /// add search results to a Consensus/Feature
     void annotate_(const std::vector<AccurateMassSearchResult>&, BaseFeature&) const;
 
@@ -360,6 +366,8 @@ private:
       double mass;
       std::vector<String> massIDs;
       String formula;
+      std::vector<bool> pos_compatible; //< compatibility with each entry in pos_adducts_ (same order); empty if 'formula' could not be parsed
+      std::vector<bool> neg_compatible; //< compatibility with each entry in neg_adducts_ (same order); empty if 'formula' could not be parsed
     };
     std::vector<MappingEntry_> mass_mappings_;
 
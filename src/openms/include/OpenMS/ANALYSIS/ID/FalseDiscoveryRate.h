@@ -107,6 +107,21 @@ private:
     ///Not implemented
     FalseDiscoveryRate & operator=(const FalseDiscoveryRate &);
 
+    /// compact representation of a peptide hit used during FDR calculation
+    struct FDREntry_
+    {
+      enum HitType {TARGET, DECOY, UNKNOWN};
+
+      double score; ///< original score of the hit
+      double fdr; ///< resulting FDR / q-value
+      HitType type; ///< target/decoy annotation of the hit
+      Size group; ///< index of the run/charge group the hit belongs to
+
+      FDREntry_() :
+        score(0.0), fdr(0.0), type(UNKNOWN), group(0)
+      {}
+    };
+
     /// calculates the fdr stored into fdrs, given two vectors of scores
     void calculateFDRs_(Map<double, double> & score_to_fdr, std::vector<double> & target_scores, std::vector<double> & decoy_scores, bool q_value, bool higher_score_better);
 
@@ -78,6 +78,19 @@ public:
     */
     explicit SpectrumAccessOpenMSCached(String filename);
 
+    /**
+      @brief Constructor, opens the file stream using meta data already in memory
+
+      @param filename The filename of the .mzML file (only the second file
+      .mzML.cached needs to exist, the meta data is not read from disk).
+      @param meta_experiment The meta data corresponding to the cached file
+      (e.g. as produced by CachedmzML::createMetadata)
+
+      @throws Exception::FileNotFound is thrown if the cached file is not found
+      @throws Exception::ParseError is thrown if the cached file cannot be parsed
+    */
+    SpectrumAccessOpenMSCached(String filename, const MSExperimentType& meta_experiment);
+
     /**
       @brief Destructor
     */
@@ -160,16 +160,22 @@ private:
 
     /// Subfunction of dia_isotope_scores
     void diaIsotopeScoresSub_(const std::vector<TransitionType>& transitions,
-                                SpectrumPtrType spectrum, std::map<std::string, double>& intensities,
+                                SpectrumPtrType spectrum, const std::vector<double>& intensities,
                                 double& isotope_corr, double& isotope_overlap);
 
     /// retrieves intensities from MRMFeature
     /// computes a vector of relative intensities for each feature (output to intensities)
     void getFirstIsotopeRelativeIntensities_(const std::vector<TransitionType>& transitions,
                                             OpenSwath::IMRMFeature* mrmfeature,
-                                            std::map<std::string, double>& intensities //experimental intensities of transitions
+                                            std::vector<double>& intensities //experimental intensities of transitions (same order)
                                             );
 
+    /// appends the windows of the (dia_nr_isotopes_ + 1) isotopic peaks starting at mono_mz
+    void addIsotopeWindows_(double mono_mz, double charge, std::vector<double>& left, std::vector<double>& right) const;
+
+    /// appends the windows of the dia_nr_charges_ putative peaks before mono_mz (see largePeaksBeforeFirstIsotope_)
+    void addPeaksBeforeFirstIsotopeWindows_(double mono_mz, std::vector<double>& left, std::vector<double>& right) const;
+
 private:
 
     /**
@@ -180,14 +186,18 @@ private:
       at a lower m/z that could explain the current peak as part of a isotope
       pattern.
 
-      @param spectrum The spectrum (MS1 or MS2)
       @param mono_mz The m/z value where a monoisotopic is expected
       @param mono_int The intensity of the monoisotopic peak (peak at mono_mz)
+      @param mzs The integrated m/z values of the windows added by addPeaksBeforeFirstIsotopeWindows_ (for charge 1, 2, ...)
+      @param intensities The integrated intensities of these windows (zero if no signal was found)
+      @param offset The index of the window for charge 1 in mzs and intensities
       @param nr_occurences Will contain the count of how often a peak is found at lower m/z than mono_mz with an intensity higher than mono_int. Multiple charge states are tested, see class parameter dia_nr_charges_
       @param nr_occurences Will contain the maximum ratio of a peaks intensity compared to the monoisotopic peak intensity how often a peak is found at lower m/z than mono_mz with an intensity higher than mono_int. Multiple charge states are tested, see class parameter dia_nr_charges_
 
     */
-    void largePeaksBeforeFirstIsotope_(SpectrumPtrType spectrum, double mono_mz, double mono_int, int& nr_occurences, double& max_ratio);
+    void largePeaksBeforeFirstIsotope_(double mono_mz, double mono_int,
+                                       const std::vector<double>& mzs, const std::vector<double>& intensities, Size offset,
+                                       int& nr_occurences, double& max_ratio);
 
     /**
       @brief Compare an experimental isotope pattern to a theoretical one
@@ -136,6 +136,11 @@ public:
                         TransformationDescription trafo, MSExperiment<Peak1D>& swath_map);
 
     /** @brief Pick features in one experiment containing chromatogram
+     *
+     * The transition groups are picked and scored in parallel (if OpenMP is
+     * enabled), using separate scoring instances per thread. The features are
+     * reported in the order of the transition groups independent of the
+     * number of threads.
      *
      * @param input The input chromatograms
      * @param output The output features with corresponding scores
@@ -279,6 +284,7 @@ private:
     std::map<OpenMS::String, const PeptideType*> PeptideRefMap_;
     OpenSwath_Scores_Usage su_;
     OpenMS::DIAScoring diascoring_;
+    OpenSwathScoring scorer_;
     OpenMS::EmgScoring emgscoring_;
 
     // data 
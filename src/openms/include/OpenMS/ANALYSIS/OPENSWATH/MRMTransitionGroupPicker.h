@@ -51,6 +51,7 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/OPENSWATHALGO/ALGO/Scoring.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/OPENSWATHALGO/ALGO/StatsHelpers.h>
 
+#include <algorithm>
 #include <numeric>
 
 //#define DEBUG_TRANSITIONGROUPPICKER
@@ -74,6 +75,12 @@ namespace OpenMS
 
   Step 2 is performed by finding the largest peak overall and use this to
   create a feature, propagating this through all chromatograms.
+
+  The input chromatograms are only read (and sorted if necessary). All
+  resampling for a feature is performed in two chromatograms (of the
+  chromatogram type of the transition group) which are reused for all of its
+  transitions. One picker should be used per thread when picking transition
+  groups in parallel.
   */
 
   class OPENMS_DLLAPI MRMTransitionGroupPicker :
@@ -116,15 +123,20 @@ public:
     void pickTransitionGroup(MRMTransitionGroup<SpectrumT, TransitionT>& transition_group)
     {
       std::vector<RichPeakChromatogram> picked_chroms_;
-
-      PeakPickerMRM picker;
-      picker.setParameters(param_.copy("PeakPickerMRM:", true));
+      picked_chroms_.reserve(transition_group.getChromatograms().size());
 
       // Pick chromatograms
       for (Size k = 0; k < transition_group.getChromatograms().size(); k++)
       {
         RichPeakChromatogram& chromatogram = transition_group.getChromatograms()[k];
-        String native_id = chromatogram.getNativeID();
+
+        // all chromatograms need to be sorted for the binary searches during feature creation
+        if (!chromatogram.isSorted())
+        {
+          chromatogram.sortByPosition();
+        }
+
+        const String& native_id = chromatogram.getNativeID();
         if (transition_group.getTransitions().size() > 0 && 
             transition_group.hasTransition(native_id)  && 
             !transition_group.getTransition(native_id).isDetectingTransition() )
@@ -132,14 +144,10 @@ public:
           continue;
         }
 
-        if (!chromatogram.isSorted())
-        {
-          chromatogram.sortByPosition();
-        }
-        RichPeakChromatogram picked_chrom;
-        picker.pickChromatogram(chromatogram, picked_chrom);
+        picked_chroms_.push_back(RichPeakChromatogram());
+        RichPeakChromatogram& picked_chrom = picked_chroms_.back();
+        picker_.pickChromatogram(chromatogram, picked_chrom);
         picked_chrom.sortByIntensity(); // we could do without that
-        picked_chroms_.push_back(picked_chrom);
       }
 
       // Find features (peak groups) in this group of transitions.
@@ -232,11 +240,11 @@ public:
         mrmFeature.setOverallQuality(qual);
       }
 
-      // Prepare linear resampling of all the chromatograms, here creating the
-      // empty master_peak_container with the same RT (m/z) values as the reference
+      // Prepare linear resampling of all the chromatograms, here filling the
+      // master container with the same RT (m/z) values as the reference
       // chromatogram.
-      SpectrumT master_peak_container;
       const SpectrumT& ref_chromatogram = transition_group.getChromatogram(picked_chroms[chr_idx].getNativeID());
+      SpectrumT master_peak_container, resampled_peak_container;
       prepareMasterContainer_(ref_chromatogram, master_peak_container, best_left, best_right);
 
       double total_intensity = 0; double total_peak_apices = 0; double total_xic = 0;
@@ -251,9 +259,8 @@ public:
           }
         }
 
-        // resample the current chromatogram
-        const SpectrumT used_chromatogram = resampleChromatogram_(chromatogram, master_peak_container, best_left, best_right);
-        // const SpectrumT& used_chromatogram = chromatogram; // instead of resampling
+        // resample the current chromatogram (the result is only valid until the next resampling)
+        const SpectrumT& used_chromatogram = resampleChromatogram_(chromatogram, master_peak_container, best_left, best_right, resampled_peak_container);
 
         Feature f;
         double quality = 0;
@@ -263,24 +270,24 @@ public:
         ConvexHull2D::PointArrayType hull_points;
         double intensity_sum(0.0), rt_sum(0.0);
         double peak_apex_int = -1;
-        double peak_apex_dist = std::fabs(used_chromatogram.begin()->getMZ() - peak_apex);
-        // FEATURE : use RTBegin / MZBegin -> for this we need to know whether the template param is a real chromatogram or a spectrum!
-        for (typename SpectrumT::const_iterator it = used_chromatogram.begin(); it != used_chromatogram.end(); it++)
+        double peak_apex_dist = used_chromatogram.empty() ? 0.0 : std::fabs(used_chromatogram.begin()->getMZ() - peak_apex);
+        // only the points strictly within (best_left, best_right) contribute
+        typename SpectrumT::const_iterator it = std::upper_bound(used_chromatogram.begin(), used_chromatogram.end(), best_left, PositionLess_());
+        typename SpectrumT::const_iterator it_end = std::lower_bound(it, used_chromatogram.end(), best_right, PositionLess_());
+        hull_points.reserve(std::distance(it, it_end));
+        for (; it != it_end; ++it)
         {
-          if (it->getMZ() > best_left && it->getMZ() < best_right)
+          DPosition<2> p;
+          p[0] = it->getMZ();
+          p[1] = it->getIntensity();
+          hull_points.push_back(p);
+          if (std::fabs(it->getMZ() - peak_apex) <= peak_apex_dist)
           {
-            DPosition<2> p;
-            p[0] = it->getMZ();
-            p[1] = it->getIntensity();
-            hull_points.push_back(p);
-            if (std::fabs(it->getMZ() - peak_apex) <= peak_apex_dist)
-            {
-              peak_apex_int = p[1];
-              peak_apex_dist = std::fabs(it->getMZ() - peak_apex);
-            }
-            rt_sum += it->getMZ();
-            intensity_sum += it->getIntensity();
+            peak_apex_int = p[1];
+            peak_apex_dist = std::fabs(it->getMZ() - peak_apex);
           }
+          rt_sum += it->getMZ();
+          intensity_sum += it->getIntensity();
         }
 
         if (background_subtraction_ != "none")
@@ -340,7 +347,7 @@ public:
         const SpectrumT& chromatogram = transition_group.getPrecursorChromatogram("Precursor_i0");
 
         // resample the current chromatogram
-        const SpectrumT used_chromatogram = resampleChromatogram_(chromatogram, master_peak_container, best_left, best_right);
+        const SpectrumT& used_chromatogram = resampleChromatogram_(chromatogram, master_peak_container, best_left, best_right, resampled_peak_container);
 
         Feature f;
         double quality = 0;
@@ -350,24 +357,24 @@ public:
         ConvexHull2D::PointArrayType hull_points;
         double intensity_sum(0.0), rt_sum(0.0);
         double peak_apex_int = -1;
-        double peak_apex_dist = std::fabs(used_chromatogram.begin()->getMZ() - peak_apex);
-        // FEATURE : use RTBegin / MZBegin -> for this we need to know whether the template param is a real chromatogram or a spectrum!
-        for (typename SpectrumT::const_iterator it = used_chromatogram.begin(); it != used_chromatogram.end(); it++)
+        double peak_apex_dist = used_chromatogram.empty() ? 0.0 : std::fabs(used_chromatogram.begin()->getMZ() - peak_apex);
+        // only the points strictly within (best_left, best_right) contribute
+        typename SpectrumT::const_iterator it = std::upper_bound(used_chromatogram.begin(), used_chromatogram.end(), best_left, PositionLess_());
+        typename SpectrumT::const_iterator it_end = std::lower_bound(it, used_chromatogram.end(), best_right, PositionLess_());
+        hull_points.reserve(std::distance(it, it_end));
+        for (; it != it_end; ++it)
         {
-          if (it->getMZ() > best_left && it->getMZ() < best_right)
+          DPosition<2> p;
+          p[0] = it->getMZ();
+          p[1] = it->getIntensity();
+          hull_points.push_back(p);
+          if (std::fabs(it->getMZ() - peak_apex) <= peak_apex_dist)
           {
-            DPosition<2> p;
-            p[0] = it->getMZ();
-            p[1] = it->getIntensity();
-            hull_points.push_back(p);
-            if (std::fabs(it->getMZ() - peak_apex) <= peak_apex_dist)
-            {
-              peak_apex_int = p[1];
-              peak_apex_dist = std::fabs(it->getMZ() - peak_apex);
-            }
-            rt_sum += it->getMZ();
-            intensity_sum += it->getIntensity();
+            peak_apex_int = p[1];
+            peak_apex_dist = std::fabs(it->getMZ() - peak_apex);
           }
+          rt_sum += it->getMZ();
+          intensity_sum += it->getIntensity();
         }
 
         if (chromatogram.metaValueExists("precursor_mz")) 
@@ -485,22 +492,22 @@ protected:
       // collect the raw intensities. For resampling, use a bit more on either
       // side to correctly identify shoulders etc.
       double resample_boundary = 15.0; // sample 15 seconds more on each side
-      SpectrumT master_peak_container;
       const SpectrumT& ref_chromatogram = transition_group.getChromatogram(picked_chroms[chr_idx].getNativeID());
+      SpectrumT master_peak_container, resampled_peak_container;
       prepareMasterContainer_(ref_chromatogram, master_peak_container, best_left - resample_boundary, best_right + resample_boundary);
-      std::vector<std::vector<double> > all_ints;
+      std::vector<std::vector<double> > all_ints(picked_chroms.size());
       for (Size k = 0; k < picked_chroms.size(); k++)
       {
         const SpectrumT& chromatogram = transition_group.getChromatogram(picked_chroms[k].getNativeID());
-        const SpectrumT used_chromatogram = resampleChromatogram_(chromatogram, 
-            master_peak_container, best_left - resample_boundary, best_right + resample_boundary);
+        const SpectrumT& used_chromatogram = resampleChromatogram_(chromatogram, master_peak_container,
+            best_left - resample_boundary, best_right + resample_boundary, resampled_peak_container);
 
-        std::vector<double> int_here;
+        std::vector<double>& int_here = all_ints[k];
+        int_here.reserve(used_chromatogram.size());
         for (Size i = 0; i < used_chromatogram.size(); i++)
         {
           int_here.push_back(used_chromatogram[i].getIntensity());
         }
-        all_ints.push_back(int_here);
       }
 
       // Compute the cross-correlation for the collected intensities
@@ -724,6 +731,7 @@ protected:
       positions where the reference chromatogram has values. The container will
       only be populated between the boundaries given. The output container
       will contain peaks with mz / RT values but all intensity values will be zero.
+      A container that was used before is overwritten (and its memory reused).
 
       @param ref_chromatogram Reference chromatogram containing mz / RT values (possibly beyond the desired range)
       @param master_peak_container Output container to be populated
@@ -735,62 +743,87 @@ protected:
     void prepareMasterContainer_(const SpectrumT& ref_chromatogram,
                                  SpectrumT& master_peak_container, double left_boundary, double right_boundary)
     {
-      OPENMS_PRECONDITION(master_peak_container.empty(), "Master peak container must be empty")
-
-      // get the start / end point of this chromatogram => then add one more
-      // point beyond the two boundaries to make the resampling accurate also
-      // at the edge.
-      typename SpectrumT::const_iterator begin = ref_chromatogram.begin();
-      while (begin != ref_chromatogram.end() && begin->getMZ() < left_boundary) {begin++; }
-      if (begin != ref_chromatogram.begin()) {begin--; }
-
-      typename SpectrumT::const_iterator end = begin;
-      while (end != ref_chromatogram.end() && end->getMZ() < right_boundary) {end++; }
-      if (end != ref_chromatogram.end()) {end++; }
+      typename SpectrumT::const_iterator begin, end;
+      findBoundaryRange_(ref_chromatogram, left_boundary, right_boundary, begin, end);
 
       // resize the master container and set the m/z values to the ones of the master container
-      master_peak_container.resize(distance(begin, end)); // initialize to zero
+      master_peak_container.resize(std::distance(begin, end));
       typename SpectrumT::iterator it = master_peak_container.begin();
-      for (typename SpectrumT::const_iterator chrom_it = begin; chrom_it != end; chrom_it++, it++)
+      for (typename SpectrumT::const_iterator chrom_it = begin; chrom_it != end; ++chrom_it, ++it)
       {
         it->setMZ(chrom_it->getMZ());
+        it->setIntensity(0.0);
       }
     }
 
     /**
       @brief Resample a container at the positions indicated by the master peak container
 
+      The result is written to @p resampled_peak_container (reusing its
+      memory), so it is only valid until the container is used again.
+
       @param chromatogram Container with the input data
       @param master_peak_container Container with the mz / RT values at which to resample
       @param left_boundary Left boundary of values the container should be resampled
       @param right_boundary Right boundary of values the container should be resampled
+      @param resampled_peak_container Output container
 
-      @return A container which contains the data from the input chromatogram resampled at the positions of the master container
+      @return @p resampled_peak_container, which contains the data from the input chromatogram resampled at the positions of the master container
     */
     template <typename SpectrumT>
-    SpectrumT resampleChromatogram_(const SpectrumT& chromatogram,
-                                    const SpectrumT& master_peak_container, double left_boundary, double right_boundary)
+    const SpectrumT& resampleChromatogram_(const SpectrumT& chromatogram,
+                                           const SpectrumT& master_peak_container, double left_boundary, double right_boundary,
+                                           SpectrumT& resampled_peak_container)
     {
-      // get the start / end point of this chromatogram => then add one more
-      // point beyond the two boundaries to make the resampling accurate also
-      // at the edge.
-      typename SpectrumT::const_iterator begin = chromatogram.begin();
-      while (begin != chromatogram.end() && begin->getMZ() < left_boundary) {begin++;}
-      if (begin != chromatogram.begin()) {begin--;}
-
-      typename SpectrumT::const_iterator end = begin;
-      while (end != chromatogram.end() && end->getMZ() < right_boundary) {end++;}
-      if (end != chromatogram.end()) {end++;}
-
-      SpectrumT resampled_peak_container = master_peak_container; // copy the master container, which contains the RT values
-      LinearResamplerAlign lresampler;
-      lresampler.raster(begin, end, resampled_peak_container.begin(), resampled_peak_container.end());
+      typename SpectrumT::const_iterator begin, end;
+      findBoundaryRange_(chromatogram, left_boundary, right_boundary, begin, end);
 
+      // copy the master container, which contains the RT values
+      resampled_peak_container.resize(master_peak_container.size());
+      std::copy(master_peak_container.begin(), master_peak_container.end(), resampled_peak_container.begin());
+      if (!resampled_peak_container.empty())
+      {
+        resampler_.raster(begin, end, resampled_peak_container.begin(), resampled_peak_container.end());
+      }
       return resampled_peak_container;
     }
 
     //@}
 
+    /// Compares the position (RT) of a chromatogram peak with a value (for binary searches in sorted chromatograms)
+    struct PositionLess_
+    {
+      template <typename PeakT>
+      bool operator()(const PeakT& peak, double position) const
+      {
+        return peak.getMZ() < position;
+      }
+
+      template <typename PeakT>
+      bool operator()(double position, const PeakT& peak) const
+      {
+        return position < peak.getMZ();
+      }
+    };
+
+    /**
+      @brief Find the range of a (sorted) chromatogram that covers the given boundaries
+
+      The range starts one point before the left boundary and ends one point
+      after the right boundary (if available) to make the resampling accurate
+      also at the edge.
+    */
+    template <typename SpectrumT>
+    void findBoundaryRange_(const SpectrumT& chromatogram, double left_boundary, double right_boundary,
+                            typename SpectrumT::const_iterator& begin, typename SpectrumT::const_iterator& end) const
+    {
+      begin = std::lower_bound(chromatogram.begin(), chromatogram.end(), left_boundary, PositionLess_());
+      if (begin != chromatogram.begin()) {--begin; }
+
+      end = std::lower_bound(begin, chromatogram.end(), right_boundary, PositionLess_());
+      if (end != chromatogram.end()) {++end; }
+    }
+
     /**
       @brief Will use the chromatogram to estimate the background noise and then subtract it
 
@@ -809,6 +842,11 @@ protected:
     double stop_after_intensity_ratio_;
     double min_peak_width_;
     double recalculate_peaks_max_z_;
+
+    /// Peak picker for the individual chromatograms
+    PeakPickerMRM picker_;
+    /// Resampler used for all chromatograms
+    LinearResamplerAlign resampler_;
   };
 }
 
@@ -46,6 +46,9 @@
 
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <list>
 
 namespace OpenMS
 {
@@ -415,6 +418,15 @@ var_yseries_score   -0.0327896378737766
   /** @brief A class that calls the scoring routines
    *
    * Use this class to invoke the individual OpenSWATH scoring routines.
+   *
+   * The (added) spectra retrieved for the full-spectrum scores are kept in a
+   * small least-recently-used cache, since many peakgroups (of the same or of
+   * co-eluting compounds) are scored against the same spectra. Thus, an
+   * instance should be reused for all peakgroups of a SWATH map, but it
+   * must not be shared between threads. The cache only holds spectra of
+   * one map (without keeping the map alive). It is cleared when spectra of
+   * a different map are requested or when initialize() changes the
+   * settings for adding up spectra.
    * 
   */
   class OPENMS_DLLAPI OpenSwathScoring 
@@ -422,11 +434,26 @@ var_yseries_score   -0.0327896378737766
     typedef OpenSwath::LightCompound CompoundType;
     typedef OpenSwath::LightTransition TransitionType;
 
+    /// An (added) spectrum in the cache, identified by its closest spectrum and number of added spectra
+    struct AddedSpectrum_
+    {
+      int closest_idx;
+      int nr_spectra_to_add;
+      OpenSwath::SpectrumPtr spectrum;
+    };
+
     double rt_normalization_factor_;
     int add_up_spectra_;
     double spacing_for_spectra_resampling_;
     OpenSwath_Scores_Usage su_;
 
+    /// Recently used (added) spectra of added_spectra_map_, the most recent one first
+    std::list<AddedSpectrum_> added_spectra_cache_;
+    /// The map of the spectra in added_spectra_cache_ (not kept alive by the cache)
+    boost::weak_ptr<OpenSwath::ISpectrumAccess> added_spectra_map_;
+    /// Maximal number of spectra in added_spectra_cache_
+    Size added_spectra_cache_size_;
+
   public:
 
     /// Constructor
@@ -575,6 +602,9 @@ var_yseries_score   -0.0327896378737766
      * around the given retention time and return an "averaged" spectrum which
      * may contain less noise.
      *
+     * Recently requested spectra are returned from a cache, the returned
+     * spectrum must therefore not be modified.
+     *
      * @param swath_map The map containing the spectra
      * @param RT The target retention time
      * @param nr_spectra_to_add How many spectra to add up
@@ -54,9 +54,21 @@ namespace OpenMS
 public:
 
     /// adds up a list of Spectra by resampling them and then addition of intensities
-    static OpenSwath::SpectrumPtr addUpSpectra(std::vector<OpenSwath::SpectrumPtr> all_spectra,
+    static OpenSwath::SpectrumPtr addUpSpectra(const std::vector<OpenSwath::SpectrumPtr> & all_spectra,
         double sampling_rate, double filter_zeros);
 
+private:
+
+    /**
+      @brief Resamples a spectrum onto an equally spaced raster and adds it to the given intensities
+
+      The raster starts at @p start_mz and has one point per entry of @p
+      resampled_intensity, spaced by @p sampling_rate (see
+      LinearResamplerAlign::raster for the algorithm).
+    */
+    static void rasterAdd_(const std::vector<double> & mz, const std::vector<double> & intensity,
+        double start_mz, double sampling_rate, std::vector<double> & resampled_intensity);
+
   };
 }
 
@@ -0,0 +1,103 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#ifndef OPENMS_ANALYSIS_OPENSWATH_TRANSITIONBINARYFILE_H
+#define OPENMS_ANALYSIS_OPENSWATH_TRANSITIONBINARYFILE_H
+
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <OpenMS/ANALYSIS/OPENSWATH/OPENSWATHALGO/DATAACCESS/TransitionExperiment.h>
+
+namespace OpenMS
+{
+
+  /**
+    @brief Binary file format for OpenSWATH assay libraries
+
+    Stores a OpenSwath::LightTargetedExperiment in a compact, column-oriented
+    binary format (default file extension: .oslib). Compared to the TSV and
+    TraML formats, no text needs to be parsed and no references need to be
+    resolved when loading: the file is memory-mapped, every column is copied
+    in one block and the transitions reference their compounds by index.
+
+    The file starts with a magic string, a byte order mark and a format version, followed by
+    the number of proteins, compounds and transitions and one column per
+    member of LightProtein, LightCompound and LightTransition. Numbers are
+    stored in the native byte order, thus the files are not meant to be
+    exchanged between machines of different endianness (like cached mzML
+    files).
+
+    Use the OpenSwathAssayLibraryCacher utility to convert TraML or TSV
+    assay libraries into this format.
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI TransitionBinaryFile :
+    public ProgressLogger
+  {
+
+public:
+
+    /// Default constructor
+    TransitionBinaryFile();
+
+    /// Destructor
+    virtual ~TransitionBinaryFile();
+
+    /**
+      @brief Stores an assay library in binary format
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String & filename, const OpenSwath::LightTargetedExperiment & exp);
+
+    /**
+      @brief Loads an assay library stored in binary format
+
+      The content of @p exp is replaced.
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a (valid) binary assay library
+    */
+    void load(const String & filename, OpenSwath::LightTargetedExperiment & exp);
+
+    /// Returns whether the file starts with the magic number of a binary assay library
+    static bool isBinaryLibrary(const String & filename);
+
+  };
+
+}
+
+#endif // OPENMS_ANALYSIS_OPENSWATH_TRANSITIONBINARYFILE_H
@@ -21,6 +21,7 @@ set(sources_list_h
   SpectrumAddition.h
   SwathMapMassCorrection.h
   SwathWindowLoader.h
+  TransitionBinaryFile.h
   TransitionTSVReader.h
 )
 
@@ -204,9 +204,9 @@ private:
     /**
          @brief Gather quantitative information from a feature.
 
-         Store quantitative information from @p feature in member @p pep_quant_, based on the peptide annotation in @p hit. If @p hit is empty ("ambiguous/no annotation"), nothing is stored.
+         Add the intensity of @p feature to the abundance of its sample in @p abundances, the entry of member @p pep_quant_ for the peptide and charge annotated to the feature. The entry is looked up by the caller, once for all features with the same annotation.
     */
-    void quantifyFeature_(const FeatureHandle& feature, const PeptideHit& hit);
+    void quantifyFeature_(const FeatureHandle& feature, SampleAbundances& abundances);
 
     /**
          @brief Order keys (charges/peptides for peptide/protein quantification) according to how many samples they allow to quantify, breaking ties by total abundance.
@@ -214,7 +214,7 @@ private:
          The keys of @p abundances are stored ordered in @p result, best first.
     */
     template <typename T>
-    void orderBest_(const std::map<T, SampleAbundances> abundances,
+    void orderBest_(const std::map<T, SampleAbundances>& abundances,
                     std::vector<T>& result)
     {
       typedef std::pair<Size, double> PairType;
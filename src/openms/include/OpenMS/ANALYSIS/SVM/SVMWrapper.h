@@ -476,6 +476,19 @@ public:
     */
     void setWeights(const std::vector<Int>& weight_labels, const std::vector<double>& weights);
 
+    /**
+      @brief Sets the memory (in bytes) performCrossValidation() may use for the oligo kernel cache and the kernel matrices of concurrently evaluated folds
+
+      If the kernel of all pairs of labeled sequences does not fit, the kernel matrices of each fold
+      are computed directly. The number of folds evaluated concurrently is reduced so that their
+      kernel matrices fit into the remaining memory (at least one fold is always evaluated).
+      Default: 1 GB.
+    */
+    void setCrossValidationMemoryLimit(Size bytes);
+
+    /// returns the memory (in bytes) performCrossValidation() may use (see setCrossValidationMemoryLimit())
+    Size getCrossValidationMemoryLimit() const;
+
 private:
     /**
        @brief find next grid search parameter combination
@@ -491,6 +504,50 @@ private:
 
     Size getNumberOfEnclosedPoints_(double m1, double m2, const std::vector<std::pair<double, double> >& points);
 
+    /**
+      @brief Distributes the indices 0 .. 'size' - 1 randomly into 'number' partitions
+
+      This is the partitioning used by createRandomPartitions().
+    */
+    static void createRandomPartitionIndices_(Size size, Size number, std::vector<std::vector<Size> >& partition_indices);
+
+    /**
+      @brief Computes the oligo kernel of every ordered pair of sequences in 'data'
+
+      The value for sequences a and b is stored at 'kernel_cache'[a * n + b].
+      Rows are computed in parallel. The cache needs n^2 doubles, so performCrossValidation()
+      only uses it if it fits into the cross validation memory limit.
+    */
+    static void computeKernelCache_(const SVMData& data, const std::vector<double>& gauss_table, std::vector<double>& kernel_cache);
+
+    /**
+      @brief Builds the precomputed kernel matrix of the sequences 'rows' vs. 'columns' from a kernel cache
+
+      The result is the same as computeKernelMatrix() for the corresponding subsets
+      of the cached data. Passing the same vector for 'rows' and 'columns' builds a training matrix.
+    */
+    static svm_problem* sliceKernelMatrix_(const std::vector<double>& kernel_cache, const std::vector<double>& labels, const std::vector<Size>& rows, const std::vector<Size>& columns);
+
+    /**
+      @brief Trains a model for one fold of a cross validation and computes its performance on the held-out data
+
+      Only 'parameter' and the given data are used (no model or training set of this
+      instance), so folds using labeled data or a libsvm kernel can be evaluated concurrently.
+      For labeled data, the kernel matrices are sliced from 'kernel_cache' using the indices.
+      If 'kernel_cache' is empty, they are computed with computeKernelMatrix() and the member gauss table instead.
+      Returns false if the model could not be trained.
+    */
+    bool evaluateCrossValidationFold_(const svm_parameter& parameter,
+                                      svm_problem* training_set,
+                                      svm_problem* test_set,
+                                      const SVMData* labeled_data,
+                                      const std::vector<double>& kernel_cache,
+                                      const std::vector<Size>& training_indices,
+                                      const std::vector<Size>& test_indices,
+                                      const std::vector<double>& real_labels,
+                                      bool mcc_as_performance_measure,
+                                      double& performance);
+
     /**
       @brief Initializes the svm with standard parameters
     */
@@ -514,6 +571,7 @@ private:
     svm_problem* training_set_; // the training set
     svm_problem* training_problem_; // the training set
     SVMData training_data_; // the training set (different encoding)
+    Size cv_memory_limit_; // memory (in bytes) for the kernel cache and fold matrices of performCrossValidation()
   };
 
 } // namespace OpenMS
@@ -38,6 +38,7 @@
 #include <OpenMS/DATASTRUCTURES/DistanceMatrix.h>
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/COMPARISON/CLUSTERING/ClusterAnalyzer.h>
+#include <OpenMS/CONCEPT/ProgressLogger.h>
 
 #include <vector>
 
@@ -100,6 +101,31 @@ public:
     /// registers all derived products
     static void registerChildren();
 
+protected:
+
+    /// Lance-Williams distance updates supported by nearestNeighborChain_()
+    enum LinkageUpdate
+    {
+      COMPLETE_LINKAGE_UPDATE, ///< distance of merged clusters is the maximum distance
+      AVERAGE_LINKAGE_UPDATE ///< distance of merged clusters is the size-weighted average distance
+    };
+
+    /**
+        @brief Clusters with the nearest-neighbor chain algorithm in O(n^2) time
+
+        Instead of searching the globally closest pair of clusters after each merge, a chain of
+        nearest neighbors is followed until two clusters are mutual nearest neighbors, which are
+        then merged. For reducible linkages (complete and average linkage) this yields the same
+        merges as the greedy algorithm. Ties are broken like in the greedy algorithm, i.e. by the
+        smaller (larger cluster index, smaller cluster index) pair.
+
+        The merges are sorted by distance and written to @p cluster_tree in the format described in
+        operator(), including the dummy nodes after @p threshold is reached.
+
+        @p original_distance is used as workspace (merged distances are written in place, its size is not changed).
+    */
+    void nearestNeighborChain_(DistanceMatrix<float> & original_distance, std::vector<BinaryTreeNode> & cluster_tree, const float threshold, LinkageUpdate update, const ProgressLogger & logger) const;
+
   };
 
 }
@@ -96,6 +96,7 @@ public:
         for @ref PeakSpectrum with a @ref PeakSpectrumCompareFunctor.
         The similarity functor must provide the similarity calculation with the ()-operator and
         yield normalized values in range of [0,1] for the type of < Data >.
+        The distances are computed in parallel (if OpenMP is enabled), so the ()-operator has to be thread-safe.
 
         @param data vector of objects to be clustered
         @param comparator similarity functor fitting for types in data
@@ -112,9 +113,13 @@ public:
         //create distancematrix for data with comparator
         original_distance.clear();
         original_distance.resize(data.size(), 1);
-        for (Size i = 0; i < data.size(); i++)
+        // rows have different lengths, so distribute them dynamically
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (SignedSize i = 0; i < (SignedSize)data.size(); i++)
         {
-          for (Size j = 0; j < i; j++)
+          for (SignedSize j = 0; j < i; j++)
           {
             //distance value is 1-similarity value, since similarity is in range of [0,1]
             original_distance.setValueQuick(i, j, 1 - comparator(data[i], data[j]));
@@ -160,14 +165,18 @@ public:
       original_distance.clear();
       original_distance.resize(data.size(), 1);
 
-      for (Size i = 0; i < binned_data.size(); i++)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)binned_data.size(); i++)
       {
-        for (Size j = 0; j < i; j++)
+        for (SignedSize j = 0; j < i; j++)
         {
           //distance value is 1-similarity value, since similarity is in range of [0,1]
-          original_distance.setValue(i, j, 1 - comparator(binned_data[i], binned_data[j]));
+          original_distance.setValueQuick(i, j, 1 - comparator(binned_data[i], binned_data[j]));
         }
       }
+      original_distance.updateMinElement();
 
       // create Clustering with ClusterMethod, DistanceMatrix and Data
       clusterer(original_distance, cluster_tree, threshold_);
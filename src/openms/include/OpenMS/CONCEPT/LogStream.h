@@ -45,6 +45,9 @@
 #include <ctime>
 #include <map>
 
+class QAtomicInt;
+template <class T> class QThreadStorage;
+
 namespace OpenMS
 {
   /**
@@ -99,6 +102,14 @@ namespace OpenMS
       the logline (with its prefix, see  LogStream::setPrefix )
       is also copied to the associated stream and this stream is
       flushed, too.
+
+      Characters written to the buffer are collected in a buffer which is
+      private to the writing thread, i.e. lines of different threads
+      cannot interleave. Only when the buffer is flushed, the complete lines
+      are handed over to the associated streams (while holding a lock which
+      is shared by all LogStreamBufs). The thread buffers are thread-local
+      storage, so writing to them does not take a lock. Whatever they still
+      hold is written out when the thread ends or the LogStreamBuf is destroyed.
     */
     class OPENMS_DLLAPI LogStreamBuf :
       public std::streambuf
@@ -136,20 +147,24 @@ public:
       /**
         This method is called as soon as the ostream is flushed
         (especially this method is called by flush or endl).
-        It transfers the contents of the streambufs putbuffer
-        into a logline if a newline or linefeed character
-        is found in the buffer ("\n" or "\r" resp.).
-        The line is then removed from the putbuffer.
-        Incomplete lines (not terminated by "\n" / "\r" are
-        stored in incomplete_line_.
+        It transfers the contents of the calling thread's buffer
+        into a logline if a newline character
+        is found in the buffer ("\n").
+        The line is then removed from the buffer.
+        Incomplete lines (not terminated by "\n") remain
+        in the thread's buffer.
       */
       virtual int sync();
 
       /**
-        This method calls sync and <tt>streambuf::overflow(c)</tt> to
-        prevent a buffer overflow.
+        Appends a single character to the calling thread's buffer.
       */
       virtual int overflow(int c = -1);
+
+      /**
+        Appends @p n characters to the calling thread's buffer.
+      */
+      virtual std::streamsize xsputn(const char * s, std::streamsize n);
       //@}
 
 
@@ -201,15 +216,26 @@ public:
 protected:
 
       /// Distribute a new message to connected streams.
-      void distribute_(std::string outstring);
+      void distribute_(const std::string & outstring);
 
       /// Interpret the prefix format string and return the expanded prefix.
       std::string expandPrefix_(const std::string & prefix, time_t time) const;
 
-      char * pbuf_;
+      /// Returns the buffer of this LogStreamBuf which belongs to the calling thread
+      std::string & getThreadBuffer_();
+
+      /// Buffer of one thread writing to this LogStreamBuf (defined in LogStream.cpp)
+      struct ThreadBuffer;
+
+      /// Buffer of each thread writing to this LogStreamBuf
+      QThreadStorage<ThreadBuffer *> * thread_buffers_;
+      /// All buffers in thread_buffers_ (guarded by the lock for distributing lines)
+      std::list<ThreadBuffer *> all_thread_buffers_;
+      /// Non-zero if stream_list_ is not empty, can be read without a lock
+      QAtomicInt * has_streams_;
+
       std::string             level_;
       std::list<StreamStruct> stream_list_;
-      std::string             incomplete_line_;
 
       /// @name Caching
       //@{
@@ -417,6 +443,14 @@ public:
       /// Set prefix of all output streams, details see setPrefix method with ostream
       void setPrefix(const std::string & prefix);
 
+      /**
+        Returns true if at least one stream is associated with this LogStream.
+
+        If this is not the case, all output is discarded anyway and
+        formatting it can be skipped (see LOG_DEBUG).
+      */
+      bool hasStreams() const;
+
       ///
       void flush();
       //@}
@@ -436,6 +470,17 @@ private:
 
     }; //LogStream
 
+    /**
+      @brief Helper to discard the value of a LogStream expression
+
+      Used in the conditional operator of LOG_DEBUG, so the output operators
+      are only evaluated if the LogStream is associated with a stream.
+    */
+    struct OPENMS_DLLAPI LogStreamVoidify
+    {
+      void operator&(std::ostream &) {}
+    };
+
   } // namespace Logger
 
 
@@ -456,8 +501,9 @@ private:
   Log_info
 
   /// Macro for general debugging information
+  /// (the arguments are not evaluated if no stream is associated with Log_debug, which is the default)
 #define LOG_DEBUG \
-  Log_debug << __FILE__ << "(" << __LINE__ << "): "
+  !Log_debug.hasStreams() ? (void)0 : OpenMS::Logger::LogStreamVoidify() & Log_debug << __FILE__ << "(" << __LINE__ << "): "
 
   OPENMS_DLLAPI extern Logger::LogStream Log_fatal; ///< Global static instance of a LogStream to capture messages classified as fatal errors. By default it is bound to @b cerr.
   OPENMS_DLLAPI extern Logger::LogStream Log_error; ///< Global static instance of a LogStream to capture messages classified as errors. By default it is bound to @b cerr.
@@ -99,6 +99,72 @@ private:
     return PrecisionWrapper<FloatingPointType>(rhs);
   }
 
+  /**
+    @brief Writes a floating point number with the given number of significant digits to a buffer
+
+    The result is identical to writing @p value to a std::ostream with default
+    flags and precision @p precision (i.e. printf's "%.*g" in the "C" locale),
+    but much faster: for precisions up to 15, the correctly rounded digits are
+    computed directly using extended precision arithmetic. printf is only used
+    where this is not possible (e.g. for values very close to a rounding
+    boundary, for infinity or NaN). On platforms without extended precision,
+    i.e. where long double is the same as double (e.g. MSVC), every value is
+    formatted by printf.
+
+    @p precision is limited to 40 significant digits (larger values are reduced to
+    40, which is more than a double or long double can represent), thus the
+    output has at most 50 characters. @p buffer must be able to hold at least
+    64 characters. The result is not zero-terminated.
+
+    @return The number of characters written
+  */
+  OPENMS_DLLAPI Size formatFloatingPoint(char* buffer, double value, Int precision);
+
+  /// Long double version of formatFloatingPoint(), always uses printf
+  OPENMS_DLLAPI Size formatFloatingPoint(char* buffer, long double value, Int precision);
+
+  namespace Internal
+  {
+    /// Writes @p value to @p os using the given precision (generic version)
+    template <typename NumberType>
+    inline std::ostream & writeWithPrecision(std::ostream & os, const NumberType value, Int precision)
+    {
+      const std::streamsize prec_save = os.precision();
+      os.precision(precision);
+      os << value;
+      os.precision(prec_save);
+      return os;
+    }
+
+    /// Writes floating point numbers using formatFloatingPoint(), unless the stream's format flags ask for something else
+    template <typename FloatingPointType>
+    inline std::ostream & writeFloatingPointWithPrecision(std::ostream & os, const FloatingPointType value, Int precision)
+    {
+      if (os.width() != 0 || (os.flags() & (std::ios_base::floatfield | std::ios_base::showpos | std::ios_base::showpoint | std::ios_base::uppercase)) != 0)
+      {
+        return writeWithPrecision<FloatingPointType>(os, value, precision);
+      }
+      char buffer[64];
+      os.write(buffer, formatFloatingPoint(buffer, value, precision));
+      return os;
+    }
+
+    inline std::ostream & writeWithPrecision(std::ostream & os, const float value, Int precision)
+    {
+      return writeFloatingPointWithPrecision(os, static_cast<double>(value), precision);
+    }
+
+    inline std::ostream & writeWithPrecision(std::ostream & os, const double value, Int precision)
+    {
+      return writeFloatingPointWithPrecision(os, value, precision);
+    }
+
+    inline std::ostream & writeWithPrecision(std::ostream & os, const long double value, Int precision)
+    {
+      return writeFloatingPointWithPrecision(os, value, precision);
+    }
+  }
+
   /// Output operator for a PrecisionWrapper. Specializations are defined for float, double, long double.
   template <typename FloatingPointType>
   inline std::ostream & operator<<(std::ostream & os, const PrecisionWrapper<FloatingPointType> & rhs)
@@ -115,11 +181,7 @@ private:
     }
     else
     {
-      const std::streamsize prec_save = os.precision();
-      os.precision(writtenDigits(FloatingPointType()));
-      os << rhs.ref_;
-      os.precision(prec_save);
-      return os;
+      return Internal::writeWithPrecision(os, rhs.ref_, writtenDigits(FloatingPointType()));
     }
   }
 } // namespace OpenMS
@@ -36,6 +36,7 @@
 #define OPENMS_DATASTRUCTURES_STRINGUTILS_H
 
 #include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/CONCEPT/PrecisionWrapper.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/DATASTRUCTURES/DataValue.h>
@@ -58,10 +59,10 @@ namespace OpenMS
     template <typename T>
     inline String floatToString(T f)
     {
-      std::stringstream s;
-      s.precision(writtenDigits(f));
-      s << f;
-      return s.str();
+      char buffer[64];
+      String s;
+      s.assign(buffer, formatFloatingPoint(buffer, f, writtenDigits(f)));
+      return s;
     }
 
     /// toString functions (single argument)
@@ -41,6 +41,10 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <algorithm>
 #include <iterator>
 
@@ -166,8 +170,7 @@ public:
     /// Constructor
     MorphologicalFilter() :
       ProgressLogger(),
-      DefaultParamHandler("MorphologicalFilter"),
-      struct_size_in_datapoints_(0)
+      DefaultParamHandler("MorphologicalFilter")
     {
       //structuring element
       defaults_.setValue("struc_elem_length", 3.0, "Length of the structuring element. This should be wider than the expected peak width.");
@@ -199,73 +202,7 @@ public:
     template <typename InputIterator, typename OutputIterator>
     void filterRange(InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
     {
-      // the buffer is static only to avoid reallocation
-      static std::vector<typename InputIterator::value_type> buffer;
-      const UInt size = input_end - input_begin;
-
-      //determine the struct size in data points if not already set
-      if (struct_size_in_datapoints_ == 0)
-      {
-        struct_size_in_datapoints_ = (UInt)(double)param_.getValue("struc_elem_length");
-      }
-
-      //apply the filtering
-      String method = param_.getValue("method");
-      if (method == "identity")
-      {
-        std::copy(input_begin, input_end, output_begin);
-      }
-      else if (method == "erosion")
-      {
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-      else if (method == "dilation")
-      {
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-      else if (method == "opening")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyDilation_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-      }
-      else if (method == "closing")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyErosion_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-      }
-      else if (method == "gradient")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-        for (UInt i = 0; i < size; ++i) output_begin[i] -= buffer[i];
-      }
-      else if (method == "tophat")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyDilation_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-        for (UInt i = 0; i < size; ++i) output_begin[i] = input_begin[i] - output_begin[i];
-      }
-      else if (method == "bothat")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyErosion_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-        for (UInt i = 0; i < size; ++i) output_begin[i] = input_begin[i] - output_begin[i];
-      }
-      else if (method == "erosion_simple")
-      {
-        applyErosionSimple_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-      else if (method == "dilation_simple")
-      {
-        applyDilationSimple_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-
-      struct_size_in_datapoints_ = 0;
+      filterRange_((UInt)(double)param_.getValue("struc_elem_length"), input_begin, input_end, output_begin);
     }
 
     /**
@@ -292,9 +229,10 @@ public:
       if (spectrum.size() <= 1) return;
 
       //Determine structuring element size in datapoints (depending on the unit)
+      UInt struc_size = 0;
       if ((String)(param_.getValue("struc_elem_unit")) == "Thomson")
       {
-        struct_size_in_datapoints_ =
+        struc_size =
           UInt(
             ceil(
               (double)(param_.getValue("struc_elem_length"))
@@ -307,14 +245,15 @@ public:
       }
       else
       {
-        struct_size_in_datapoints_ = (UInt)(double)param_.getValue("struc_elem_length");
+        struc_size = (UInt)(double)param_.getValue("struc_elem_length");
       }
       //make it odd (needed for the algorithm)
-      if (!Math::isOdd(struct_size_in_datapoints_)) ++struct_size_in_datapoints_;
+      if (!Math::isOdd(struc_size)) ++struc_size;
 
       //apply the filtering and overwrite the input data
       std::vector<typename PeakType::IntensityType> output(spectrum.size());
-      filterRange(Internal::intensityIteratorWrapper(spectrum.begin()),
+      filterRange_(struc_size,
+                  Internal::intensityIteratorWrapper(spectrum.begin()),
                   Internal::intensityIteratorWrapper(spectrum.end()),
                   output.begin()
                   );
@@ -326,6 +265,28 @@ public:
       }
     }
 
+    /**
+        @brief Applies the morphological filtering operation to an MSChromatogram.
+
+        If the size of the structuring element is given in 'Thomson', it is interpreted in the unit of the retention
+        time axis of the chromatogram. See the filtering method for MSSpectrum for details.
+    */
+    template <typename PeakType>
+    void filter(MSChromatogram<PeakType> & chromatogram)
+    {
+      MSSpectrum<PeakType> filter_spectrum;
+      for (typename MSChromatogram<PeakType>::const_iterator it = chromatogram.begin(); it != chromatogram.end(); ++it)
+      {
+        filter_spectrum.push_back(*it);
+      }
+      filter(filter_spectrum);
+      chromatogram.clear(false);
+      for (typename MSSpectrum<PeakType>::const_iterator it = filter_spectrum.begin(); it != filter_spectrum.end(); ++it)
+      {
+        chromatogram.push_back(*it);
+      }
+    }
+
     /**
         @brief Applies the morphological filtering operation to an MSExperiment.
 
@@ -335,19 +296,89 @@ public:
     template <typename PeakType>
     void filterExperiment(MSExperiment<PeakType> & exp)
     {
+      Size progress = 0;
       startProgress(0, exp.size(), "filtering baseline");
-      for (UInt i = 0; i < exp.size(); ++i)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
       {
         filter(exp[i]);
-        setProgress(i);
+        IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
       }
       endProgress();
     }
 
 protected:
 
-    ///Member for struct size in data points
-    UInt struct_size_in_datapoints_;
+    /// Applies the filtering method to an iterator range, using a structuring element of @p struc_size data points
+    template <typename InputIterator, typename OutputIterator>
+    void filterRange_(UInt struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
+    {
+      // local buffer, so that several threads can filter concurrently
+      std::vector<typename InputIterator::value_type> buffer;
+      const UInt size = input_end - input_begin;
+
+      //apply the filtering
+      String method = param_.getValue("method");
+      if (method == "identity")
+      {
+        std::copy(input_begin, input_end, output_begin);
+      }
+      else if (method == "erosion")
+      {
+        applyErosion_(struc_size, input_begin, input_end, output_begin);
+      }
+      else if (method == "dilation")
+      {
+        applyDilation_(struc_size, input_begin, input_end, output_begin);
+      }
+      else if (method == "opening")
+      {
+        if (buffer.size() < size) buffer.resize(size);
+        applyErosion_(struc_size, input_begin, input_end, buffer.begin());
+        applyDilation_(struc_size, buffer.begin(), buffer.begin() + size, output_begin);
+      }
+      else if (method == "closing")
+      {
+        if (buffer.size() < size) buffer.resize(size);
+        applyDilation_(struc_size, input_begin, input_end, buffer.begin());
+        applyErosion_(struc_size, buffer.begin(), buffer.begin() + size, output_begin);
+      }
+      else if (method == "gradient")
+      {
+        if (buffer.size() < size) buffer.resize(size);
+        applyErosion_(struc_size, input_begin, input_end, buffer.begin());
+        applyDilation_(struc_size, input_begin, input_end, output_begin);
+        for (UInt i = 0; i < size; ++i) output_begin[i] -= buffer[i];
+      }
+      else if (method == "tophat")
+      {
+        if (buffer.size() < size) buffer.resize(size);
+        applyErosion_(struc_size, input_begin, input_end, buffer.begin());
+        applyDilation_(struc_size, buffer.begin(), buffer.begin() + size, output_begin);
+        for (UInt i = 0; i < size; ++i) output_begin[i] = input_begin[i] - output_begin[i];
+      }
+      else if (method == "bothat")
+      {
+        if (buffer.size() < size) buffer.resize(size);
+        applyDilation_(struc_size, input_begin, input_end, buffer.begin());
+        applyErosion_(struc_size, buffer.begin(), buffer.begin() + size, output_begin);
+        for (UInt i = 0; i < size; ++i) output_begin[i] = input_begin[i] - output_begin[i];
+      }
+      else if (method == "erosion_simple")
+      {
+        applyErosionSimple_(struc_size, input_begin, input_end, output_begin);
+      }
+      else if (method == "dilation_simple")
+      {
+        applyDilationSimple_(struc_size, input_begin, input_end, output_begin);
+      }
+    }
 
     /** @brief Applies erosion.  This implementation uses van Herk's method.
     Only 3 min/max comparisons are required per data point, independent of
@@ -360,8 +391,7 @@ protected:
       const Int size = input_end - input;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
 
-      static std::vector<ValueType> buffer;
-      if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
+      std::vector<ValueType> buffer(struc_size);
 
       Int anchor;           // anchoring position of the current block
       Int i;                // index relative to anchor, used for 'for' loops
@@ -460,8 +490,7 @@ protected:
       const Int size = input_end - input;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
 
-      static std::vector<ValueType> buffer;
-      if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
+      std::vector<ValueType> buffer(struc_size);
 
       Int anchor;           // anchoring position of the current block
       Int i;                // index relative to anchor, used for 'for' loops
@@ -585,11 +614,6 @@ protected:
       return;
     }
 
-private:
-
-    /// copy constructor not implemented
-    MorphologicalFilter(const MorphologicalFilter & source);
-
   };
 
 } // namespace OpenMS
@@ -41,6 +41,10 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/FILTERING/SMOOTHING/GaussFilterAlgorithm.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <cmath>
 
 namespace OpenMS
@@ -169,15 +173,43 @@ public:
     {
       Size progress = 0;
       startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+        // filter() re-initializes the kernel in ppm mode, so every thread works on its own copy
+        GaussFilter gauss(*this);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+        for (SignedSize i = 0; i < (SignedSize)map.size(); ++i)
+        {
+          gauss.filter(map[i]);
+          IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+          ++progress;
+        }
+      }
+
+      // chromatograms cannot be filtered with a ppm tolerance: throw before entering the parallel loop
+      if (!map.getChromatograms().empty() && param_.getValue("use_ppm_tolerance").toBool())
       {
-        filter(map[i]);
-        setProgress(++progress);
+        filter(map.getChromatogram(0));
       }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)map.getChromatograms().size(); ++i)
       {
+        // without ppm tolerance the kernel is fixed and filter() does not modify it
         filter(map.getChromatogram(i));
-        setProgress(++progress);
+        IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
       }
       endProgress();
     }
@@ -39,7 +39,9 @@
 #include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/INTERFACES/DataStructures.h>
 #include <OpenMS/INTERFACES/ISpectrumAccess.h>
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <vector>
 
 namespace OpenMS
@@ -139,6 +141,13 @@ public:
     {
       bool found_signal = false;
 
+      // with a fixed kernel, it is tabulated for the local data spacing and
+      // reused as long as the data is nearly equally spaced (typical profile data)
+      if (!use_ppm_tolerance_)
+      {
+        return filterNearlyUniform_(mz_in_start, mz_in_end, int_in_start, mz_out, int_out, 1e-4);
+      }
+
       IterT mz_it = mz_in_start;
       IterT int_it = int_in_start;
       for (; mz_it != mz_in_end; mz_it++, int_it++)
@@ -177,6 +186,182 @@ protected:
     bool use_ppm_tolerance_;
     double ppm_tolerance_;
 
+    /**
+      @brief Interpolates the kernel at the given (absolute) distance from its center
+
+      Uses the same lookup as integrate_() does for every pair of data points.
+    */
+    double interpolateCoefficient_(double distance_in_gaussian) const
+    {
+      Size middle = coeffs_.size();
+      Size left_position = (Size)floor(distance_in_gaussian / spacing_);
+
+      // search for the true left adjacent data point (because of rounding errors)
+      for (UInt j = 0; j < 3; ++j)
+      {
+        if (((left_position - j) * spacing_ <= distance_in_gaussian) && ((left_position - j + 1) * spacing_ >= distance_in_gaussian))
+        {
+          left_position -= j;
+          break;
+        }
+
+        if (((left_position + j) * spacing_ < distance_in_gaussian) && ((left_position + j + 1) * spacing_ < distance_in_gaussian))
+        {
+          left_position += j;
+          break;
+        }
+      }
+
+      // stay within the tabulated kernel (only relevant for rounding at its border)
+      if (left_position >= middle) left_position = middle - 1;
+
+      Size right_position = left_position + 1;
+      double d = fabs((left_position * spacing_) - distance_in_gaussian) / spacing_;
+      return (right_position < middle) ? (1 - d) * coeffs_[left_position] + d * coeffs_[right_position]
+                                       : coeffs_[left_position];
+    }
+
+    /**
+      @brief Tabulates the kernel at multiples of the data spacing @p data_spacing
+
+      @p weights contains the interpolated kernel at 0, 1, ..., @p nr_neighbors times @p data_spacing.
+      @p slopes contains an upper bound of the absolute slope of the (linearly interpolated) kernel within
+      one kernel spacing around each of these distances.
+    */
+    void computeLocalKernel_(double data_spacing, Size nr_neighbors, std::vector<double> & weights, std::vector<double> & slopes) const
+    {
+      const Size middle = coeffs_.size();
+      weights.resize(nr_neighbors + 1);
+      slopes.resize(nr_neighbors + 1);
+      for (Size j = 0; j <= nr_neighbors; ++j)
+      {
+        const double distance_in_gaussian = j * data_spacing;
+        weights[j] = interpolateCoefficient_(distance_in_gaussian);
+
+        // largest slope of the kernel segments left of, at and right of the distance
+        // (the kernel is constant beyond the last coefficient)
+        const Size position = (Size)floor(distance_in_gaussian / spacing_);
+        double slope = 0.0;
+        for (Size k = (position > 0 ? position - 1 : 0); k <= position + 1; ++k)
+        {
+          if (k + 1 < middle) slope = std::max(slope, fabs(coeffs_[k + 1] - coeffs_[k]));
+        }
+        slopes[j] = slope / spacing_;
+      }
+    }
+
+    /**
+      @brief Smoothes data which is (nearly) equally spaced within each kernel window
+
+      For every data point, the neighbors and the trapezoidal integral are the same as in integrate_(),
+      but the kernel is not interpolated at the true distance of every neighbor. Instead, the kernel is
+      tabulated once at multiples of a local data spacing (see computeLocalKernel_()) and used for all
+      data points whose neighbors are at most @p max_kernel_error (relative to the kernel maximum) off
+      the tabulated kernel: each neighbor must be within one kernel spacing of the tabulated distance,
+      and the distance error times the maximal kernel slope around it must not exceed the bound.
+
+      The tabulated kernel is reused as long as the data points fulfill the bound. Otherwise, it is
+      computed again for the mean spacing in the current kernel window. If the bound is still violated
+      (e.g. at gaps in the data), the data point is integrated by integrate_(). Data which violates the
+      bound everywhere (e.g. m/z values stored with single precision) is thus mostly left to integrate_().
+      Equally spaced data always fulfills the bound. For profile data with a spacing that grows with m/z
+      (e.g. Orbitrap or TOF data), the spacing changes little within a kernel window, so the kernel only
+      has to be computed again every few data points.
+    */
+    template <typename ConstIterT, typename IterT>
+    bool filterNearlyUniform_(ConstIterT mz_in_start, ConstIterT mz_in_end, ConstIterT int_in_start,
+                              IterT mz_out, IterT int_out, double max_kernel_error)
+    {
+      const SignedSize n = std::distance(mz_in_start, mz_in_end);
+      const double kernel_width = coeffs_.size() * spacing_;
+      const double max_error = max_kernel_error * coeffs_[0];
+      bool found_signal = false;
+      if (n == 0) return found_signal;
+
+      std::vector<double> mz(mz_in_start, mz_in_end);
+      std::vector<double> intensities(int_in_start, int_in_start + n);
+
+      // the current local kernel, tabulated at multiples of kernel_data_spacing
+      double kernel_data_spacing = 0.0;
+      std::vector<double> weights, slopes;
+      // after a data point failed even with a new kernel, the next data points are left to
+      // integrate_() right away, for a number of points which doubles with every further failure
+      SignedSize next_attempt = 0, attempt_distance = 1;
+
+      // the neighbors of data point i are lo, ..., i - 1 and i + 1, ..., hi
+      SignedSize lo = 0, hi = 0;
+      for (SignedSize i = 0; i < n; ++i, ++mz_out, ++int_out)
+      {
+        // the same window borders and comparisons as in integrate_()
+        const double start_pos = ((mz[i] - kernel_width) > mz[0]) ? (mz[i] - kernel_width) : mz[0];
+        const double end_pos = ((mz[i] + kernel_width) < mz[n - 1]) ? (mz[i] + kernel_width) : mz[n - 1];
+        while (lo < i && !(mz[lo] > start_pos)) ++lo;
+        if (hi < i) hi = i;
+        while (hi < n - 1 && mz[hi + 1] < end_pos) ++hi;
+        const SignedSize left = i - lo;
+        const SignedSize right = hi - i;
+
+        double v = 0.0;
+        double norm = 0.0;
+        bool within_bound = false;
+        // first try the current kernel, then a kernel for the spacing of this window
+        bool new_kernel = false;
+        for (UInt attempt = 0; i >= next_attempt && attempt < 2 && !within_bound && !(attempt == 1 && new_kernel); ++attempt)
+        {
+          if (attempt == 1 || kernel_data_spacing == 0.0 || (SignedSize)weights.size() <= std::max(left, right))
+          {
+            if (left + right == 0) break;
+            kernel_data_spacing = (mz[hi] - mz[lo]) / (left + right);
+            computeLocalKernel_(kernel_data_spacing, (Size)floor(kernel_width / kernel_data_spacing) + 1, weights, slopes);
+            new_kernel = true;
+            if ((SignedSize)weights.size() <= std::max(left, right)) break;
+          }
+
+          within_bound = true;
+          v = 0.0;
+          norm = 0.0;
+          // integrate from middle to start_pos
+          for (SignedSize j = 1; j <= left && within_bound; ++j)
+          {
+            const double error = fabs((mz[i] - mz[i - j]) - j * kernel_data_spacing);
+            within_bound = (error <= spacing_) && (error * slopes[j] <= max_error);
+            const double width = (mz[i - j + 1] - mz[i - j]) / 2.;
+            norm += width * (weights[j] + weights[j - 1]);
+            v += width * (intensities[i - j] * weights[j] + intensities[i - j + 1] * weights[j - 1]);
+          }
+          // integrate from middle to end_pos
+          for (SignedSize j = 1; j <= right && within_bound; ++j)
+          {
+            const double error = fabs((mz[i + j] - mz[i]) - j * kernel_data_spacing);
+            within_bound = (error <= spacing_) && (error * slopes[j] <= max_error);
+            const double width = (mz[i + j] - mz[i + j - 1]) / 2.;
+            norm += width * (weights[j - 1] + weights[j]);
+            v += width * (intensities[i + j - 1] * weights[j - 1] + intensities[i + j] * weights[j]);
+          }
+        }
+
+        double new_int;
+        if (within_bound)
+        {
+          new_int = (v > 0) ? v / norm : 0;
+          attempt_distance = 1;
+        }
+        else
+        {
+          if (new_kernel)
+          {
+            next_attempt = i + attempt_distance;
+            attempt_distance = std::min(2 * attempt_distance, n);
+          }
+          new_int = integrate_(mz.begin() + i, intensities.begin() + i, mz.begin(), mz.end());
+        }
+        *mz_out = mz[i];
+        *int_out = new_int;
+        if (fabs(new_int) > 0) found_signal = true;
+      }
+      return found_signal;
+    }
+
     /// Computes the convolution of the raw data at position x and the gaussian kernel
     template <typename InputPeakIterator>
     double integrate_(InputPeakIterator x /* mz */, InputPeakIterator y /* int */, InputPeakIterator first, InputPeakIterator last)
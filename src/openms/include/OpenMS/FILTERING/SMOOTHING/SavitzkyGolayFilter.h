@@ -39,6 +39,10 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
   /**
@@ -115,86 +119,67 @@ public:
     template <typename PeakType>
     void filter(MSSpectrum<PeakType> & spectrum)
     {
-      UInt n = (UInt)spectrum.size();
-
-      typename MSSpectrum<PeakType>::iterator first = spectrum.begin();
-      typename MSSpectrum<PeakType>::iterator last = spectrum.end();
+      const int n = (int)spectrum.size();
 
-      //copy the data AND META DATA to the output container
-      MSSpectrum<PeakType> output = spectrum;
-
-      if (frame_size_ > n)
+      if ((int)frame_size_ > n)
       {
         return;
       }
 
-      int i;
-      UInt j;
-      int mid = (frame_size_ / 2);
-      double help;
+      // work on a contiguous copy of the intensities, the results are written back in place
+      std::vector<double> intensities(n);
+      for (int p = 0; p < n; ++p)
+      {
+        intensities[p] = spectrum[p].getIntensity();
+      }
+      std::vector<double> output(n, 0.0);
 
-      typename MSSpectrum<PeakType>::iterator it_forward;
-      typename MSSpectrum<PeakType>::iterator it_help;
-      typename MSSpectrum<PeakType>::iterator out_it = output.begin();
+      const int frame_size = (int)frame_size_;
+      const int mid = (frame_size / 2);
 
-      // compute the transient on
-      for (i = 0; i <= mid; ++i)
+      // compute the transient on (all windows start at the first data point)
+      for (int i = 0; i <= mid; ++i)
       {
-        it_forward = (first - i);
-        help = 0;
-
-        for (j = 0; j < frame_size_; ++j)
+        double help = 0;
+        for (int j = 0; j < frame_size; ++j)
         {
-          help += it_forward->getIntensity() * coeffs_[(i + 1) * frame_size_ - 1 - j];
-          ++it_forward;
+          help += intensities[j] * coeffs_[(i + 1) * frame_size - 1 - j];
         }
-
-
-        out_it->setPosition(first->getPosition());
-        out_it->setIntensity(std::max(0.0, help));
-        ++out_it;
-        ++first;
+        output[i] = help;
       }
 
-      // compute the steady state output
-      it_help = (last - mid);
-      while (first != it_help)
+      // compute the steady state output: loop over the coefficients outside, so that the inner loop
+      // over the data points can be vectorized; every sum is still accumulated in the same order
+      const int steady_begin = mid + 1;
+      const int steady_size = n - mid - steady_begin;
+      for (int j = 0; j < frame_size && steady_size > 0; ++j)
       {
-        it_forward = (first - mid);
-        help = 0;
-
-        for (j = 0; j < frame_size_; ++j)
+        const double c = coeffs_[mid * frame_size + j];
+        const double * in = &intensities[steady_begin - mid + j];
+        double * out = &output[steady_begin];
+        for (int p = 0; p < steady_size; ++p)
         {
-          help += it_forward->getIntensity() * coeffs_[mid * frame_size_ + j];
-          ++it_forward;
+          out[p] += in[p] * c;
         }
-
-
-        out_it->setPosition(first->getPosition());
-        out_it->setIntensity(std::max(0.0, help));
-        ++out_it;
-        ++first;
       }
 
-      // compute the transient off
-      for (i = (mid - 1); i >= 0; --i)
+      // compute the transient off (all windows end at the last data point)
+      for (int i = (mid - 1); i >= 0; --i)
       {
-        it_forward = (first - (frame_size_ - i - 1));
-        help = 0;
-
-        for (j = 0; j < frame_size_; ++j)
+        const int p = n - 1 - i;
+        const int window_begin = p - (frame_size - i - 1);
+        double help = 0;
+        for (int j = 0; j < frame_size; ++j)
         {
-          help += it_forward->getIntensity() * coeffs_[i * frame_size_ + j];
-          ++it_forward;
+          help += intensities[window_begin + j] * coeffs_[i * frame_size + j];
         }
-
-        out_it->setPosition(first->getPosition());
-        out_it->setIntensity(std::max(0.0, help));
-        ++out_it;
-        ++first;
+        output[p] = help;
       }
 
-      spectrum = output;
+      for (int p = 0; p < n; ++p)
+      {
+        spectrum[p].setIntensity(std::max(0.0, output[p]));
+      }
     }
 
     template <typename PeakType>
@@ -221,17 +206,32 @@ public:
     template <typename PeakType>
     void filterExperiment(MSExperiment<PeakType> & map)
     {
+      // spectra and chromatograms are smoothed independently, filter() only reads the coefficients
       Size progress = 0;
       startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)map.size(); ++i)
       {
         filter(map[i]);
-        setProgress(++progress);
+        IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
       }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)map.getChromatograms().size(); ++i)
       {
         filter(map.getChromatogram(i));
-        setProgress(++progress);
+        IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
       }
       endProgress();
     }
@@ -0,0 +1,147 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#ifndef OPENMS_FORMAT_BINARYDATAFILE_H
+#define OPENMS_FORMAT_BINARYDATAFILE_H
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/FORMAT/FileTypes.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
+#include <OpenMS/METADATA/PeptideIdentification.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Fast binary storage of feature maps, consensus maps and identifications
+
+    This is a compact alternative to featureXML, consensusXML and idXML for
+    intermediate results that are written by one tool and read by the next
+    one of a pipeline (file types FileTypes::FEATUREBIN, FileTypes::CONSENSUSBIN
+    and FileTypes::IDBIN). Numbers are stored in their in-memory representation,
+    i.e. without any text conversion or loss of precision, and every distinct
+    string (meta value names, accessions, score types, peptide sequences, ...)
+    is stored only once per file.
+
+    All information written to the XML formats is kept, including meta values,
+    convex hulls, subordinate features, consensus ratios, data processing and
+    search parameters.
+
+    A file starts with a magic string, a byte order mark, the format version and
+    the kind of data it contains. Loading a file that contains a different
+    kind of data, was written by a newer version of this class or on a machine
+    with a different byte order fails with an Exception::ParseError. The format
+    is therefore not meant for archiving or exchanging data.
+
+    The binary formats are handled by FileHandler (loadFeatures(), loadConsensusFeatures(),
+    loadIdentifications() and the corresponding store methods) and are accepted by the
+    TOPP tools FileConverter, IDFileConverter, IDMapper, MapAlignerIdentification,
+    MapAlignerPoseClustering, the FeatureLinker tools and ProteinQuantifier. Other tools
+    need their input converted to XML first (e.g. with FileConverter).
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI BinaryDataFile :
+    public ProgressLogger
+  {
+public:
+    /// Version of the format written by this class
+    static const UInt32 VERSION;
+
+    /// Default constructor
+    BinaryDataFile();
+
+    /// Destructor
+    ~BinaryDataFile();
+
+    /**
+      @brief Loads a feature map from a binary file
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a binary feature map or is truncated
+    */
+    void load(const String& filename, FeatureMap& feature_map);
+
+    /**
+      @brief Stores a feature map in a binary file
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const FeatureMap& feature_map);
+
+    /**
+      @brief Loads a consensus map from a binary file
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a binary consensus map or is truncated
+    */
+    void load(const String& filename, ConsensusMap& consensus_map);
+
+    /**
+      @brief Stores a consensus map in a binary file
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const ConsensusMap& consensus_map);
+
+    /**
+      @brief Loads protein and peptide identifications from a binary file
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file does not contain identifications or is truncated
+    */
+    void load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids);
+
+    /**
+      @brief Stores protein and peptide identifications in a binary file
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids);
+
+    /**
+      @brief Determines the type of a binary file from its header
+
+      @return FileTypes::FEATUREBIN, FileTypes::CONSENSUSBIN or FileTypes::IDBIN, or FileTypes::UNKNOWN if the file is not in this format
+    */
+    static FileTypes::Type getFileType(const String& filename);
+  };
+
+} // namespace OpenMS
+
+#endif // OPENMS_FORMAT_BINARYDATAFILE_H
@@ -99,6 +99,15 @@ public:
     /// Write only the meta data of an MSExperiment
     void writeMetadata(MapType exp, String out_meta, bool addCacheMetaValue=false);
 
+    /**
+      @brief Remove the actual data of an MSExperiment in place, leaving only its meta data
+
+      This produces the same meta data as writeMetadata() without writing it
+      to disk, which is useful if the meta data is directly handed to a
+      consumer (e.g. SpectrumAccessOpenMSCached) in memory.
+    */
+    static void createMetadata(MapType& exp, bool addCacheMetaValue=false);
+
     /// Read all spectra from a dump from the disk
     void readMemdump(MapType& exp_reading, String filename) const;
     //@}
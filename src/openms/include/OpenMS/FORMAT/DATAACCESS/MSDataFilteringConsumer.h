@@ -0,0 +1,231 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#ifndef OPENMS_FORMAT_DATAACCESS_MSDATAFILTERINGCONSUMER_H
+#define OPENMS_FORMAT_DATAACCESS_MSDATAFILTERINGCONSUMER_H
+
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+    @brief Consumer class that applies a signal processing filter to batches of MS data in parallel
+
+    Spectra and chromatograms are collected into batches of a fixed size.
+    Once a batch is full, all of its entries are filtered in parallel (using
+    OpenMP if available) and then passed on to the next consumer in the order
+    in which they were consumed. This allows to combine a streaming data
+    access (e.g. MzMLFile::transform together with a MSDataWritingConsumer)
+    with the use of all CPU cores, while holding only a single batch in memory.
+
+    The filter type needs to be copy-constructible and to provide @em filter
+    methods for spectra and chromatograms (e.g. GaussFilter,
+    SavitzkyGolayFilter or MorphologicalFilter). Each thread works on its own
+    copy of the filter, so filters which change their state while filtering
+    can be used as well. The results are identical to filtering the data
+    sequentially.
+
+    Usage:
+
+    @code
+    PlainMSDataWritingConsumer writing_consumer(outfile);
+    MSDataFilteringConsumer<GaussFilter> filtering_consumer(gauss, &writing_consumer);
+    MzMLFile().transform(infile, &filtering_consumer);
+    filtering_consumer.flush(); // process and pass on the last batch
+    @endcode
+
+    @note flush() has to be called after the last spectrum or chromatogram
+    was consumed and before the next consumer is closed. Otherwise, the
+    remaining data is only passed on when the consumer is destroyed.
+
+    @note This does not transfer ownership of the next consumer - it is the
+    callers responsibility to delete the pointer afterwards.
+  */
+  template <typename FilterType>
+  class MSDataFilteringConsumer :
+    public Interfaces::IMSDataConsumer<>
+  {
+
+  public:
+    typedef MSExperiment<> MapType;
+    typedef MapType::SpectrumType SpectrumType;
+    typedef MapType::ChromatogramType ChromatogramType;
+
+    /**
+      @brief Constructor
+
+      @param filter The (parametrized) filter to apply
+      @param next_consumer The consumer which receives the filtered data
+      @param filter_chromatograms Whether chromatograms are filtered or passed on unchanged
+      @param batch_size Number of spectra (or chromatograms) which are filtered together
+    */
+    MSDataFilteringConsumer(const FilterType & filter, Interfaces::IMSDataConsumer<> * next_consumer,
+                            bool filter_chromatograms = true, Size batch_size = 100) :
+      filter_(filter),
+      next_consumer_(next_consumer),
+      filter_chromatograms_(filter_chromatograms),
+      batch_size_(batch_size == 0 ? 1 : batch_size)
+    {
+    }
+
+    /**
+      @brief Destructor
+
+      Passes on the remaining data if flush() was not called.
+    */
+    virtual ~MSDataFilteringConsumer()
+    {
+      try
+      {
+        flush();
+      }
+      catch (Exception::BaseException & e)
+      {
+        LOG_ERROR << "Error while filtering the last batch of data: " << e.what() << std::endl;
+      }
+    }
+
+    virtual void setExpectedSize(Size expectedSpectra, Size expectedChromatograms)
+    {
+      next_consumer_->setExpectedSize(expectedSpectra, expectedChromatograms);
+    }
+
+    virtual void setExperimentalSettings(const ExperimentalSettings & exp)
+    {
+      next_consumer_->setExperimentalSettings(exp);
+    }
+
+    virtual void consumeSpectrum(SpectrumType & s)
+    {
+      // keep the order of the data: all earlier chromatograms go first
+      flushChromatograms_();
+      spectra_.push_back(s);
+      if (spectra_.size() >= batch_size_) flushSpectra_();
+    }
+
+    virtual void consumeChromatogram(ChromatogramType & c)
+    {
+      flushSpectra_();
+      chromatograms_.push_back(c);
+      if (chromatograms_.size() >= batch_size_) flushChromatograms_();
+    }
+
+    /// Filters the remaining spectra and chromatograms and passes them on to the next consumer
+    void flush()
+    {
+      flushSpectra_();
+      flushChromatograms_();
+    }
+
+  protected:
+
+    /**
+      @brief Filters all elements of @p batch in parallel, each thread using its own copy of the filter
+
+      Exceptions must not leave the parallel region: the entries which could
+      not be filtered are marked in @p failed instead, and filtering them again
+      in sequential order throws the original exception.
+    */
+    template <typename ContainerType>
+    void filterBatch_(ContainerType & batch, std::vector<char> & failed)
+    {
+      failed.assign(batch.size(), 0);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+        FilterType filter(filter_);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+        for (SignedSize i = 0; i < (SignedSize)batch.size(); ++i)
+        {
+          try
+          {
+            filter.filter(batch[i]);
+          }
+          catch (Exception::BaseException &)
+          {
+            failed[i] = 1;
+          }
+        }
+      }
+    }
+
+    void flushSpectra_()
+    {
+      if (spectra_.empty()) return;
+      // take the batch out of the buffer, so nothing is passed on twice if an exception occurs
+      std::vector<SpectrumType> batch;
+      batch.swap(spectra_);
+      std::vector<char> failed;
+      filterBatch_(batch, failed);
+      for (Size i = 0; i < batch.size(); ++i)
+      {
+        if (failed[i]) filter_.filter(batch[i]);
+        next_consumer_->consumeSpectrum(batch[i]);
+      }
+    }
+
+    void flushChromatograms_()
+    {
+      if (chromatograms_.empty()) return;
+      std::vector<ChromatogramType> batch;
+      batch.swap(chromatograms_);
+      std::vector<char> failed(batch.size(), 0);
+      if (filter_chromatograms_) filterBatch_(batch, failed);
+      for (Size i = 0; i < batch.size(); ++i)
+      {
+        if (failed[i]) filter_.filter(batch[i]);
+        next_consumer_->consumeChromatogram(batch[i]);
+      }
+    }
+
+    FilterType filter_;
+    Interfaces::IMSDataConsumer<> * next_consumer_;
+    bool filter_chromatograms_;
+    Size batch_size_;
+
+    std::vector<SpectrumType> spectra_;
+    std::vector<ChromatogramType> chromatograms_;
+  };
+
+} //end namespace OpenMS
+
+#endif // OPENMS_FORMAT_DATAACCESS_MSDATAFILTERINGCONSUMER_H
@@ -500,27 +500,21 @@ protected:
         ms1_consumer_ = NULL;
       }
 
+      // The meta data is kept in memory and annotated with the correct data
+      // processing tag; the maps point to the cached files on disk (via their
+      // loaded file path) without writing and re-parsing any mzML.
       if (have_ms1)
       {
-        boost::shared_ptr<MSExperiment<Peak1D> > exp(new MSExperiment<Peak1D>);
         String meta_file = cachedir_ + basename_ + "_ms1.mzML";
-        // write metadata to disk and store the correct data processing tag
-        CachedmzML().writeMetadata(*ms1_map_, meta_file, true);
-        MzMLFile().load(meta_file, *exp.get());
-        ms1_map_ = exp;
+        CachedmzML::createMetadata(*ms1_map_, true);
+        ms1_map_->setLoadedFilePath(meta_file);
       }
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-      for (SignedSize i = 0; i < boost::numeric_cast<SignedSize>(swath_consumers_size); i++)
+      for (Size i = 0; i < swath_consumers_size; i++)
       {
-        boost::shared_ptr<MSExperiment<Peak1D> > exp(new MSExperiment<Peak1D>);
         String meta_file = cachedir_ + basename_ + "_" + String(i) +  ".mzML";
-        // write metadata to disk and store the correct data processing tag
-        CachedmzML().writeMetadata(*swath_maps_[i], meta_file, true);
-        MzMLFile().load(meta_file, *exp.get());
-        swath_maps_[i] = exp;
+        CachedmzML::createMetadata(*swath_maps_[i], true);
+        swath_maps_[i]->setLoadedFilePath(meta_file);
       }
     }
 
@@ -43,6 +43,7 @@
 #include <OpenMS/FORMAT/MzXMLFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/BinaryDataFile.h>
 #include <OpenMS/FORMAT/MzDataFile.h>
 #include <OpenMS/FORMAT/MascotGenericFile.h>
 #include <OpenMS/FORMAT/MS2File.h>
@@ -337,6 +338,72 @@ public:
     */
     bool loadFeatures(const String& filename, FeatureMap& map, FileTypes::Type force_type = FileTypes::UNKNOWN);
 
+    /**
+      @brief Stores a FeatureMap to a file
+
+      The file type is determined by the file name. Supported formats are featureXML and featureBin.
+
+      @return true if the file could be stored, false if the format is not supported
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be written
+    */
+    bool storeFeatures(const String& filename, const FeatureMap& map);
+
+    /**
+      @brief Loads a file into a ConsensusMap
+
+      Supported formats are consensusXML and consensusBin.
+
+      @param filename the file name of the file to load.
+      @param map The ConsensusMap to load the data into.
+      @param force_type Forces to load the file with that file type. If no type is forced, it is determined from the extension (or from the content if that fails).
+
+      @return true if the file could be loaded, false otherwise
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    bool loadConsensusFeatures(const String& filename, ConsensusMap& map, FileTypes::Type force_type = FileTypes::UNKNOWN);
+
+    /**
+      @brief Stores a ConsensusMap to a file
+
+      The file type is determined by the file name. Supported formats are consensusXML and consensusBin.
+
+      @return true if the file could be stored, false if the format is not supported
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be written
+    */
+    bool storeConsensusFeatures(const String& filename, const ConsensusMap& map);
+
+    /**
+      @brief Loads protein and peptide identifications from a file
+
+      Supported formats are idXML, mzIdentML and idBin.
+
+      @param filename the file name of the file to load.
+      @param protein_ids The protein identifications
+      @param peptide_ids The peptide identifications
+      @param force_type Forces to load the file with that file type. If no type is forced, it is determined from the extension (or from the content if that fails).
+
+      @return true if the file could be loaded, false otherwise
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    bool loadIdentifications(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids, FileTypes::Type force_type = FileTypes::UNKNOWN);
+
+    /**
+      @brief Stores protein and peptide identifications to a file
+
+      The file type is determined by the file name. Supported formats are idXML, mzIdentML and idBin.
+
+      @return true if the file could be stored, false if the format is not supported
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be written
+    */
+    bool storeIdentifications(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids);
+
     /**
       @brief Computes a SHA-1 hash value for the content of the given file.
 
@@ -101,6 +101,10 @@ namespace OpenMS
       PSQ,                ///< NCBI binary blast db
       MRM,                ///< SpectraST MRM List
       PSMS,               ///< Percolator tab-delimited output (PSM level)
+      OSLIB,              ///< OpenSWATH binary assay library
+      FEATUREBIN,         ///< %OpenMS binary feature map (.featureBin)
+      CONSENSUSBIN,       ///< %OpenMS binary consensus map (.consensusBin)
+      IDBIN,              ///< %OpenMS binary identifications (.idBin)
       SIZE_OF_TYPE        ///< No file type. Simply stores the number of types
     };
 
@@ -23,6 +23,7 @@ source_group("Source Files\\OpenMS\\FORMAT" FILES ${mocced_sources})
 ### list all header files of the directory here
 set(sources_list_h
 Base64.h
+BinaryDataFile.h
 Bzip2Ifstream.h
 Bzip2InputStream.h
 CachedMzML.h
@@ -0,0 +1,198 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#ifndef OPENMS_SYSTEM_PROFILER_H
+#define OPENMS_SYSTEM_PROFILER_H
+
+#include <OpenMS/config.h>
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+
+#include <map>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Collects run time per processing phase and event counters of the current process.
+
+    Profiling is disabled by default, in which case all calls return immediately.
+    TOPP tools enable it with the '-profile <file>' option and write a JSON
+    report (see writeReport()) after the tool has finished.
+
+    Phases are identified by name; repeated phases with the same name are
+    accumulated. Every ProgressLogger progress section (startProgress() to
+    endProgress()) is recorded as a phase with the progress label as name.
+    Algorithm code can add its own phases and counters:
+
+    @code
+    {
+      Profiler::ScopedPhase phase("alignment");
+      ...
+      Profiler::addCount("aligned features", features.size());
+    }
+    @endcode
+
+    Phases started with startPhase() have to be ended in reverse order.
+    All methods are thread-safe. Phases are only recorded outside of OpenMP
+    parallel regions: calls to startPhase() and endPhase() from within a
+    parallel region (e.g. progress sections of algorithms run by worker
+    threads) are ignored, since the CPU time of a phase covers all threads
+    and concurrent phases cannot be told apart on the phase stack. Counters
+    are recorded from all threads.
+
+    @ingroup System
+  */
+  class OPENMS_DLLAPI Profiler
+  {
+public:
+    /// Accumulated statistics of a phase
+    struct OPENMS_DLLAPI PhaseStatistics
+    {
+      PhaseStatistics();
+
+      /// number of times the phase was run
+      Size calls;
+      /// wall clock time in seconds
+      double wall_time;
+      /// CPU time (user + system, all threads) in seconds
+      double cpu_time;
+    };
+
+    /// Starts a phase on construction and ends it on destruction
+    class OPENMS_DLLAPI ScopedPhase
+    {
+public:
+      /// Starts the phase @p name (if profiling is enabled)
+      explicit ScopedPhase(const String& name);
+      /// Ends the phase
+      ~ScopedPhase();
+
+private:
+      /// was profiling enabled on construction?
+      bool active_;
+
+      /// not implemented
+      ScopedPhase(const ScopedPhase&);
+      ScopedPhase& operator=(const ScopedPhase&);
+    };
+
+    /**
+      @brief Enables profiling on construction and writes the report on destruction
+
+      The report (see writeReport()) is also written if the scope is left by
+      an exception. In this case, the exit code is written as null unless it
+      was set with setExitCode(). Errors while writing the report are logged,
+      not thrown.
+    */
+    class OPENMS_DLLAPI ScopedReport
+    {
+public:
+      /// Clears all phases and counters and enables profiling (if @p filename is not empty)
+      ScopedReport(const String& filename, const String& tool_name, Int threads);
+      /// Disables profiling and writes the report to the file (if a file name was given)
+      ~ScopedReport();
+
+      /// Sets the exit code of the tool, which is written to the report
+      void setExitCode(Int exit_code);
+
+private:
+      String filename_;
+      String tool_name_;
+      Int threads_;
+      /// exit code (-1 if not set)
+      Int exit_code_;
+      /// total run time
+      StopWatch total_time_;
+
+      /// not implemented
+      ScopedReport(const ScopedReport&);
+      ScopedReport& operator=(const ScopedReport&);
+    };
+
+    /// Enables or disables profiling
+    static void setEnabled(bool enabled);
+
+    /// Returns if profiling is enabled
+    static bool isEnabled();
+
+    /// Starts the phase @p name (ignored within OpenMP parallel regions)
+    static void startPhase(const String& name);
+
+    /// Ends the most recently started phase (ignored within OpenMP parallel regions)
+    static void endPhase();
+
+    /// Adds @p count to the counter @p name
+    static void addCount(const String& name, UInt64 count = 1);
+
+    /// Returns the statistics of all finished phases (by name)
+    static std::map<String, PhaseStatistics> getPhases();
+
+    /// Returns all counters (by name)
+    static std::map<String, UInt64> getCounters();
+
+    /// Removes all phases and counters
+    static void clear();
+
+    /**
+      @brief Writes a JSON report of the whole run
+
+      The report contains the wall and CPU time of @p total_time, the thread
+      utilization (CPU time / (wall time * @p threads)), peak memory and
+      bytes read and written (see SysInfo) as well as all phases and counters.
+      Values that are not available on this platform are written as null, as
+      is a negative @p exit_code (tool aborted by an exception).
+
+      @exception Exception::UnableToCreateFile if @p filename cannot be written
+    */
+    static void writeReport(const String& filename, const String& tool_name, Int exit_code, const StopWatch& total_time, Int threads);
+
+private:
+    /// A phase that was started, but not ended yet
+    struct OpenPhase_
+    {
+      String name;
+      StopWatch watch;
+    };
+
+    static bool enabled_;
+    static std::vector<OpenPhase_> open_phases_;
+    static std::map<String, PhaseStatistics> phases_;
+    static std::map<String, UInt64> counters_;
+  };
+
+} // namespace OpenMS
+
+#endif // OPENMS_SYSTEM_PROFILER_H
@@ -36,6 +36,7 @@
 #define OPENMS_SYSTEM_SYSINFO_H
 
 #include <OpenMS/config.h>
+#include <OpenMS/CONCEPT/Types.h>
 #include <cstddef>
 
 namespace OpenMS
@@ -44,7 +45,7 @@ namespace OpenMS
 	/**
 	@brief Some static functions to get system information
 
-	Supports current memory consumption.
+	Supports current and peak memory consumption and I/O statistics.
 
 	*/
 	class OPENMS_DLLAPI SysInfo
@@ -56,6 +57,20 @@ namespace OpenMS
 			/// @param mem_virtual Total virtual memory allocated by the current process
 			/// @return True on success, false otherwise. If false is returned, then @p mem_virtual is set to 0.
 			static bool getProcessMemoryConsumption(size_t& mem_virtual);
+
+			/// Get the peak memory consumption (high water mark of the resident set size) in KiloBytes (KB)
+			///
+			/// @param mem_peak Maximal physical memory used by the current process so far
+			/// @return True on success, false otherwise. If false is returned, then @p mem_peak is set to 0.
+			static bool getProcessPeakMemoryConsumption(size_t& mem_peak);
+
+			/// Get the number of bytes read and written by the current process so far (all I/O system calls, including cached reads)
+			/// Not supported on Mac OS X.
+			///
+			/// @param bytes_read Bytes read
+			/// @param bytes_written Bytes written
+			/// @return True on success, false otherwise. If false is returned, then both values are set to 0.
+			static bool getProcessIOStatistics(UInt64& bytes_read, UInt64& bytes_written);
 	};
 }
 
@@ -27,6 +27,7 @@ File.h
 FileWatcher.h
 JavaInfo.h
 NetworkGetRequest.h
+Profiler.h
 StopWatch.h
 RWrapper.h
 SysInfo.h
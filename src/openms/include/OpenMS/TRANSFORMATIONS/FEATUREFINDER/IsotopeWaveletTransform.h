@@ -232,6 +232,15 @@ protected:
         * @param c The charge state minus 1 (e.g. c=2 means charge state 3) at which you want to compute the transform. */
     virtual void getTransformHighRes(MSSpectrum<PeakType>& c_trans, const MSSpectrum<PeakType>& c_ref, const UInt c);
 
+    /** @brief Computes the isotope wavelet transforms of all charge states.
+        *
+        * Gives the same result as getTransform() (or getTransformHighRes() if @p high_res is set) for every
+        * charge state, but the data points of all charge states are distributed over the threads together.
+        * @param c_trans The transforms, entry @em c is the transform of charge state c+1. Each entry must have the size of @p c_ref.
+        * @param c_ref The reference spectrum.
+        * @param high_res Compute the transforms like getTransformHighRes() does. */
+    virtual void getTransforms(std::vector<MSSpectrum<PeakType> >& c_trans, const MSSpectrum<PeakType>& c_ref, const bool high_res = false);
+
     /** @brief Given an isotope wavelet transformed spectrum @p candidates, this function assigns to every significant
         * pattern its corresponding charge state and a score indicating the reliability of the prediction. The result of this
         * process is stored internally. Important: Before calling this function, apply updateRanges() to the original map.
@@ -369,6 +378,12 @@ protected:
 
     inline void sampleTheCMarrWavelet_(const MSSpectrum<PeakType>& scan, const Int wavelet_length, const Int mz_index, const UInt charge);
 
+    /** @brief Computes the transformed intensity of data point @p my_local_pos of @p c_ref at charge state @p c+1 (see getTransform()). */
+    double getTransformedIntensity_(const MSSpectrum<PeakType>& c_ref, const Int my_local_pos, const UInt c) const;
+
+    /** @brief Computes the transformed intensity of data point @p my_local_pos of @p c_ref at charge state @p c+1 (see getTransformHighRes()). */
+    double getTransformedIntensityHighRes_(const MSSpectrum<PeakType>& c_ref, const Int my_local_pos, const UInt c) const;
+
 
     /** @brief Given a candidate for an isotopic pattern, this function computes the corresponding score
         * @param candidate A isotope wavelet transformed spectrum.
@@ -605,79 +620,117 @@ protected:
     Int spec_size((Int)c_ref.size());
     //in the very unlikely case that size_t will not fit to int anymore this will be a problem of course
     //for the sake of simplicity (we need here a signed int) we do not cast at every following comparison individually
-    UInt charge = c + 1;
-    double value, T_boundary_left, T_boundary_right, old, c_diff, current, old_pos, my_local_MZ, my_local_lambda, origin, c_mz;
 
+    // the transformed value of every data point only depends on the input spectrum
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
     for (Int my_local_pos = 0; my_local_pos < spec_size; ++my_local_pos)
     {
-      value = 0; T_boundary_left = 0, T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(c_ref[my_local_pos].getMZ(), charge) / (double)charge;
-      old = 0; old_pos = (my_local_pos - from_max_to_left_ - 1 >= 0) ? c_ref[my_local_pos - from_max_to_left_ - 1].getMZ() : c_ref[0].getMZ() - min_spacing_;
-      my_local_MZ = c_ref[my_local_pos].getMZ(); my_local_lambda = IsotopeWavelet::getLambdaL(my_local_MZ * charge);
-      c_diff = 0;
-      origin = -my_local_MZ + Constants::IW_QUARTER_NEUTRON_MASS / (double)charge;
+      c_trans[my_local_pos].setIntensity(getTransformedIntensity_(c_ref, my_local_pos, c));
+    }
+  }
 
-      for (Int current_conv_pos =  std::max(0, my_local_pos - from_max_to_left_); c_diff < T_boundary_right; ++current_conv_pos)
-      {
-        if (current_conv_pos >= spec_size)
-        {
-          value += 0.5 * old * min_spacing_;
-          break;
-        }
+  template <typename PeakType>
+  void IsotopeWaveletTransform<PeakType>::getTransformHighRes(MSSpectrum<PeakType>& c_trans, const MSSpectrum<PeakType>& c_ref, const UInt c)
+  {
+    Int spec_size((Int)c_ref.size());
+    //in the very unlikely case that size_t will not fit to int anymore this will be a problem of course
+    //for the sake of simplicity (we need here a signed int) we do not cast at every following comparison individually
 
-        c_mz = c_ref[current_conv_pos].getMZ();
-        c_diff = c_mz + origin;
+    // the transformed value of every data point only depends on the input spectrum
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (Int my_local_pos = 0; my_local_pos < spec_size; ++my_local_pos)
+    {
+      c_trans[my_local_pos].setIntensity(getTransformedIntensityHighRes_(c_ref, my_local_pos, c));
+    }
+  }
 
-        //Attention! The +1. has nothing to do with the charge, it is caused by the wavelet's formula (tz1).
-        current = c_diff > T_boundary_left && c_diff <= T_boundary_right ? IsotopeWavelet::getValueByLambda(my_local_lambda, c_diff * charge + 1.) * c_ref[current_conv_pos].getIntensity() : 0;
+  template <typename PeakType>
+  void IsotopeWaveletTransform<PeakType>::getTransforms(std::vector<MSSpectrum<PeakType> >& c_trans, const MSSpectrum<PeakType>& c_ref, const bool high_res)
+  {
+    Int spec_size((Int)c_ref.size());
+    Int nr_charges((Int)c_trans.size());
 
-        value += 0.5 * (current + old) * (c_mz - old_pos);
+    // one loop over the data points of all charge states (the charge states alone
+    // are usually fewer than the threads); points of a charge state stay together
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (Int i = 0; i < nr_charges * spec_size; ++i)
+    {
+      const UInt c = i / spec_size;
+      const Int my_local_pos = i % spec_size;
+      c_trans[c][my_local_pos].setIntensity(high_res ? getTransformedIntensityHighRes_(c_ref, my_local_pos, c) : getTransformedIntensity_(c_ref, my_local_pos, c));
+    }
+  }
+
+  template <typename PeakType>
+  double IsotopeWaveletTransform<PeakType>::getTransformedIntensity_(const MSSpectrum<PeakType>& c_ref, const Int my_local_pos, const UInt c) const
+  {
+    Int spec_size((Int)c_ref.size());
+    UInt charge = c + 1;
+    double value, T_boundary_left, T_boundary_right, old, c_diff, current, old_pos, my_local_MZ, my_local_lambda, origin, c_mz;
+    value = 0; T_boundary_left = 0, T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(c_ref[my_local_pos].getMZ(), charge) / (double)charge;
+    old = 0; old_pos = (my_local_pos - from_max_to_left_ - 1 >= 0) ? c_ref[my_local_pos - from_max_to_left_ - 1].getMZ() : c_ref[0].getMZ() - min_spacing_;
+    my_local_MZ = c_ref[my_local_pos].getMZ(); my_local_lambda = IsotopeWavelet::getLambdaL(my_local_MZ * charge);
+    c_diff = 0;
+    origin = -my_local_MZ + Constants::IW_QUARTER_NEUTRON_MASS / (double)charge;
 
-        old = current;
-        old_pos = c_mz;
+    for (Int current_conv_pos =  std::max(0, my_local_pos - from_max_to_left_); c_diff < T_boundary_right; ++current_conv_pos)
+    {
+      if (current_conv_pos >= spec_size)
+      {
+        value += 0.5 * old * min_spacing_;
+        break;
       }
 
+      c_mz = c_ref[current_conv_pos].getMZ();
+      c_diff = c_mz + origin;
+
+      //Attention! The +1. has nothing to do with the charge, it is caused by the wavelet's formula (tz1).
+      current = c_diff > T_boundary_left && c_diff <= T_boundary_right ? IsotopeWavelet::getValueByLambda(my_local_lambda, c_diff * charge + 1.) * c_ref[current_conv_pos].getIntensity() : 0;
 
+      value += 0.5 * (current + old) * (c_mz - old_pos);
 
-      c_trans[my_local_pos].setIntensity(value);
+      old = current;
+      old_pos = c_mz;
     }
+
+    return value;
   }
 
   template <typename PeakType>
-  void IsotopeWaveletTransform<PeakType>::getTransformHighRes(MSSpectrum<PeakType>& c_trans, const MSSpectrum<PeakType>& c_ref, const UInt c)
+  double IsotopeWaveletTransform<PeakType>::getTransformedIntensityHighRes_(const MSSpectrum<PeakType>& c_ref, const Int my_local_pos, const UInt c) const
   {
     Int spec_size((Int)c_ref.size());
-    //in the very unlikely case that size_t will not fit to int anymore this will be a problem of course
-    //for the sake of simplicity (we need here a signed int) we do not cast at every following comparison individually
     UInt charge = c + 1;
     double value, T_boundary_left, T_boundary_right, c_diff, current, my_local_MZ, my_local_lambda, origin, c_mz;
+    value = 0; T_boundary_left = 0, T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(c_ref[my_local_pos].getMZ(), charge) / (double)charge;
 
-    for (Int my_local_pos = 0; my_local_pos < spec_size; ++my_local_pos)
-    {
-      value = 0; T_boundary_left = 0, T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(c_ref[my_local_pos].getMZ(), charge) / (double)charge;
-
+    my_local_MZ = c_ref[my_local_pos].getMZ(); my_local_lambda = IsotopeWavelet::getLambdaL(my_local_MZ * charge);
+    c_diff = 0;
+    origin = -my_local_MZ + Constants::IW_QUARTER_NEUTRON_MASS / (double)charge;
 
-      my_local_MZ = c_ref[my_local_pos].getMZ(); my_local_lambda = IsotopeWavelet::getLambdaL(my_local_MZ * charge);
-      c_diff = 0;
-      origin = -my_local_MZ + Constants::IW_QUARTER_NEUTRON_MASS / (double)charge;
-
-      for (Int current_conv_pos =  std::max(0, my_local_pos - from_max_to_left_); c_diff < T_boundary_right; ++current_conv_pos)
+    for (Int current_conv_pos =  std::max(0, my_local_pos - from_max_to_left_); c_diff < T_boundary_right; ++current_conv_pos)
+    {
+      if (current_conv_pos >= spec_size)
       {
-        if (current_conv_pos >= spec_size)
-        {
-          break;
-        }
-
-        c_mz = c_ref[current_conv_pos].getMZ();
-        c_diff = c_mz + origin;
+        break;
+      }
 
-        //Attention! The +1. has nothing to do with the charge, it is caused by the wavelet's formula (tz1).
-        current = c_diff > T_boundary_left && c_diff <= T_boundary_right ? IsotopeWavelet::getValueByLambda(my_local_lambda, c_diff * charge + 1.) * c_ref[current_conv_pos].getIntensity() : 0;
+      c_mz = c_ref[current_conv_pos].getMZ();
+      c_diff = c_mz + origin;
 
-        value += current;
-      }
+      //Attention! The +1. has nothing to do with the charge, it is caused by the wavelet's formula (tz1).
+      current = c_diff > T_boundary_left && c_diff <= T_boundary_right ? IsotopeWavelet::getValueByLambda(my_local_lambda, c_diff * charge + 1.) * c_ref[current_conv_pos].getIntensity() : 0;
 
-      c_trans[my_local_pos].setIntensity(value);
+      value += current;
     }
+
+    return value;
   }
 
   template <typename PeakType>
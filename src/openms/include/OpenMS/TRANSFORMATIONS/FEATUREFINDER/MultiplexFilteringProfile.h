@@ -46,9 +46,12 @@
 #include <OpenMS/FILTERING/DATAREDUCTION/SplineSpectrum.h>
 
 #include <vector>
+#include <map>
 #include <algorithm>
 #include <iostream>
 
+#include <boost/shared_ptr.hpp>
+
 namespace OpenMS
 {
   /**
@@ -103,6 +106,51 @@ public:
     std::vector<MultiplexFilterResult> filter();
 
 private:
+    /**
+     * @brief spline fit of a profile spectrum and its intensities at the pattern positions
+     *
+     * For each peak, the spline is scanned on its m/z grid between the peak boundaries. The intensities at the
+     * corresponding positions of another peak are evaluated once and shared by all patterns.
+     */
+    struct SplineIntensities
+    {
+      /// spline fit of the profile spectrum
+      boost::shared_ptr<SplineSpectrum> spline;
+      /// positions, boundaries and intensities of the centroided peaks
+      std::vector<double> peak_position;
+      std::vector<double> peak_min;
+      std::vector<double> peak_max;
+      std::vector<double> peak_intensity;
+      /// m/z grid between the boundaries of each peak (empty until first used)
+      std::vector<std::vector<double> > mz_grid;
+      /// spline intensities on the m/z grid of a peak shifted to another peak, indexed by (peak, other peak)
+      std::map<std::pair<int, int>, std::vector<double> > intensities;
+    };
+
+    /**
+     * @brief fits the splines of the spectra [begin, end) in parallel
+     *
+     * Splines that cannot be fitted are left empty and fitted again by filterSpectrum_().
+     */
+    void fitSplines_(std::vector<SplineIntensities>& splines, int begin, int end);
+
+    /**
+     * @brief returns the m/z grid scanned for a peak
+     */
+    const std::vector<double>& getMzGrid_(SplineIntensities& spline, SplineSpectrum::Navigator& nav, int peak) const;
+
+    /**
+     * @brief returns the spline intensities on the m/z grid of @p peak shifted by the distance to @p shifted_peak
+     */
+    const std::vector<double>& getShiftedIntensities_(SplineIntensities& spline, SplineSpectrum::Navigator& nav, int peak, int shifted_peak) const;
+
+    /**
+     * @brief filters a single spectrum for a pattern and adds the peaks passing all filters to @p result
+     *
+     * @throw Exception::IllegalArgument if number of peaks and number of peak boundaries differ
+     */
+    void filterSpectrum_(int pattern, int spectrum, SplineIntensities& spline, MultiplexFilterResult& result, unsigned& progress);
+
     /**
      * @brief non-local intensity filter
      *
@@ -110,16 +158,14 @@ private:
      * We check not only at m/z but at all pattern positions i.e. non-locally.
      *
      * @param pattern    pattern of isotopic peaks to be searched for
-     * @param mz_shifts_actual    actual m/z shifts seen in the spectrum (will differ slightly from expected m/z shifts in pattern)
-     * @param mz_shifts_actual_indices    indices of peaks corresponding to the pattern
-     * @param nav    navigator for moving on the spline-interpolated spectrum
+     * @param shifted_intensities    spline-interpolated intensities at the actual m/z shifts of the pattern (null if no peak corresponds to the pattern)
+     * @param mz_index    index of the reference m/z position of the pattern in the m/z grid
      * @param intensities_actual    output for the spline-interpolated intensities at the actual m/z shift positions
      * @param peaks_found_in_all_peptides    number of isotopic peaks seen for each peptide (peaks)
-     * @param mz    reference m/z position of the pattern (mono-isotopic peak of the lightest peptide)
      *
      * @return number of isotopic peaks seen for each peptide (profile)
      */
-    int nonLocalIntensityFilter_(const MultiplexIsotopicPeakPattern& pattern, const std::vector<double>& mz_shifts_actual, const std::vector<int>& mz_shifts_actual_indices, SplineSpectrum::Navigator nav, std::vector<double>& intensities_actual, int peaks_found_in_all_peptides, double mz) const;
+    int nonLocalIntensityFilter_(const MultiplexIsotopicPeakPattern& pattern, const std::vector<const std::vector<double>*>& shifted_intensities, Size mz_index, std::vector<double>& intensities_actual, int peaks_found_in_all_peptides) const;
 
     /**
      * @brief returns the index of a peak which is nearest m/z
@@ -61,7 +61,7 @@ namespace OpenMS
   {
   }
 
-  double ILPDCWrapper::compute(const FeatureMap fm, PairsType& pairs, Size verbose_level) const
+  double ILPDCWrapper::compute(const FeatureMap& fm, PairsType& pairs, Size verbose_level) const
   {
     if (fm.empty())
     {
@@ -203,14 +203,66 @@ namespace OpenMS
     time1.start();
 
     // split problem into slices and have each one solved by the ILPS
-    double score = 0;
-// OMP currently causes spurious segfaults in Release mode; OMP fix applied, however: disable if problem persists
-//#ifdef _OPENMP
-//#pragma omp parallel for schedule(dynamic, 1), reduction(+: score)
-//#endif
+    // The slices hold independent components, each one is solved with its own
+    // LP. The slices do not modify 'pairs', they write the edge scores and the
+    // realized edges of their range into separate buffers, which are merged
+    // after all slices are solved. GLPK is not thread-safe, thus slices are
+    // only solved concurrently with the CBC (Coin-Or) backend.
+    // The LPs are created up front, since the LPWrapper constructor always
+    // creates a GLPK problem.
+    std::vector<LPWrapper*> slice_lps(bins.size(), 0);
+    for (Size i = 0; i < bins.size(); ++i)
+    {
+      slice_lps[i] = new LPWrapper();
+    }
+
+    std::vector<double> edge_scores(pairs.size(), 0.0);
+    std::vector<char> edge_active(pairs.size(), 0);
+    std::vector<double> slice_scores(bins.size(), 0.0);
+    // exceptions must not leave the parallel region: failed slices are solved
+    // again afterwards (with a new LP), so the exception reaches the caller
+    std::vector<char> slice_failed(bins.size(), 0);
+#ifdef _OPENMP
+    const bool parallel_slices = (!slice_lps.empty() && slice_lps[0]->getSolver() != LPWrapper::SOLVER_GLPK);
+#pragma omp parallel for schedule(dynamic, 1) if (parallel_slices)
+#endif
     for (SignedSize i = 0; i < static_cast<SignedSize>(bins.size()); ++i)
     {
-      score = computeSlice_(fm, pairs, bins[i].first, bins[i].second, verbose_level);
+      try
+      {
+        slice_scores[i] = computeSlice_(fm, pairs, bins[i].first, bins[i].second, verbose_level, *slice_lps[i], edge_scores, edge_active);
+      }
+      catch (std::exception&)
+      {
+        slice_failed[i] = 1;
+      }
+    }
+    for (Size i = 0; i < slice_lps.size(); ++i)
+    {
+      delete slice_lps[i];
+    }
+    for (Size i = 0; i < bins.size(); ++i)
+    {
+      if (slice_failed[i])
+      {
+        LPWrapper build;
+        slice_scores[i] = computeSlice_(fm, pairs, bins[i].first, bins[i].second, verbose_level, build, edge_scores, edge_active);
+      }
+    }
+
+    // merge the results of all slices (and add up the objective values in a fixed order)
+    double score = 0;
+    for (Size i = 0; i < slice_scores.size(); ++i)
+    {
+      score += slice_scores[i];
+    }
+    for (Size i = 0; i < pairs.size(); ++i)
+    {
+      pairs[i].setEdgeScore(edge_scores[i]);
+      if (edge_active[i])
+      {
+        pairs[i].setActive(true);
+      }
     }
     time1.stop();
     LOG_INFO << " Branch and cut took " << time1.getClockTime() << " seconds, "
@@ -225,18 +277,20 @@ namespace OpenMS
     f_set[rota_l].insert(v);
   }
 
-  double ILPDCWrapper::computeSlice_(const FeatureMap fm,
-                                     PairsType& pairs,
+  double ILPDCWrapper::computeSlice_(const FeatureMap& fm,
+                                     const PairsType& pairs,
                                      const PairsIndex margin_left,
                                      const PairsIndex margin_right,
-                                     const Size /* verbose_level */) const
+                                     const Size /* verbose_level */,
+                                     LPWrapper& build,
+                                     std::vector<double>& edge_scores,
+                                     std::vector<char>& edge_active) const
   {
     // feature --> variants set  (with scores)
     typedef std::map<Size, FeatureType_> r_type;
     r_type features;
 
 
-    LPWrapper build;
     //build.setSolver(LPWrapper::SOLVER_GLPK);
     build.setObjectiveSense(LPWrapper::MAX); // maximize
 
@@ -246,13 +300,13 @@ namespace OpenMS
       // log scores are good for addition in ILP - but they are < 0, thus not suitable for maximizing
       // ... so we just add normal probabilities...
       double score = exp(getLogScore_(pairs[i], fm));
-      pairs[i].setEdgeScore(score * pairs[i].getEdgeScore()); // multiply with preset score
+      edge_scores[i] = score * pairs[i].getEdgeScore(); // multiply with preset score
 
       // create the column representing the edge
       Int index = build.addColumn();
       build.setColumnBounds(index, 0, 1, LPWrapper::DOUBLE_BOUNDED);
       build.setColumnType(index, LPWrapper::INTEGER); // integer variable
-      build.setObjective(index, pairs[i].getEdgeScore());
+      build.setObjective(index, edge_scores[i]);
 
       // create feature variants set
       String rota_l = String(pairs[i].getElementIndex(0)) + pairs[i].getCompomer().getAdductsAsString(0) + "_" + pairs[i].getCharge(0);
@@ -312,7 +366,7 @@ namespace OpenMS
       double value = build.getColumnValue(iColumn);
       if (fabs(value) > 0.5)
       {
-        pairs[margin_left + iColumn].setActive(true);
+        edge_active[margin_left + iColumn] = 1;
       }
       else
       {
@@ -327,7 +381,7 @@ namespace OpenMS
 
   // old version, slower, as ILP has different layout (i.e, the same as described in paper)
 
-  double ILPDCWrapper::computeSliceOld_(const FeatureMap fm,
+  double ILPDCWrapper::computeSliceOld_(const FeatureMap& fm,
                                         PairsType& pairs,
                                         const PairsIndex margin_left,
                                         const PairsIndex margin_right,
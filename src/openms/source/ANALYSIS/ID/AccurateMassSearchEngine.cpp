@@ -107,7 +107,7 @@ namespace OpenMS
 
   /// checks if an adduct (e.g.a 'M+2K-H;1+') is valid, i.e. if the losses (==negative amounts) can actually be lost by the compound given in @p db_entry.
   /// If the negative parts are present in @p db_entry, true is returned.
-  bool AdductInfo::isCompatible(EmpiricalFormula db_entry) const
+  bool AdductInfo::isCompatible(const EmpiricalFormula& db_entry) const
   {
     return db_entry.contains(ef_ * -1);
   }
@@ -565,6 +565,7 @@ namespace OpenMS
 
     // Depending on ion_mode_internal_, either positive or negative adducts are used
     std::vector<AdductInfo>::const_iterator it_s, it_e;
+    bool positive_mode(true);
     if (ion_mode == "positive")
     {
       it_s = pos_adducts_.begin();
@@ -574,6 +575,7 @@ namespace OpenMS
     {
       it_s = neg_adducts_.begin();
       it_e = neg_adducts_.end();
+      positive_mode = false;
     }
     else
     {
@@ -621,8 +623,11 @@ namespace OpenMS
       // store information from query hits in AccurateMassSearchResult objects
       for (Size i = hit_idx.first; i < hit_idx.second; ++i)
       {
-        // check if DB entry is compatible to the adduct
-        if (!it->isCompatible(EmpiricalFormula(mass_mappings_[i].formula)))
+        // check if DB entry is compatible to the adduct (precomputed in init())
+        // (an empty table means the formula could not be parsed; parsing it here reports the error for this entry)
+        const std::vector<bool>& compatible = (positive_mode ? mass_mappings_[i].pos_compatible : mass_mappings_[i].neg_compatible);
+        bool is_compatible = compatible.empty() ? it->isCompatible(EmpiricalFormula(mass_mappings_[i].formula)) : compatible[std::distance(it_s, it)];
+        if (!is_compatible)
         {
           // only written if TOPP tool has --debug
           LOG_DEBUG << "'" << mass_mappings_[i].formula << "' cannot have adduct '" << it->getName() << "'. Omitting.\n";
@@ -768,6 +773,8 @@ namespace OpenMS
     parseAdductsFile_(pos_adducts_fname_, pos_adducts_);
     parseAdductsFile_(neg_adducts_fname_, neg_adducts_);
 
+    computeAdductCompatibility_();
+
     is_initialized_ = true;
   }
 
@@ -784,38 +791,45 @@ namespace OpenMS
       ion_mode_internal = resolveAutoMode_(fmap);
     }
 
+    // query all features in parallel (the DB and adducts are read-only at this point);
+    // results are collected per feature and merged afterwards to keep the output order stable
+    QueryResultsTable feature_results(fmap.size());
+    // exceptions must not leave the parallel region; remember the first feature which failed
+    SignedSize first_failed(-1);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)fmap.size(); ++i)
+    {
+      try
+      {
+        // std::cout << i << ": " << fmap[i].getMetaValue(3) << " mass: " << fmap[i].getMZ() << " num_traces: " << fmap[i].getMetaValue("num_of_masstraces") << " charge: " << fmap[i].getCharge() << std::endl;
+        queryAndScoreFeature_(fmap[i], i, ion_mode_internal, feature_results[i]);
+      }
+      catch (...)
+      {
+#ifdef _OPENMP
+#pragma omp critical (AccurateMassSearchEngine_error)
+#endif
+        if (first_failed < 0 || i < first_failed) first_failed = i;
+      }
+    }
+    if (first_failed >= 0)
+    { // the query is const, so repeating it outside of the parallel region rethrows the original exception
+      std::vector<AccurateMassSearchResult> query_results;
+      queryAndScoreFeature_(fmap[first_failed], first_failed, ion_mode_internal, query_results);
+      feature_results[first_failed] = query_results;
+    }
+
     // map for storing overall results
     QueryResultsTable overall_results;
     Size dummy_count(0);
     for (Size i = 0; i < fmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results;
-
-      // std::cout << i << ": " << fmap[i].getMetaValue(3) << " mass: " << fmap[i].getMZ() << " num_traces: " << fmap[i].getMetaValue("num_of_masstraces") << " charge: " << fmap[i].getCharge() << std::endl;
-      queryByFeature(fmap[i], i, ion_mode_internal, query_results);
-
+      const std::vector<AccurateMassSearchResult>& query_results = feature_results[i];
       if (query_results.size() == 0) continue; // cannot happen if a 'not-found' dummy was added
 
-      bool is_dummy = (query_results[0].getMatchingIndex() == (Size)-1);
-      if (is_dummy) ++dummy_count;
-
-      if (iso_similarity_ && !is_dummy)
-      {
-        if (!fmap[i].metaValueExists("num_of_masstraces"))
-        {
-          LOG_WARN << "Feature does not contain meta value 'num_of_masstraces'. Cannot compute isotope similarity.";
-        }
-        else if ((Size)fmap[i].getMetaValue("num_of_masstraces") > 1)
-        { // compute isotope pattern similarities (do not take the best-scoring one, since it might have really bad ppm or other properties -- 
-          // it is impossible to decide here which one is best
-          for (Size hit_idx = 0; hit_idx < query_results.size(); ++hit_idx)
-          {
-            String emp_formula(query_results[hit_idx].getFormulaString());
-            double iso_sim(computeIsotopePatternSimilarity_(fmap[i], EmpiricalFormula(emp_formula)));
-            query_results[hit_idx].setIsotopesSimScore(iso_sim);
-          }
-        }
-      }
+      if (query_results[0].getMatchingIndex() == (Size)-1) ++dummy_count;
 
       // debug output
       //        for (Size hit_idx = 0; hit_idx < query_results.size(); ++hit_idx)
@@ -847,6 +861,33 @@ namespace OpenMS
     return;
   }
 
+  void AccurateMassSearchEngine::queryAndScoreFeature_(const Feature& feature, const Size& feature_index, const String& ion_mode, std::vector<AccurateMassSearchResult>& query_results) const
+  {
+    queryByFeature(feature, feature_index, ion_mode, query_results);
+
+    if (query_results.size() == 0) return; // cannot happen if a 'not-found' dummy was added
+
+    bool is_dummy = (query_results[0].getMatchingIndex() == (Size)-1);
+
+    if (iso_similarity_ && !is_dummy)
+    {
+      if (!feature.metaValueExists("num_of_masstraces"))
+      {
+        LOG_WARN << "Feature does not contain meta value 'num_of_masstraces'. Cannot compute isotope similarity.";
+      }
+      else if ((Size)feature.getMetaValue("num_of_masstraces") > 1)
+      { // compute isotope pattern similarities (do not take the best-scoring one, since it might have really bad ppm or other properties -- 
+        // it is impossible to decide here which one is best
+        for (Size hit_idx = 0; hit_idx < query_results.size(); ++hit_idx)
+        {
+          String emp_formula(query_results[hit_idx].getFormulaString());
+          double iso_sim(computeIsotopePatternSimilarity_(feature, EmpiricalFormula(emp_formula)));
+          query_results[hit_idx].setIsotopesSimScore(iso_sim);
+        }
+      }
+    }
+  }
+
   void AccurateMassSearchEngine::annotate_(const std::vector<AccurateMassSearchResult>& amr, BaseFeature& f) const
   {
     f.getPeptideIdentifications().resize(f.getPeptideIdentifications().size() + 1);
@@ -897,16 +938,36 @@ namespace OpenMS
     ConsensusMap::FileDescriptions fd_map = cmap.getFileDescriptions();
     Size num_of_maps = fd_map.size();
 
-    // map for storing overall results
-    QueryResultsTable overall_results;
-
+    // map for storing overall results (one entry per consensus feature, filled in parallel)
+    QueryResultsTable overall_results(cmap.size());
+    // exceptions must not leave the parallel region; remember the first consensus feature which failed
+    SignedSize first_failed(-1);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)cmap.size(); ++i)
+    {
+      try
+      {
+        // std::cout << i << ": " << cmap[i].getMetaValue(3) << " mass: " << cmap[i].getMZ() << " num_traces: " << cmap[i].getMetaValue("num_of_masstraces") << " charge: " << cmap[i].getCharge() << std::endl;
+        queryByConsensusFeature(cmap[i], i, num_of_maps, ion_mode_internal, overall_results[i]);
+      }
+      catch (...)
+      {
+#ifdef _OPENMP
+#pragma omp critical (AccurateMassSearchEngine_error)
+#endif
+        if (first_failed < 0 || i < first_failed) first_failed = i;
+      }
+    }
+    if (first_failed >= 0)
+    { // the query is const, so repeating it outside of the parallel region rethrows the original exception
+      overall_results[first_failed].clear();
+      queryByConsensusFeature(cmap[first_failed], first_failed, num_of_maps, ion_mode_internal, overall_results[first_failed]);
+    }
     for (Size i = 0; i < cmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results;
-      // std::cout << i << ": " << cmap[i].getMetaValue(3) << " mass: " << cmap[i].getMZ() << " num_traces: " << cmap[i].getMetaValue("num_of_masstraces") << " charge: " << cmap[i].getCharge() << std::endl;
-      queryByConsensusFeature(cmap[i], i, num_of_maps, ion_mode_internal, query_results);
-      annotate_(query_results, cmap[i]);
-      overall_results.push_back(query_results);
+      annotate_(overall_results[i], cmap[i]);
     }
     // add dummy protein identification which is required to keep peptidehits alive during store()
     cmap.getProteinIdentifications().resize(cmap.getProteinIdentifications().size() + 1);
@@ -1458,6 +1519,38 @@ namespace OpenMS
     return;
   }
 
+  void AccurateMassSearchEngine::computeAdductCompatibility_()
+  {
+    // EmpiricalFormula parsing is expensive; doing it once per DB entry here
+    // avoids re-parsing the formula for every hit of every query in queryByMZ()
+    for (Size i = 0; i < mass_mappings_.size(); ++i)
+    {
+      MappingEntry_& entry = mass_mappings_[i];
+      entry.pos_compatible.clear();
+      entry.neg_compatible.clear();
+      EmpiricalFormula ef;
+      try
+      {
+        ef = EmpiricalFormula(entry.formula);
+      }
+      catch (Exception::BaseException& /*e*/)
+      { // leave the tables empty; the entry is checked (and the error reported) when a query hits it
+        continue;
+      }
+
+      entry.pos_compatible.resize(pos_adducts_.size());
+      for (Size a = 0; a < pos_adducts_.size(); ++a)
+      {
+        entry.pos_compatible[a] = pos_adducts_[a].isCompatible(ef);
+      }
+      entry.neg_compatible.resize(neg_adducts_.size());
+      for (Size a = 0; a < neg_adducts_.size(); ++a)
+      {
+        entry.neg_compatible[a] = neg_adducts_[a].isCompatible(ef);
+      }
+    }
+  }
+
   void AccurateMassSearchEngine::searchMass_(double neutral_query_mass, double diff_mass, std::pair<Size, Size>& hit_indices) const
   {
     //LOG_INFO << "searchMass: neutral_query_mass=" << neutral_query_mass << " diff_mz=" << diff_mz << " ppm allowed:" << mass_error_value_ << std::endl;
@@ -37,6 +37,8 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 
 #include <algorithm>
+#include <functional>
+#include <map>
 
 // #define FALSE_DISCOVERY_RATE_DEBUG
 // #undef  FALSE_DISCOVERY_RATE_DEBUG
@@ -79,12 +81,19 @@ namespace OpenMS
       return;
     }
 
-    // first search for all identifiers and charge variants
-    set<String> identifiers;
-    set<SignedSize> charge_variants;
+    // Single pass over all peptide hits: each hit becomes one entry of a
+    // compact array (in the order of the hits) and is assigned to a group,
+    // which is defined by its run (if runs are treated separately) and its
+    // charge (if charge variants are split).
+    // Groups are then processed independently.
+    typedef std::pair<String, Int> GroupKey;
+    std::map<GroupKey, Size> group_index;
+    std::vector<GroupKey> group_keys;
+    std::vector<std::vector<Size> > group_entries;
+
+    std::vector<FDREntry_> entries;
     for (vector<PeptideIdentification>::iterator it = ids.begin(); it != ids.end(); ++it)
     {
-      identifiers.insert(it->getIdentifier());
       it->sort();
 
       if (!use_all_hits)
@@ -92,227 +101,156 @@ namespace OpenMS
         it->getHits().resize(1);
       }
 
-      for (vector<PeptideHit>::const_iterator pit = it->getHits().begin(); pit != it->getHits().end(); ++pit)
+      for (Size i = 0; i < it->getHits().size(); ++i)
       {
-        charge_variants.insert(pit->getCharge());
+        const PeptideHit& hit = it->getHits()[i];
+        if (!hit.metaValueExists("target_decoy"))
+        {
+          LOG_FATAL_ERROR << "Meta value 'target_decoy' does not exists, reindex the idXML file with 'PeptideIndexer' first (run-id='" << it->getIdentifier() << ", rank=" << i + 1 << " of " << it->getHits().size() << ")!" << endl;
+          throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Meta value 'target_decoy' does not exist!");
+        }
+
+        FDREntry_ entry;
+        entry.score = hit.getScore();
+        String target_decoy(hit.getMetaValue("target_decoy"));
+        if (target_decoy == "target" || target_decoy == "target+decoy")
+        {
+          entry.type = FDREntry_::TARGET;
+        }
+        else if (target_decoy == "decoy")
+        {
+          entry.type = FDREntry_::DECOY;
+        }
+        else if (target_decoy == "")
+        {
+          entry.type = FDREntry_::UNKNOWN;
+        }
+        else
+        {
+          throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unknown value of meta value 'target_decoy'", target_decoy);
+        }
+
+        GroupKey key(treat_runs_separately ? it->getIdentifier() : String(), split_charge_variants ? hit.getCharge() : 0);
+        std::map<GroupKey, Size>::const_iterator g_it = group_index.find(key);
+        if (g_it == group_index.end())
+        {
+          g_it = group_index.insert(std::make_pair(key, group_keys.size())).first;
+          group_keys.push_back(key);
+          group_entries.push_back(std::vector<Size>());
+        }
+        entry.group = g_it->second;
+        group_entries[entry.group].push_back(entries.size());
+        entries.push_back(entry);
       }
     }
 
 #ifdef FALSE_DISCOVERY_RATE_DEBUG
-    cerr << "#id-runs: " << identifiers.size() << " ";
-    for (set<String>::const_iterator it = identifiers.begin(); it != identifiers.end(); ++it)
-    {
-      cerr << "," << *it;
-    }
-    cerr << endl;
-
-
-    cerr << "#of charge states: " << charge_variants.size() << " ";
-    for (set<SignedSize>::const_iterator it = charge_variants.begin(); it != charge_variants.end(); ++it)
-    {
-      cerr << "," << *it;
-    }
-    cerr << endl;
+    cerr << "#groups (id-runs x charge states): " << group_keys.size() << endl;
 #endif
 
-    for (set<SignedSize>::const_iterator zit = charge_variants.begin(); zit != charge_variants.end(); ++zit)
-    {
-#ifdef FALSE_DISCOVERY_RATE_DEBUG
-      cerr << "Charge variant=" << *zit << endl;
+    // compute the FDR / q-value of each entry, one group at a time (in parallel)
+    bool higher_score_better(ids.begin()->isHigherScoreBetter());
+    std::vector<bool> group_has_fdr(group_keys.size(), true);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
 #endif
+    for (SignedSize g = 0; g < (SignedSize)group_keys.size(); ++g)
+    {
+      const std::vector<Size>& members = group_entries[g];
 
-      // for all identifiers
-      for (set<String>::const_iterator iit = identifiers.begin(); iit != identifiers.end(); ++iit)
+      // get the scores of all peptide hits
+      vector<double> target_scores, decoy_scores;
+      for (Size k = 0; k < members.size(); ++k)
       {
-        if (!treat_runs_separately && iit != identifiers.begin())
+        const FDREntry_& entry = entries[members[k]];
+        if (entry.type == FDREntry_::TARGET)
         {
-          continue;
+          target_scores.push_back(entry.score);
+        }
+        else if (entry.type == FDREntry_::DECOY)
+        {
+          decoy_scores.push_back(entry.score);
         }
+      }
 
 #ifdef FALSE_DISCOVERY_RATE_DEBUG
-        cerr << "Id-run: " << *iit << endl;
+      cerr << "#target-scores=" << target_scores.size() << ", #decoy-scores=" << decoy_scores.size() << endl;
 #endif
-        // get the scores of all peptide hits
-        vector<double> target_scores, decoy_scores;
-        for (vector<PeptideIdentification>::iterator it = ids.begin(); it != ids.end(); ++it)
+
+      if (target_scores.empty() || decoy_scores.empty())
+      {
+        String error_string = decoy_scores.empty() ?
+          "FalseDiscoveryRate: #decoy sequences is zero! Setting all target sequences to q-value/FDR 0! " :
+          "FalseDiscoveryRate: #target sequences is zero! Ignoring. ";
+        if (split_charge_variants || treat_runs_separately)
         {
-          // if runs should be treated separately, the identifiers must be the same
-          if (treat_runs_separately && it->getIdentifier() != *iit)
+          error_string += "(";
+          if (split_charge_variants)
           {
-            continue;
+            error_string += "charge_variant=" + String(group_keys[g].second) + " ";
           }
-
-          for (Size i = 0; i < it->getHits().size(); ++i)
+          if (treat_runs_separately)
           {
-            if (split_charge_variants && it->getHits()[i].getCharge() != *zit)
-            {
-              continue;
-            }
-
-            if (!it->getHits()[i].metaValueExists("target_decoy"))
-            {
-              LOG_FATAL_ERROR << "Meta value 'target_decoy' does not exists, reindex the idXML file with 'PeptideIndexer' first (run-id='" << it->getIdentifier() << ", rank=" << i + 1 << " of " << it->getHits().size() << ")!" << endl;
-              throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Meta value 'target_decoy' does not exist!");
-            }
-
-            String target_decoy(it->getHits()[i].getMetaValue("target_decoy"));
-            if (target_decoy == "target" || target_decoy == "target+decoy")
-            {
-              target_scores.push_back(it->getHits()[i].getScore());
-            }
-            else
-            {
-              if (target_decoy == "decoy")
-              {
-                decoy_scores.push_back(it->getHits()[i].getScore());
-              }
-              else
-              {
-                if (target_decoy != "")
-                {
-                  throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unknown value of meta value 'target_decoy'", target_decoy);
-                }
-              }
-            }
+            error_string += "run-id=" + group_keys[g].first;
           }
+          error_string += ")";
         }
+        LOG_ERROR << error_string << std::endl;
 
-#ifdef FALSE_DISCOVERY_RATE_DEBUG
-        cerr << "#target-scores=" << target_scores.size() << ", #decoy-scores=" << decoy_scores.size() << endl;
-#endif
+        // targets will receive a pseudo-score of 0, decoys are removed (see below)
+        group_has_fdr[g] = false;
+        continue;
+      }
 
-        // check decoy scores
-        if (decoy_scores.empty())
-        {
-          String error_string = "FalseDiscoveryRate: #decoy sequences is zero! Setting all target sequences to q-value/FDR 0! ";
-          if (split_charge_variants || treat_runs_separately)
-          {
-            error_string += "(";
-            if (split_charge_variants)
-            {
-              error_string += "charge_variant=" + String(*zit) + " ";
-            }
-            if (treat_runs_separately)
-            {
-              error_string += "run-id=" + *iit;
-            }
-            error_string += ")";
-          }
-          LOG_ERROR << error_string << std::endl;
-        }
+      // calculate fdr for the forward scores
+      Map<double, double> score_to_fdr;
+      calculateFDRs_(score_to_fdr, target_scores, decoy_scores, q_value, higher_score_better);
 
-        // check target scores
-        if (target_scores.empty())
+      for (Size k = 0; k < members.size(); ++k)
+      {
+        FDREntry_& entry = entries[members[k]];
+        Map<double, double>::const_iterator fdr_it = score_to_fdr.find(entry.score);
+        entry.fdr = (fdr_it != score_to_fdr.end()) ? fdr_it->second : 0.0;
+      }
+    }
+
+    // annotate fdr (entries are in the same order as the hits)
+    Size entry_idx = 0;
+    for (vector<PeptideIdentification>::iterator it = ids.begin(); it != ids.end(); ++it)
+    {
+      String score_type = it->getScoreType() + "_score";
+      vector<PeptideHit> hits;
+      hits.reserve(it->getHits().size());
+      for (vector<PeptideHit>::const_iterator pit = it->getHits().begin(); pit != it->getHits().end(); ++pit, ++entry_idx)
+      {
+        const FDREntry_& entry = entries[entry_idx];
+
+        if (!group_has_fdr[entry.group])
         {
-          String error_string = "FalseDiscoveryRate: #target sequences is zero! Ignoring. ";
-          if (split_charge_variants || treat_runs_separately)
+          // no remove the relevant entries, or put 'pseudo-scores' in
+          if (entry.type == FDREntry_::TARGET)
           {
-            error_string += "(";
-            if (split_charge_variants)
-            {
-              error_string += "charge_variant=" + String(*zit) + " ";
-            }
-            if (treat_runs_separately)
-            {
-              error_string += "run-id=" + *iit;
-            }
-            error_string += ")";
+            // if it is a target hit, there are no decoys, fdr/q-value should be zero then
+            hits.push_back(*pit);
+            hits.back().setMetaValue(score_type, pit->getScore());
+            hits.back().setScore(0);
           }
-          LOG_ERROR << error_string << std::endl;
-        }
-
-        if (target_scores.empty() || decoy_scores.empty())
-        {
-          // no remove the the relevant entries, or put 'pseudo-scores' in
-          for (vector<PeptideIdentification>::iterator it = ids.begin(); it != ids.end(); ++it)
+          else if (entry.type != FDREntry_::DECOY)
           {
-            // if runs should be treated separately, the identifiers must be the same
-            if (treat_runs_separately && it->getIdentifier() != *iit)
-            {
-              continue;
-            }
-
-            vector<PeptideHit> hits(it->getHits()), new_hits;
-            for (Size i = 0; i < hits.size(); ++i)
-            {
-              if (split_charge_variants && hits[i].getCharge() != *zit)
-              {
-                new_hits.push_back(hits[i]);
-                continue;
-              }
-
-              if (!hits[i].metaValueExists("target_decoy"))
-              {
-                LOG_FATAL_ERROR << "Meta value 'target_decoy' does not exists, reindex the idXML file with 'PeptideIndexer' (run-id='" << it->getIdentifier() << ", rank=" << i + 1 << " of " << hits.size() << ")!" << endl;
-                throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Meta value 'target_decoy' does not exist!");
-              }
-
-              String target_decoy(hits[i].getMetaValue("target_decoy"));
-              if (target_decoy == "target" || target_decoy == "target+decoy")
-              {
-                // if it is a target hit, there are now decoys, fdr/q-value should be zero then
-                new_hits.push_back(hits[i]);
-                String score_type = it->getScoreType() + "_score";
-                new_hits.back().setMetaValue(score_type, new_hits.back().getScore());
-                new_hits.back().setScore(0);
-              }
-              else
-              {
-                if (target_decoy != "decoy")
-                {
-                  throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unknown value of meta value 'target_decoy'", target_decoy);
-                }
-              }
-            }
-            it->setHits(new_hits);
+            throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unknown value of meta value 'target_decoy'", "");
           }
           continue;
         }
 
-        // calculate fdr for the forward scores
-        bool higher_score_better(ids.begin()->isHigherScoreBetter());
-        Map<double, double> score_to_fdr;
-        calculateFDRs_(score_to_fdr, target_scores, decoy_scores, q_value, higher_score_better);
-
-        // annotate fdr
-        for (vector<PeptideIdentification>::iterator it = ids.begin(); it != ids.end(); ++it)
+        if (entry.type == FDREntry_::DECOY && !add_decoy_peptides)
         {
-          // if runs should be treated separately, the identifiers must be the same
-          if (treat_runs_separately && it->getIdentifier() != *iit)
-          {
-            continue;
-          }
-
-          String score_type = it->getScoreType() + "_score";
-          vector<PeptideHit> hits;
-          for (vector<PeptideHit>::const_iterator pit = it->getHits().begin(); pit != it->getHits().end(); ++pit)
-          {
-            PeptideHit hit = *pit;
-
-            if (split_charge_variants && pit->getCharge() != *zit)
-            {
-              hits.push_back(*pit);
-              continue;
-            }
-            if (hit.metaValueExists("target_decoy"))
-            {
-              String meta_value = (String)hit.getMetaValue("target_decoy");
-              if (meta_value == "decoy" && !add_decoy_peptides)
-              {
-                continue;
-              }
-            }
-            hit.setMetaValue(score_type, pit->getScore());
-            hit.setScore(score_to_fdr[pit->getScore()]);
-            hits.push_back(hit);
-          }
-          it->setHits(hits);
+          continue;
         }
+        hits.push_back(*pit);
+        hits.back().setMetaValue(score_type, pit->getScore());
+        hits.back().setScore(entry.fdr);
       }
-      if (!split_charge_variants)
-      {
-        break;
-      }
+      it->setHits(hits);
     }
 
     // higher-score-better can be set now, calculations are finished
@@ -659,15 +597,22 @@ namespace OpenMS
 
 
     // assign q-value of decoy_score to closest target_score
+    // (target scores are sorted at this point, so a binary search suffices;
+    // on ties, the target which comes first in sort order is used)
+    bool targets_ascending = (higher_score_better == q_value);
     for (Size i = 0; i != decoy_scores.size(); ++i)
     {
-      Size closest_idx = 0;
-      for (Size k = 0; k != target_scores.size(); ++k)
+      if (target_scores.empty())
       {
-        if (fabs(decoy_scores[i] - target_scores[k]) < fabs(decoy_scores[i] - target_scores[closest_idx]))
-        {
-          closest_idx = k;
-        }
+        break;
+      }
+      vector<double>::const_iterator pos = targets_ascending ?
+        lower_bound(target_scores.begin(), target_scores.end(), decoy_scores[i]) :
+        lower_bound(target_scores.begin(), target_scores.end(), decoy_scores[i], greater<double>());
+      Size closest_idx = std::min((Size)(pos - target_scores.begin()), target_scores.size() - 1);
+      if (closest_idx > 0 && fabs(decoy_scores[i] - target_scores[closest_idx - 1]) <= fabs(decoy_scores[i] - target_scores[closest_idx]))
+      {
+        --closest_idx;
       }
       score_to_fdr[decoy_scores[i]] = score_to_fdr[target_scores[closest_idx]];
     }
@@ -46,6 +46,10 @@
 
 #include <boost/math/special_functions/fpclassify.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // #define Debug_PoseClusteringAffineSuperimposer
 
 namespace OpenMS
@@ -83,6 +87,11 @@ namespace OpenMS
                                                  "the time between consecutive MS scans.");
     defaults_.setMinFloat("shift_bucket_size", 0.);
 
+    defaults_.setValue("anchor_point_stride", 1, "Only every n-th element of the model map (sorted by m/z) is used as the first point of the "
+                                                 "pairs considered for pose clustering.  Values larger than 1 sample the pairs and "
+                                                 "reduce the running time accordingly, at the cost of fewer votes in the histograms.", ListUtils::create<String>("advanced"));
+    defaults_.setMinInt("anchor_point_stride", 1);
+
     defaults_.setValue("max_shift", 1000.0, "Maximal shift which is considered during histogramming (in seconds).  "
                                             "This applies for both directions.", ListUtils::create<String>("advanced"));
     defaults_.setMinFloat("max_shift", 0.);
@@ -154,6 +163,11 @@ namespace OpenMS
     round, only consider quadruplets where the scaling factor matches the
     estimated bounds of (scale_low_1,scale_high_1), discard all other data.
 
+    Only every @p anchor_point_stride -th point of the model map is used as
+    point i. The points are processed in parallel, each thread votes into
+    its own copy of the hash tables which are summed up afterwards (unless
+    the pairs are dumped, which requires a single thread).
+
   */
   void affineTransformationHashing(const bool do_dump_pairs,
                                    const std::vector<Peak2D> & model_map,
@@ -171,8 +185,11 @@ namespace OpenMS
                                    const double total_intensity_ratio,
                                    const double scale_low_1,
                                    const double scale_high_1,
-                                   const double rt_low, const double rt_high)
+                                   const double rt_low, const double rt_high,
+                                   const Size anchor_point_stride)
   {
+    typedef Math::LinearInterpolation<double, double> LinearInterpolationType_;
+
     Size const model_map_size = model_map.size();   // i j
     Size const scene_map_size = scene_map.size();   // k l
 
@@ -185,25 +202,54 @@ namespace OpenMS
       dump_pairs_file << "#" << ' ' << "i" << ' ' << "j" << ' ' << "k" << ' ' << "l" << ' ' << std::endl;
     }
 
+    // each thread hashes into its own (empty) copy of the hash tables
+    Size thread_count = 1;
+#ifdef _OPENMP
+    if (!do_dump_pairs)
+    {
+      thread_count = omp_get_max_threads();
+    }
+#endif
+    std::vector<LinearInterpolationType_> thread_hashes[4];
+    LinearInterpolationType_ * hashes[4] = { &scaling_hash_1, &scaling_hash_2, &rt_low_hash_, &rt_high_hash_ };
+    for (Size h = 0; h < 4; ++h)
+    {
+      LinearInterpolationType_ empty_hash(*hashes[h]);
+      std::fill(empty_hash.getData().begin(), empty_hash.getData().end(), 0.);
+      thread_hashes[h].resize(thread_count, empty_hash);
+    }
+
     // first point in model map (i)
-    for (Size i = 0, i_low = 0, i_high = 0, k_low = 0, k_high = 0; i < model_map_size - 1; ++i)
+    // (cyclic schedule: the work per point decreases with i, and the summation order stays fixed)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(thread_count)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)model_map_size - 1; i += anchor_point_stride)
     {
-      // Adjust window around i in model map (get all features in a m/z range of item i in the model map)
-      while (i_low < model_map_size && model_map[i_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
-        ++i_low;
-      while (i_high < model_map_size && model_map[i_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
-        ++i_high;
+#ifdef _OPENMP
+      const int current_thread = omp_get_thread_num();
+#else
+      const int current_thread(0);
+#endif
+      LinearInterpolationType_ & scaling_hash_1_t = thread_hashes[0][current_thread];
+      LinearInterpolationType_ & scaling_hash_2_t = thread_hashes[1][current_thread];
+      LinearInterpolationType_ & rt_low_hash_t = thread_hashes[2][current_thread];
+      LinearInterpolationType_ & rt_high_hash_t = thread_hashes[3][current_thread];
+
+      // Get window around i in model map (all features in a m/z range of item i in the model map)
+      const double mz_window_low = model_map[i].getMZ() - mz_pair_max_distance;
+      const double mz_window_high = model_map[i].getMZ() + mz_pair_max_distance;
+      const Size i_low = std::lower_bound(model_map.begin(), model_map.end(), mz_window_low, Peak2D::MZLess()) - model_map.begin();
+      const Size i_high = std::upper_bound(model_map.begin(), model_map.end(), mz_window_high, Peak2D::MZLess()) - model_map.begin();
       // stop if there are too many features are in our window
       double i_winlength_factor = 1. / (i_high - i_low);
       i_winlength_factor -= winlength_factor_baseline;
       if (i_winlength_factor <= 0)
         continue;
 
-      // Adjust window around k in scene map (get all features in a m/z range of item i in the scene map)
-      while (k_low < scene_map_size && scene_map[k_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
-        ++k_low;
-      while (k_high < scene_map_size && scene_map[k_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
-        ++k_high;
+      // Get window around k in scene map (all features in a m/z range of item i in the scene map)
+      const Size k_low = std::lower_bound(scene_map.begin(), scene_map.end(), mz_window_low, Peak2D::MZLess()) - scene_map.begin();
+      const Size k_high = std::upper_bound(scene_map.begin(), scene_map.end(), mz_window_high, Peak2D::MZLess()) - scene_map.begin();
 
       // Iterate through all matching features in the scene map that are
       // within the m/z distance of item i from the model map.
@@ -291,17 +337,17 @@ namespace OpenMS
             if (hashing_round == 1)
             {
               // hashing round 1 (estimate the scaling only)
-              scaling_hash_1.addValue(log(scaling), similarity_ik_jl);
+              scaling_hash_1_t.addValue(log(scaling), similarity_ik_jl);
             }
             else if (scaling >= scale_low_1 && scaling <= scale_high_1)
             {
               // hashing round 2 (estimate scaling and shift)
-              scaling_hash_2.addValue(log(scaling), similarity_ik_jl);
+              scaling_hash_2_t.addValue(log(scaling), similarity_ik_jl);
 
               const double rt_low_image = shift + rt_low * scaling;
-              rt_low_hash_.addValue(rt_low_image, similarity_ik_jl);
+              rt_low_hash_t.addValue(rt_low_image, similarity_ik_jl);
               const double rt_high_image = shift + rt_high * scaling;
-              rt_high_hash_.addValue(rt_high_image, similarity_ik_jl);
+              rt_high_hash_t.addValue(rt_high_image, similarity_ik_jl);
 
               if (do_dump_pairs)
               {
@@ -314,6 +360,20 @@ namespace OpenMS
         }   // j
       }   // k
     }   // i
+
+    // sum up the votes of all threads (in a fixed order)
+    for (Size h = 0; h < 4; ++h)
+    {
+      LinearInterpolationType_::container_type & data = hashes[h]->getData();
+      for (Size t = 0; t < thread_count; ++t)
+      {
+        const LinearInterpolationType_::container_type & thread_data = thread_hashes[h][t].getData();
+        for (Size index = 0; index < data.size(); ++index)
+        {
+          data[index] += thread_data[index];
+        }
+      }
+    }
   }
 
   /**
@@ -778,6 +838,9 @@ namespace OpenMS
     /// Maximum deviation in mz of two partner points
     const double mz_pair_max_distance = param_.getValue("mz_pair_max_distance");
 
+    /// Only every n-th point of the model map is used as first point of a pair
+    const Size anchor_point_stride = (Int) param_.getValue("anchor_point_stride");
+
     //**************************************************************************
     // Working variables
     //**************************************************************************
@@ -942,7 +1005,8 @@ namespace OpenMS
       total_intensity_ratio,
       -1, // only used in 2nd round of hashing
       -1, // only used in 2nd round of hashing
-      rt_low, rt_high);
+      rt_low, rt_high,
+      anchor_point_stride);
     setProgress((actual_progress = 30));
 
     ///////////////////////////////////////////////////////////////////
@@ -982,7 +1046,8 @@ namespace OpenMS
       total_intensity_ratio,
       scale_low_1,
       scale_high_1,
-      rt_low, rt_high);
+      rt_low, rt_high,
+      anchor_point_stride);
     setProgress((actual_progress = 50));
 
     ///////////////////////////////////////////////////////////////////
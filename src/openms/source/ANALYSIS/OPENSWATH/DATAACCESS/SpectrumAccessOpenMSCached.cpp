@@ -57,6 +57,22 @@ namespace OpenMS
     MzMLFile().load(filename, meta_ms_experiment_);
   }
 
+  SpectrumAccessOpenMSCached::SpectrumAccessOpenMSCached(String filename, const MSExperimentType& meta_experiment) :
+    meta_ms_experiment_(meta_experiment)
+  {
+    filename_cached_ = filename + ".cached";
+    filename_ = filename;
+
+    // Create the index from the given file
+    CachedmzML cache;
+    cache.createMemdumpIndex(filename_cached_);
+    spectra_index_ = cache.getSpectraIndex();
+    chrom_index_ = cache.getChromatogramIndex();
+
+    // open the filestream
+    ifs_.open(filename_cached_.c_str(), std::ios::binary);
+  }
+
   SpectrumAccessOpenMSCached::~SpectrumAccessOpenMSCached()
   {
     ifs_.close();
@@ -113,8 +113,8 @@ namespace OpenMS
   {
     isotope_corr = 0;
     isotope_overlap = 0;
-    // first compute a map of relative intensities from the feature, then compute the score
-    std::map<std::string, double> intensities;
+    // first compute the relative intensities from the feature, then compute the score
+    std::vector<double> intensities;
     getFirstIsotopeRelativeIntensities_(transitions, mrmfeature, intensities);
     diaIsotopeScoresSub_(transitions, spectrum, intensities, isotope_corr, isotope_overlap);
   }
@@ -125,18 +125,27 @@ namespace OpenMS
   {
     ppm_score = 0;
     ppm_score_weighted = 0;
-    double mz, intensity;
+
+    // integrate the windows of all transitions at once
+    std::vector<double> left, right, intensities, mzs;
+    left.reserve(transitions.size());
+    right.reserve(transitions.size());
+    for (std::size_t k = 0; k < transitions.size(); k++)
+    {
+      left.push_back(transitions[k].getProductMZ() - dia_extract_window_ / 2.0);
+      right.push_back(transitions[k].getProductMZ() + dia_extract_window_ / 2.0);
+    }
+    integrateWindows(spectrum, left, right, intensities, mzs, dia_centroided_);
+
     for (std::size_t k = 0; k < transitions.size(); k++)
     {
       const TransitionType* transition = &transitions[k];
       // Calculate the difference of the theoretical mass and the actually measured mass
-      double left = transition->getProductMZ() - dia_extract_window_ / 2.0;
-      double right = transition->getProductMZ() + dia_extract_window_ / 2.0;
-      bool signalFound = integrateWindow(spectrum, left, right, mz, intensity, dia_centroided_);
+      double mz = mzs[k];
 
       // Continue if no signal was found - we therefore don't make a statement
       // about the mass difference if no signal is present.
-      if (!signalFound)
+      if (intensities[k] <= 0.0)
       {
         continue;
       }
@@ -180,25 +189,20 @@ namespace OpenMS
   void DIAScoring::dia_ms1_isotope_scores(double precursor_mz, SpectrumPtrType spectrum, size_t charge_state, 
                                           double& isotope_corr, double& isotope_overlap, std::string sum_formula)
   {
-    // collect the potential isotopes of this peak
+    // collect the potential isotopes of this peak and the peaks before it
     double max_ratio;
     int nr_occurences;
-    std::vector<double> isotopes_int;
-    for (int iso = 0; iso <= dia_nr_isotopes_; ++iso)
-    {
-      double left  = precursor_mz - dia_extract_window_ / 2.0 + 
-                       iso * C13C12_MASSDIFF_U / static_cast<double>(charge_state);
-      double right = precursor_mz + dia_extract_window_ / 2.0 + 
-                       iso * C13C12_MASSDIFF_U / static_cast<double>(charge_state);
-      double mz, intensity;
-      integrateWindow(spectrum, left, right, mz, intensity, dia_centroided_);
-      isotopes_int.push_back(intensity);
-    }
+    std::vector<double> left, right, intensities, mzs;
+    addIsotopeWindows_(precursor_mz, static_cast<double>(charge_state), left, right);
+    Size nr_isotope_windows = left.size();
+    addPeaksBeforeFirstIsotopeWindows_(precursor_mz, left, right);
+    integrateWindows(spectrum, left, right, intensities, mzs, dia_centroided_);
+    std::vector<double> isotopes_int(intensities.begin(), intensities.begin() + nr_isotope_windows);
 
     // calculate the scores:
     // isotope correlation (forward) and the isotope overlap (backward) scores
     isotope_corr = scoreIsotopePattern_(precursor_mz, isotopes_int, charge_state, sum_formula);
-    largePeaksBeforeFirstIsotope_(spectrum, precursor_mz, isotopes_int[0], nr_occurences, max_ratio);
+    largePeaksBeforeFirstIsotope_(precursor_mz, isotopes_int[0], mzs, intensities, nr_isotope_windows, nr_occurences, max_ratio);
     isotope_overlap = max_ratio;
   }
 
@@ -210,27 +214,38 @@ namespace OpenMS
     yseries_score = 0;
     OPENMS_PRECONDITION(charge > 0, "Charge is a positive integer");
 
-    double mz, intensity, left, right;
     std::vector<double> yseries, bseries;
     OpenMS::DIAHelpers::getBYSeries(sequence, bseries, yseries, charge);
+
+    // integrate the windows of both series at once (b ions first)
+    std::vector<double> left, right, intensities, mzs;
+    left.reserve(bseries.size() + yseries.size());
+    right.reserve(bseries.size() + yseries.size());
     for (Size it = 0; it < bseries.size(); it++)
     {
-      left = bseries[it] - dia_extract_window_ / 2.0;
-      right = bseries[it] + dia_extract_window_ / 2.0;
-      bool signalFound = integrateWindow(spectrum, left, right, mz, intensity, dia_centroided_);
-      double ppmdiff = std::fabs(bseries[it] - mz) * 1000000 / bseries[it];
-      if (signalFound && ppmdiff < dia_byseries_ppm_diff_ && intensity > dia_byseries_intensity_min_)
+      left.push_back(bseries[it] - dia_extract_window_ / 2.0);
+      right.push_back(bseries[it] + dia_extract_window_ / 2.0);
+    }
+    for (Size it = 0; it < yseries.size(); it++)
+    {
+      left.push_back(yseries[it] - dia_extract_window_ / 2.0);
+      right.push_back(yseries[it] + dia_extract_window_ / 2.0);
+    }
+    integrateWindows(spectrum, left, right, intensities, mzs, dia_centroided_);
+
+    for (Size it = 0; it < bseries.size(); it++)
+    {
+      double ppmdiff = std::fabs(bseries[it] - mzs[it]) * 1000000 / bseries[it];
+      if (intensities[it] > 0.0 && ppmdiff < dia_byseries_ppm_diff_ && intensities[it] > dia_byseries_intensity_min_)
       {
         bseries_score++;
       }
     }
     for (Size it = 0; it < yseries.size(); it++)
     {
-      left = yseries[it] - dia_extract_window_ / 2.0;
-      right = yseries[it] + dia_extract_window_ / 2.0;
-      bool signalFound = integrateWindow(spectrum, left, right, mz, intensity, dia_centroided_);
-      double ppmdiff = std::fabs(yseries[it] - mz) * 1000000 / yseries[it];
-      if (signalFound && ppmdiff < dia_byseries_ppm_diff_ && intensity > dia_byseries_intensity_min_)
+      Size idx = bseries.size() + it;
+      double ppmdiff = std::fabs(yseries[it] - mzs[idx]) * 1000000 / yseries[it];
+      if (intensities[idx] > 0.0 && ppmdiff < dia_byseries_ppm_diff_ && intensities[idx] > dia_byseries_intensity_min_)
       {
         yseries_score++;
       }
@@ -250,72 +265,93 @@ namespace OpenMS
   /// computes a vector of relative intensities for each feature (output to intensities)
   void DIAScoring::getFirstIsotopeRelativeIntensities_(
     const std::vector<TransitionType>& transitions,
-    OpenSwath::IMRMFeature* mrmfeature, std::map<std::string, double>& intensities)
+    OpenSwath::IMRMFeature* mrmfeature, std::vector<double>& intensities)
   {
+    intensities.resize(transitions.size());
     for (Size k = 0; k < transitions.size(); k++)
     {
-      std::string native_id = transitions[k].getNativeID();
-      double rel_intensity = mrmfeature->getFeature(native_id)->getIntensity() / mrmfeature->getIntensity();
-      intensities.insert(std::pair<std::string, double>(native_id, rel_intensity));
+      intensities[k] = mrmfeature->getFeature(transitions[k].getNativeID())->getIntensity() / mrmfeature->getIntensity();
+    }
+  }
+
+  void DIAScoring::addIsotopeWindows_(double mono_mz, double charge, std::vector<double>& left, std::vector<double>& right) const
+  {
+    for (int iso = 0; iso <= dia_nr_isotopes_; ++iso)
+    {
+      left.push_back(mono_mz - dia_extract_window_ / 2.0 + iso * C13C12_MASSDIFF_U / charge);
+      right.push_back(mono_mz + dia_extract_window_ / 2.0 + iso * C13C12_MASSDIFF_U / charge);
+    }
+  }
+
+  void DIAScoring::addPeaksBeforeFirstIsotopeWindows_(double mono_mz, std::vector<double>& left, std::vector<double>& right) const
+  {
+    for (int ch = 1; ch <= dia_nr_charges_; ++ch)
+    {
+      left.push_back(mono_mz - dia_extract_window_ / 2.0 - C13C12_MASSDIFF_U / (double) ch);
+      right.push_back(mono_mz + dia_extract_window_ / 2.0 - C13C12_MASSDIFF_U / (double) ch);
     }
   }
 
   void DIAScoring::diaIsotopeScoresSub_(const std::vector<TransitionType>& transitions, SpectrumPtrType spectrum,
-                                          std::map<std::string, double>& intensities, //relative intensities
+                                          const std::vector<double>& intensities, //relative intensities
                                           double& isotope_corr, double& isotope_overlap)
   {
-    std::vector<double> isotopes_int;
-    double max_ratio;
-    int nr_occurences;
+    // If no charge is given, we assume it to be 1
+    std::vector<int> putative_fragment_charges(transitions.size(), 1);
     for (Size k = 0; k < transitions.size(); k++)
     {
-      isotopes_int.clear();
-      String native_id = transitions[k].getNativeID();
-      double rel_intensity = intensities[native_id];
-
-      // If no charge is given, we assume it to be 1
-      int putative_fragment_charge = 1;
       if (transitions[k].fragment_charge > 0)
       {
-        putative_fragment_charge = transitions[k].fragment_charge;
+        putative_fragment_charges[k] = transitions[k].fragment_charge;
       }
+    }
 
-      // collect the potential isotopes of this peak
-      for (int iso = 0; iso <= dia_nr_isotopes_; ++iso)
-      {
-        double left = transitions[k].getProductMZ() - dia_extract_window_ / 2.0 +
-                        iso * C13C12_MASSDIFF_U / static_cast<double>(putative_fragment_charge);
-        double right = transitions[k].getProductMZ() + dia_extract_window_ / 2.0 + 
-                        iso * C13C12_MASSDIFF_U / static_cast<double>(putative_fragment_charge);
-        double mz, intensity;
-        integrateWindow(spectrum, left, right, mz, intensity, dia_centroided_);
-        isotopes_int.push_back(intensity);
-      }
+    // collect the potential isotopes of all peaks and the peaks before them in one pass over the spectrum
+    // (windows of transition k start at window_offsets[k], its peaks before the first isotope at before_offsets[k])
+    std::vector<double> left, right, spectrum_intensities, spectrum_mzs;
+    std::vector<Size> window_offsets(transitions.size()), before_offsets(transitions.size());
+    for (Size k = 0; k < transitions.size(); k++)
+    {
+      window_offsets[k] = left.size();
+      addIsotopeWindows_(transitions[k].getProductMZ(), static_cast<double>(putative_fragment_charges[k]), left, right);
+      before_offsets[k] = left.size();
+      addPeaksBeforeFirstIsotopeWindows_(transitions[k].getProductMZ(), left, right);
+    }
+    integrateWindows(spectrum, left, right, spectrum_intensities, spectrum_mzs, dia_centroided_);
+
+    std::vector<double> isotopes_int;
+    double max_ratio;
+    int nr_occurences;
+    for (Size k = 0; k < transitions.size(); k++)
+    {
+      double rel_intensity = intensities[k];
+      isotopes_int.assign(spectrum_intensities.begin() + window_offsets[k], spectrum_intensities.begin() + before_offsets[k]);
 
       // calculate the scores:
       // isotope correlation (forward) and the isotope overlap (backward) scores
-      double score = scoreIsotopePattern_(transitions[k].getProductMZ(), isotopes_int, putative_fragment_charge);
+      double score = scoreIsotopePattern_(transitions[k].getProductMZ(), isotopes_int, putative_fragment_charges[k]);
       isotope_corr += score * rel_intensity;
-      largePeaksBeforeFirstIsotope_(spectrum, transitions[k].getProductMZ(), isotopes_int[0], nr_occurences, max_ratio);
+      largePeaksBeforeFirstIsotope_(transitions[k].getProductMZ(), isotopes_int[0], spectrum_mzs, spectrum_intensities,
+                                    before_offsets[k], nr_occurences, max_ratio);
       isotope_overlap += nr_occurences * rel_intensity;
     }
   }
 
-  void DIAScoring::largePeaksBeforeFirstIsotope_(SpectrumPtrType spectrum, double mono_mz, double mono_int, int& nr_occurences, double& max_ratio)
+  void DIAScoring::largePeaksBeforeFirstIsotope_(double mono_mz, double mono_int,
+                                                 const std::vector<double>& mzs, const std::vector<double>& intensities, Size offset,
+                                                 int& nr_occurences, double& max_ratio)
   {
-    double mz, intensity;
     nr_occurences = 0;
     max_ratio = 0.0;
 
     for (int ch = 1; ch <= dia_nr_charges_; ++ch)
     {
-      double left = mono_mz - dia_extract_window_ / 2.0 - C13C12_MASSDIFF_U / (double) ch;
-      double right = mono_mz + dia_extract_window_ / 2.0 - C13C12_MASSDIFF_U / (double) ch;
-      bool signalFound = integrateWindow(spectrum, left, right, mz, intensity, dia_centroided_);
+      double mz = mzs[offset + ch - 1];
+      double intensity = intensities[offset + ch - 1];
 
       // Continue if no signal was found - we therefore don't make a statement
       // about the mass difference if no signal is present.
-      if (!signalFound)
+      if (intensity <= 0.0)
       {
         continue;
       }
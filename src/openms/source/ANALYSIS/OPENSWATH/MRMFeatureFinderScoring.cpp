@@ -47,6 +47,13 @@
 #include <boost/range/adaptor/map.hpp>
 #include <boost/foreach.hpp>
 
+#include <new>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define run_identifier "unique_run_identifier"
 
 bool SortDoubleDoublePairFirst(const std::pair<double, double>& left, const std::pair<double, double>& right)
@@ -204,27 +211,175 @@ namespace OpenMS
     //
     // Step 3
     //
-    // Go through all transition groups: first create consensus features, then score them
-    Size progress = 0;
-    startProgress(0, transition_group_map.size(), "picking peaks");
+    // Go through all transition groups: first create consensus features, then score them.
+    // The transition groups are processed in parallel. Each thread uses its
+    // own picker and scoring instances (as well as its own access to the
+    // spectra) and collects its features separately, afterwards the features
+    // are added to the output in the order of the transition groups.
+    std::vector<MRMTransitionGroupType*> transition_groups;
+    transition_groups.reserve(transition_group_map.size());
     for (TransitionGroupMapType::iterator trgroup_it = transition_group_map.begin(); trgroup_it != transition_group_map.end(); ++trgroup_it)
     {
+      transition_groups.push_back(&trgroup_it->second);
+    }
 
-      setProgress(++progress);
-      MRMTransitionGroupType& transition_group = trgroup_it->second;
-      if (transition_group.getChromatograms().size() == 0 || transition_group.getTransitions().size() == 0)
+    Size thread_count = 1;
+#ifdef _OPENMP
+    thread_count = omp_get_max_threads();
+#endif
+    std::vector<FeatureMap> thread_features(thread_count);
+    // thread which processed each transition group and range of its features in thread_features
+    std::vector<Size> group_thread(transition_groups.size(), 0);
+    std::vector<std::pair<Size, Size> > group_features(transition_groups.size(), std::make_pair(0, 0));
+
+    // exceptions must not leave the parallel region: the first one is stored
+    // and rethrown after the region (the exceptions thrown by the picker and
+    // the scoring keep their type, other OpenMS exceptions are rethrown as
+    // BaseException and other standard exceptions as std::runtime_error)
+    int error_kind = 0; // 0: no error, 1: IllegalArgument, 2: NotImplemented, 3: other exception, 4: std::bad_alloc, 5: other std::exception
+    Exception::IllegalArgument illegal_argument_error(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "");
+    Exception::NotImplemented not_implemented_error(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+    Exception::BaseException other_error;
+    std::string std_error_message;
+
+    Size progress = 0;
+    startProgress(0, transition_groups.size(), "picking peaks");
+#ifdef _OPENMP
+#pragma omp parallel num_threads(thread_count)
+#endif
+    {
+#ifdef _OPENMP
+      const int current_thread = omp_get_thread_num();
+#else
+      const int current_thread(0);
+#endif
+      MRMFeatureFinderScoring thread_scoring;
+      thread_scoring.setParameters(param_);
+      thread_scoring.setStrictFlag(strict_);
+      thread_scoring.PeptideRefMap_ = PeptideRefMap_;
+      if (ms1_map_)
       {
-        continue;
+        thread_scoring.setMS1Map(ms1_map_->lightClone());
       }
+      OpenSwath::SpectrumAccessPtr thread_swath_map = swath_map->lightClone();
 
       MRMTransitionGroupPicker trgroup_picker;
       trgroup_picker.setParameters(param_.copy("TransitionGroupPicker:", true));
-      trgroup_picker.pickTransitionGroup(transition_group);
-      scorePeakgroups(trgroup_it->second, trafo, swath_map, output);
+      FeatureMap& features = thread_features[current_thread];
 
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)transition_groups.size(); ++i)
+      {
+        IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
+
+        MRMTransitionGroupType& transition_group = *transition_groups[i];
+        if (transition_group.getChromatograms().size() == 0 || transition_group.getTransitions().size() == 0)
+        {
+          continue;
+        }
+
+        group_thread[i] = current_thread;
+        group_features[i].first = features.size();
+        try
+        {
+          trgroup_picker.pickTransitionGroup(transition_group);
+          thread_scoring.scorePeakgroups(transition_group, trafo, thread_swath_map, features);
+        }
+        catch (Exception::IllegalArgument& e)
+        {
+#ifdef _OPENMP
+#pragma omp critical (MRMFeatureFinderScoring_error)
+#endif
+          if (error_kind == 0)
+          {
+            illegal_argument_error = e;
+            error_kind = 1;
+          }
+        }
+        catch (Exception::NotImplemented& e)
+        {
+#ifdef _OPENMP
+#pragma omp critical (MRMFeatureFinderScoring_error)
+#endif
+          if (error_kind == 0)
+          {
+            not_implemented_error = e;
+            error_kind = 2;
+          }
+        }
+        catch (Exception::BaseException& e)
+        {
+#ifdef _OPENMP
+#pragma omp critical (MRMFeatureFinderScoring_error)
+#endif
+          if (error_kind == 0)
+          {
+            other_error = e;
+            error_kind = 3;
+          }
+        }
+        catch (std::bad_alloc&)
+        {
+#ifdef _OPENMP
+#pragma omp critical (MRMFeatureFinderScoring_error)
+#endif
+          if (error_kind == 0)
+          {
+            error_kind = 4;
+          }
+        }
+        catch (std::exception& e)
+        {
+#ifdef _OPENMP
+#pragma omp critical (MRMFeatureFinderScoring_error)
+#endif
+          if (error_kind == 0)
+          {
+            std_error_message = e.what();
+            error_kind = 5;
+          }
+        }
+        group_features[i].second = features.size();
+      }
     }
     endProgress();
 
+    if (error_kind == 1)
+    {
+      throw illegal_argument_error;
+    }
+    if (error_kind == 2)
+    {
+      throw not_implemented_error;
+    }
+    if (error_kind == 3)
+    {
+      throw other_error;
+    }
+    if (error_kind == 4)
+    {
+      throw std::bad_alloc();
+    }
+    if (error_kind == 5)
+    {
+      throw std::runtime_error(std_error_message);
+    }
+
+    for (Size i = 0; i < transition_groups.size(); ++i)
+    {
+      const FeatureMap& features = thread_features[group_thread[i]];
+      for (Size j = group_features[i].first; j < group_features[i].second; ++j)
+      {
+        output.push_back(features[j]);
+      }
+    }
+
     //output.sortByPosition(); // if the exact same order is needed
     return;
   }
@@ -395,9 +550,6 @@ namespace OpenMS
     newtr.invert();
     expected_rt = newtr.apply(expected_rt);
 
-    OpenSwathScoring scorer;
-    scorer.initialize(rt_normalization_factor_, add_up_spectra_, spacing_for_spectra_resampling_, su_);
-
     size_t feature_idx = 0;
     // Go through all peak groups (found MRM features) and score them
     for (std::vector<MRMFeature>::iterator mrmfeature = transition_group_detection.getFeaturesMuteable().begin();
@@ -438,20 +590,20 @@ namespace OpenMS
       }
 
       OpenSwath_Scores scores;
-      scorer.calculateChromatographicScores(imrmfeature, native_ids_detection, normalized_library_intensity,
+      scorer_.calculateChromatographicScores(imrmfeature, native_ids_detection, normalized_library_intensity,
                                             signal_noise_estimators, scores);
 
       double normalized_experimental_rt = trafo.apply(imrmfeature->getRT());
-      scorer.calculateLibraryScores(imrmfeature, transition_group_detection.getTransitions(), *pep, normalized_experimental_rt, scores);
+      scorer_.calculateLibraryScores(imrmfeature, transition_group_detection.getTransitions(), *pep, normalized_experimental_rt, scores);
       if (swath_map->getNrSpectra() > 0 && su_.use_dia_scores_)
       {
-        scorer.calculateDIAScores(imrmfeature, transition_group_detection.getTransitions(),
+        scorer_.calculateDIAScores(imrmfeature, transition_group_detection.getTransitions(),
                                   swath_map, ms1_map_, diascoring_, *pep, scores);
       }
 
       if (su_.use_uis_scores && transition_group_identification.getTransitions().size() > 0)
       {
-        OpenSwath_Scores idscores = scoreIdentification_(transition_group_identification, scorer, feature_idx, native_ids_detection, sn_win_len_, sn_bin_count_, write_log_messages, swath_map);
+        OpenSwath_Scores idscores = scoreIdentification_(transition_group_identification, scorer_, feature_idx, native_ids_detection, sn_win_len_, sn_bin_count_, write_log_messages, swath_map);
 
         mrmfeature->setMetaValue("id_target_transition_names", idscores.ind_transition_names);
         mrmfeature->addScore("id_target_num_transitions", idscores.ind_num_transitions);
@@ -466,7 +618,7 @@ namespace OpenMS
 
       if (su_.use_uis_scores && transition_group_identification_decoy.getTransitions().size() > 0)
       {
-        OpenSwath_Scores idscores = scoreIdentification_(transition_group_identification_decoy, scorer, feature_idx, native_ids_detection, sn_win_len_, sn_bin_count_, write_log_messages, swath_map);
+        OpenSwath_Scores idscores = scoreIdentification_(transition_group_identification_decoy, scorer_, feature_idx, native_ids_detection, sn_win_len_, sn_bin_count_, write_log_messages, swath_map);
 
         mrmfeature->setMetaValue("id_decoy_transition_names", idscores.ind_transition_names);
         mrmfeature->addScore("id_decoy_num_transitions", idscores.ind_num_transitions);
@@ -666,6 +818,10 @@ namespace OpenMS
     su_.use_ms1_correlation      = param_.getValue("Scores:use_ms1_correlation").toBool();
     su_.use_ms1_fullscan         = param_.getValue("Scores:use_ms1_fullscan").toBool();
     su_.use_uis_scores           = param_.getValue("Scores:use_uis_scores").toBool();
+
+    // the scorer is kept between calls to scorePeakgroups to reuse its cache
+    // of (added) spectra, thus it is only initialized when the parameters change
+    scorer_.initialize(rt_normalization_factor_, add_up_spectra_, spacing_for_spectra_resampling_, su_);
   }
 
   void MRMFeatureFinderScoring::mapExperimentToTransitionList(OpenSwath::SpectrumAccessPtr input,
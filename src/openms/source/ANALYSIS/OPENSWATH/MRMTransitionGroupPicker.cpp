@@ -90,6 +90,7 @@ namespace OpenMS
     compute_peak_quality_ = (bool)param_.getValue("compute_peak_quality").toBool();
     min_qual_ = (double)param_.getValue("minimal_quality");
     min_peak_width_ = (double)param_.getValue("min_peak_width");
+    picker_.setParameters(param_.copy("PeakPickerMRM:", true));
   }
 
   double MRMTransitionGroupPicker::calculateBgEstimation_(const RichPeakChromatogram& chromatogram, double best_left, double best_right)
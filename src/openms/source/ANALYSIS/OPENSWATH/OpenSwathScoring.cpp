@@ -49,7 +49,10 @@ namespace OpenMS
   OpenSwathScoring::OpenSwathScoring() :
     rt_normalization_factor_(1.0),
     add_up_spectra_(1),
-    spacing_for_spectra_resampling_(0.005)
+    spacing_for_spectra_resampling_(0.005),
+    added_spectra_cache_(),
+    added_spectra_map_(),
+    added_spectra_cache_size_(32)
   {
   }
 
@@ -62,6 +65,13 @@ namespace OpenMS
     int add_up_spectra, double spacing_for_spectra_resampling,
     OpenSwath_Scores_Usage & su)
   {
+    // the cached spectra were added with the previous settings
+    if (add_up_spectra != this->add_up_spectra_ ||
+        spacing_for_spectra_resampling != this->spacing_for_spectra_resampling_)
+    {
+      added_spectra_cache_.clear();
+      added_spectra_map_.reset();
+    }
     this->rt_normalization_factor_ = rt_normalization_factor;
     this->add_up_spectra_ = add_up_spectra;
     this->spacing_for_spectra_resampling_ = spacing_for_spectra_resampling;
@@ -303,10 +313,32 @@ namespace OpenMS
       closest_idx--;
     }
 
+    // the cache only holds spectra of one map: start over if a different
+    // map is requested (or the cached one no longer exists)
+    if (added_spectra_map_.lock() != swath_map)
+    {
+      added_spectra_cache_.clear();
+      added_spectra_map_ = swath_map;
+    }
+
+    // check whether we have computed this spectrum recently
+    for (std::list<AddedSpectrum_>::iterator it = added_spectra_cache_.begin(); it != added_spectra_cache_.end(); ++it)
+    {
+      if (it->closest_idx == closest_idx && it->nr_spectra_to_add == nr_spectra_to_add)
+      {
+        // move to the front (most recently used)
+        added_spectra_cache_.splice(added_spectra_cache_.begin(), added_spectra_cache_, it);
+        return added_spectra_cache_.front().spectrum;
+      }
+    }
+
+    AddedSpectrum_ entry;
+    entry.closest_idx = closest_idx;
+    entry.nr_spectra_to_add = nr_spectra_to_add;
+
     if (nr_spectra_to_add == 1)
     {
-      OpenSwath::SpectrumPtr spectrum_ = swath_map->getSpectrumById(closest_idx);
-      return spectrum_;
+      entry.spectrum = swath_map->getSpectrumById(closest_idx);
     }
     else
     {
@@ -324,9 +356,16 @@ namespace OpenMS
           all_spectra.push_back(swath_map->getSpectrumById(closest_idx + i));
         }
       }
-      OpenSwath::SpectrumPtr spectrum_ = SpectrumAddition::addUpSpectra(all_spectra, spacing_for_spectra_resampling_, true);
-      return spectrum_;
+      entry.spectrum = SpectrumAddition::addUpSpectra(all_spectra, spacing_for_spectra_resampling_, true);
+    }
+
+    // add to the cache, remove the least recently used spectrum if necessary
+    added_spectra_cache_.push_front(entry);
+    if (added_spectra_cache_.size() > added_spectra_cache_size_)
+    {
+      added_spectra_cache_.pop_back();
     }
+    return entry.spectrum;
   }
 
 }
@@ -34,88 +34,123 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAddition.h>
 
-#include <OpenMS/KERNEL/MSExperiment.h>
-#include <OpenMS/KERNEL/MSSpectrum.h>
-#include <OpenMS/FILTERING/TRANSFORMERS/LinearResamplerAlign.h>
-#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <cmath>
 
 namespace OpenMS
 {
 
-    OpenSwath::SpectrumPtr SpectrumAddition::addUpSpectra(std::vector<OpenSwath::SpectrumPtr> all_spectra,
+    OpenSwath::SpectrumPtr SpectrumAddition::addUpSpectra(const std::vector<OpenSwath::SpectrumPtr> & all_spectra,
         double sampling_rate, double filter_zeros)
     {
-      if (all_spectra.size() == 0)
-      {
-        OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
-        return sptr;
-      }
-
-      typedef MSSpectrum<Peak1D> SpectrumT;
-      LinearResamplerAlign lresampler;
-
       // find global min and max -> use as start/endpoints for resampling
-      double min = all_spectra[0]->getMZArray()->data[0];
-      double max = all_spectra[0]->getMZArray()->data.back();
+      bool found_data = false;
+      double min = 0, max = 0;
       for (Size i = 0; i < all_spectra.size(); i++)
       {
-        if (all_spectra[i]->getMZArray()->data[0] < min)
+        const std::vector<double> & mz = all_spectra[i]->getMZArray()->data;
+        if (mz.empty()) continue;
+
+        if (!found_data || mz[0] < min)
         {
-          min = all_spectra[i]->getMZArray()->data[0]; 
+          min = mz[0];
         }
-        if (all_spectra[i]->getMZArray()->data.back() > max)
+        if (!found_data || mz.back() > max)
         {
-          max = all_spectra[i]->getMZArray()->data.back(); 
+          max = mz.back();
         }
+        found_data = true;
       }
 
-      // generate the resampled peaks at positions origin+i*spacing_
-      int number_resampled_points = (max - min) / sampling_rate + 1;
-      SpectrumT resampled_peak_container;
-      resampled_peak_container.resize(number_resampled_points);
-      SpectrumT::iterator it = resampled_peak_container.begin();
-      for (int i = 0; i < number_resampled_points; ++i)
+      if (!found_data)
       {
-        it->setMZ(min + i * sampling_rate);
-        it->setIntensity(0);
-        ++it;
+        OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
+        return sptr;
       }
 
-      // resample all spectra and add to master spectrum
-      SpectrumT master_spectrum = resampled_peak_container;
+      // the resampled peaks are at positions min + i * sampling_rate, all
+      // spectra are resampled directly into a single intensity buffer
+      const int number_resampled_points = (max - min) / sampling_rate + 1;
+      std::vector<double> master_intensity(number_resampled_points, 0.0);
       for (Size curr_sp = 0; curr_sp < all_spectra.size(); curr_sp++)
       {
-        SpectrumT input_spectrum;
-        SpectrumT output_spectrum = resampled_peak_container;
-
-        // convert input spectrum to OpenMS, then resample
-        OpenSwathDataAccessHelper::convertToOpenMSSpectrum(all_spectra[curr_sp], input_spectrum);
-        lresampler.raster(input_spectrum.begin(), input_spectrum.end(), output_spectrum.begin(), output_spectrum.end());
-
-        // add to master spectrum
-        for (Size i = 0; i < output_spectrum.size(); ++i)
-        {
-          master_spectrum[i].setIntensity(master_spectrum[i].getIntensity() + output_spectrum[i].getIntensity());
-        }
+        rasterAdd_(all_spectra[curr_sp]->getMZArray()->data, all_spectra[curr_sp]->getIntensityArray()->data,
+                   min, sampling_rate, master_intensity);
       }
 
+      OpenSwath::BinaryDataArrayPtr mz_array(new OpenSwath::BinaryDataArray);
+      OpenSwath::BinaryDataArrayPtr intensity_array(new OpenSwath::BinaryDataArray);
       if (!filter_zeros)
       {
-        OpenSwath::SpectrumPtr sptr = OpenSwathDataAccessHelper::convertToSpectrumPtr(master_spectrum);
-        return sptr;
+        mz_array->data.resize(number_resampled_points);
+        for (int i = 0; i < number_resampled_points; ++i)
+        {
+          mz_array->data[i] = min + i * sampling_rate;
+        }
+        intensity_array->data.swap(master_intensity);
       }
       else
       {
-        SpectrumT master_spectrum_filtered;
-        for (Size i = 0; i < master_spectrum.size(); ++i)
+        for (int i = 0; i < number_resampled_points; ++i)
         {
-          if (master_spectrum[i].getIntensity() > 0)
+          if (master_intensity[i] > 0)
           {
-            master_spectrum_filtered.push_back(master_spectrum[i]);
+            mz_array->data.push_back(min + i * sampling_rate);
+            intensity_array->data.push_back(master_intensity[i]);
           }
         }
-        OpenSwath::SpectrumPtr sptr = OpenSwathDataAccessHelper::convertToSpectrumPtr(master_spectrum_filtered);
-        return sptr;
+      }
+
+      OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
+      sptr->setMZArray(mz_array);
+      sptr->setIntensityArray(intensity_array);
+      return sptr;
+    }
+
+    void SpectrumAddition::rasterAdd_(const std::vector<double> & mz, const std::vector<double> & intensity,
+        double start_mz, double sampling_rate, std::vector<double> & resampled_intensity)
+    {
+      // This is the algorithm of LinearResamplerAlign::raster, working on
+      // the raw arrays and an implicit raster (no temporary spectra).
+      const Size raw_size = mz.size();
+      const Size resampled_size = resampled_intensity.size();
+      if (raw_size == 0 || resampled_size == 0) return;
+
+      Size raw_idx = 0;
+      Size res_idx = 0;
+
+      // intensity of raw points left of the raster is added to the first point
+      while (raw_idx < raw_size && mz[raw_idx] < start_mz)
+      {
+        resampled_intensity[0] += intensity[raw_idx];
+        raw_idx++;
+      }
+
+      while (raw_idx < raw_size)
+      {
+        // advance the raster position until our raw point is between two raster points
+        while (res_idx < resampled_size && start_mz + res_idx * sampling_rate < mz[raw_idx]) {res_idx++;}
+        if (res_idx != 0) {res_idx--;}
+
+        // if we have the last datapoint we break
+        if (res_idx + 1 == resampled_size) {break;}
+
+        const double dist_left = std::fabs(mz[raw_idx] - (start_mz + res_idx * sampling_rate));
+        const double dist_right = std::fabs(mz[raw_idx] - (start_mz + (res_idx + 1) * sampling_rate));
+
+        // distribute the intensity of the raw point according to the distance to both raster points
+        resampled_intensity[res_idx] += intensity[raw_idx] * dist_right / (dist_left + dist_right);
+        resampled_intensity[res_idx + 1] += intensity[raw_idx] * dist_left / (dist_left + dist_right);
+
+        raw_idx++;
+      }
+
+      // add the final intensity to the right
+      while (raw_idx < raw_size)
+      {
+        resampled_intensity[res_idx] += intensity[raw_idx];
+        raw_idx++;
       }
     }
 }
@@ -0,0 +1,508 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinaryFile.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <map>
+
+namespace OpenMS
+{
+
+  namespace
+  {
+    /// Magic string at the beginning of each file (distinct from the magic number of cached mzML files)
+    const char TRANSITION_BINARY_FILE_IDENTIFIER[8] = {'O', 'S', 'W', '-', 'L', 'I', 'B', '\n'};
+    /// Written in native byte order, used to detect files written on machines with a different byte order
+    const UInt32 TRANSITION_BINARY_FILE_BYTE_ORDER = 0x01020304;
+    const Int32 TRANSITION_BINARY_FILE_VERSION = 1;
+
+    /// Writes a column of plain values (preceded by the number of values)
+    template <typename T>
+    void writeColumn(std::ofstream & ofs, const std::vector<T> & column)
+    {
+      UInt64 size = column.size();
+      ofs.write((const char *)&size, sizeof(size));
+      if (!column.empty())
+      {
+        ofs.write((const char *)&column[0], sizeof(T) * column.size());
+      }
+    }
+
+    /// Writes a column of strings (as offsets into the concatenated characters, followed by the characters)
+    void writeStringColumn(std::ofstream & ofs, const std::vector<const std::string *> & column)
+    {
+      std::vector<UInt64> offsets(column.size() + 1, 0);
+      for (Size i = 0; i < column.size(); ++i)
+      {
+        offsets[i + 1] = offsets[i] + column[i]->size();
+      }
+      writeColumn(ofs, offsets);
+      for (Size i = 0; i < column.size(); ++i)
+      {
+        ofs.write(column[i]->data(), column[i]->size());
+      }
+    }
+
+    /// Reads the columns written by writeColumn / writeStringColumn from a memory block
+    class ColumnReader
+    {
+public:
+      ColumnReader(const char * data, Size size, const String & filename) :
+        pos_(data),
+        end_(data + size),
+        filename_(filename)
+      {
+      }
+
+      /// Returns the next @p size bytes
+      const char * readBytes(Size size)
+      {
+        if (size > (Size)(end_ - pos_))
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Unexpected end of file, the binary assay library is truncated.", filename_);
+        }
+        const char * result = pos_;
+        pos_ += size;
+        return result;
+      }
+
+      /// Checks that @p nr_entries entries of @p entry_size bytes fit into the rest of the file (before allocating memory for them)
+      void checkEntries(UInt64 nr_entries, Size entry_size)
+      {
+        if (nr_entries > (UInt64)(end_ - pos_) / entry_size)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Invalid number of entries (" + String(nr_entries) + "), the binary assay library is corrupt or truncated.", filename_);
+        }
+      }
+
+      /// Reads a column of plain values, which needs to have @p expected_size entries
+      template <typename T>
+      void readColumn(std::vector<T> & column, UInt64 expected_size)
+      {
+        UInt64 size;
+        std::memcpy(&size, readBytes(sizeof(size)), sizeof(size));
+        if (size != expected_size)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Column has " + String(size) + " instead of " + String(expected_size) + " entries.", filename_);
+        }
+        checkEntries(size, sizeof(T));
+        column.resize(size);
+        if (size > 0)
+        {
+          std::memcpy(&column[0], readBytes(sizeof(T) * size), sizeof(T) * size);
+        }
+      }
+
+      /// Reads a column of strings, string @em i consists of the characters [offsets[i], offsets[i+1])
+      const char * readStringColumn(std::vector<UInt64> & offsets, UInt64 expected_size)
+      {
+        checkEntries(expected_size, sizeof(UInt64)); // also prevents an overflow of expected_size + 1
+        readColumn(offsets, expected_size + 1);
+        for (Size i = 0; i < expected_size; ++i)
+        {
+          if (offsets[i] > offsets[i + 1])
+          {
+            throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              "Invalid string offsets in binary assay library.", filename_);
+          }
+        }
+        return readBytes(offsets.back());
+      }
+
+private:
+      const char * pos_;
+      const char * end_;
+      String filename_;
+    };
+
+    /// Assigns string @p i of a string column
+    inline void assignString(std::string & target, const char * chars, const std::vector<UInt64> & offsets, Size i)
+    {
+      target.assign(chars + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+  }
+
+  TransitionBinaryFile::TransitionBinaryFile() :
+    ProgressLogger()
+  {
+  }
+
+  TransitionBinaryFile::~TransitionBinaryFile()
+  {
+  }
+
+  void TransitionBinaryFile::store(const String & filename, const OpenSwath::LightTargetedExperiment & exp)
+  {
+    std::ofstream ofs(filename.c_str(), std::ios::binary);
+    if (ofs.fail())
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    const std::vector<OpenSwath::LightProtein> & proteins = exp.proteins;
+    const std::vector<OpenSwath::LightCompound> & compounds = exp.compounds;
+    const std::vector<OpenSwath::LightTransition> & transitions = exp.transitions;
+
+    startProgress(0, 3, "storing binary assay library");
+
+    ofs.write(TRANSITION_BINARY_FILE_IDENTIFIER, sizeof(TRANSITION_BINARY_FILE_IDENTIFIER));
+    ofs.write((const char *)&TRANSITION_BINARY_FILE_BYTE_ORDER, sizeof(TRANSITION_BINARY_FILE_BYTE_ORDER));
+    ofs.write((const char *)&TRANSITION_BINARY_FILE_VERSION, sizeof(TRANSITION_BINARY_FILE_VERSION));
+    UInt64 sizes[3] = { proteins.size(), compounds.size(), transitions.size() };
+    ofs.write((const char *)sizes, sizeof(sizes));
+
+    // proteins
+    {
+      std::vector<const std::string *> id(proteins.size()), sequence(proteins.size());
+      for (Size i = 0; i < proteins.size(); ++i)
+      {
+        id[i] = &proteins[i].id;
+        sequence[i] = &proteins[i].sequence;
+      }
+      writeStringColumn(ofs, id);
+      writeStringColumn(ofs, sequence);
+    }
+    setProgress(1);
+
+    // compounds
+    std::map<std::string, Int64> compound_index;
+    {
+      std::vector<double> rt(compounds.size());
+      std::vector<Int32> charge(compounds.size());
+      std::vector<const std::string *> sequence(compounds.size()), peptide_group_label(compounds.size()), id(compounds.size()),
+                                       sum_formula(compounds.size()), compound_name(compounds.size());
+      std::vector<UInt64> protein_ref_offsets(compounds.size() + 1, 0), modification_offsets(compounds.size() + 1, 0);
+      std::vector<const std::string *> protein_refs, unimod_ids;
+      std::vector<Int32> locations;
+      for (Size i = 0; i < compounds.size(); ++i)
+      {
+        const OpenSwath::LightCompound & compound = compounds[i];
+        rt[i] = compound.rt;
+        charge[i] = compound.charge;
+        sequence[i] = &compound.sequence;
+        peptide_group_label[i] = &compound.peptide_group_label;
+        id[i] = &compound.id;
+        sum_formula[i] = &compound.sum_formula;
+        compound_name[i] = &compound.compound_name;
+        for (Size j = 0; j < compound.protein_refs.size(); ++j)
+        {
+          protein_refs.push_back(&compound.protein_refs[j]);
+        }
+        protein_ref_offsets[i + 1] = protein_refs.size();
+        for (Size j = 0; j < compound.modifications.size(); ++j)
+        {
+          locations.push_back(compound.modifications[j].location);
+          unimod_ids.push_back(&compound.modifications[j].unimod_id);
+        }
+        modification_offsets[i + 1] = locations.size();
+        compound_index.insert(std::make_pair(compound.id, (Int64)i));
+      }
+      writeColumn(ofs, rt);
+      writeColumn(ofs, charge);
+      writeStringColumn(ofs, sequence);
+      writeStringColumn(ofs, peptide_group_label);
+      writeStringColumn(ofs, id);
+      writeStringColumn(ofs, sum_formula);
+      writeStringColumn(ofs, compound_name);
+      writeColumn(ofs, protein_ref_offsets);
+      writeStringColumn(ofs, protein_refs);
+      writeColumn(ofs, modification_offsets);
+      writeColumn(ofs, locations);
+      writeStringColumn(ofs, unimod_ids);
+    }
+    setProgress(2);
+
+    // transitions (the compound is stored as index, only references to
+    // unknown compounds are stored as string)
+    {
+      const std::string empty;
+      std::vector<const std::string *> transition_name(transitions.size()), unresolved_peptide_ref(transitions.size());
+      std::vector<Int64> compound(transitions.size());
+      std::vector<double> library_intensity(transitions.size()), product_mz(transitions.size()), precursor_mz(transitions.size());
+      std::vector<Int32> fragment_charge(transitions.size());
+      std::vector<unsigned char> decoy(transitions.size()), detecting(transitions.size()),
+                                 quantifying(transitions.size()), identifying(transitions.size());
+      for (Size i = 0; i < transitions.size(); ++i)
+      {
+        const OpenSwath::LightTransition & transition = transitions[i];
+        transition_name[i] = &transition.transition_name;
+        std::map<std::string, Int64>::const_iterator c_it = compound_index.find(transition.peptide_ref);
+        if (c_it != compound_index.end())
+        {
+          compound[i] = c_it->second;
+          unresolved_peptide_ref[i] = &empty;
+        }
+        else
+        {
+          compound[i] = -1;
+          unresolved_peptide_ref[i] = &transition.peptide_ref;
+        }
+        library_intensity[i] = transition.library_intensity;
+        product_mz[i] = transition.product_mz;
+        precursor_mz[i] = transition.precursor_mz;
+        fragment_charge[i] = transition.fragment_charge;
+        decoy[i] = transition.decoy;
+        detecting[i] = transition.detecting_transition;
+        quantifying[i] = transition.quantifying_transition;
+        identifying[i] = transition.identifying_transition;
+      }
+      writeStringColumn(ofs, transition_name);
+      writeColumn(ofs, compound);
+      writeStringColumn(ofs, unresolved_peptide_ref);
+      writeColumn(ofs, library_intensity);
+      writeColumn(ofs, product_mz);
+      writeColumn(ofs, precursor_mz);
+      writeColumn(ofs, fragment_charge);
+      writeColumn(ofs, decoy);
+      writeColumn(ofs, detecting);
+      writeColumn(ofs, quantifying);
+      writeColumn(ofs, identifying);
+    }
+    setProgress(3);
+
+    ofs.close();
+    if (ofs.fail())
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    endProgress();
+  }
+
+  void TransitionBinaryFile::load(const String & filename, OpenSwath::LightTargetedExperiment & exp)
+  {
+    boost::iostreams::mapped_file_source file;
+    try
+    {
+      file.open(filename);
+    }
+    catch (std::exception & /*e*/)
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    if (!file.is_open())
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    ColumnReader reader(file.data(), file.size(), filename);
+
+    if (std::memcmp(reader.readBytes(sizeof(TRANSITION_BINARY_FILE_IDENTIFIER)), TRANSITION_BINARY_FILE_IDENTIFIER, sizeof(TRANSITION_BINARY_FILE_IDENTIFIER)) != 0)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "File might not be a binary assay library (wrong file magic number). Aborting!", filename);
+    }
+    UInt32 byte_order;
+    std::memcpy(&byte_order, reader.readBytes(sizeof(byte_order)), sizeof(byte_order));
+    if (byte_order != TRANSITION_BINARY_FILE_BYTE_ORDER)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Binary assay library was written on a machine with a different byte order. Aborting!", filename);
+    }
+    Int32 version;
+    std::memcpy(&version, reader.readBytes(sizeof(version)), sizeof(version));
+    if (version != TRANSITION_BINARY_FILE_VERSION)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Unsupported version " + String(version) + " of the binary assay library format. Aborting!", filename);
+    }
+    UInt64 sizes[3];
+    std::memcpy(sizes, reader.readBytes(sizeof(sizes)), sizeof(sizes));
+    const UInt64 nr_proteins = sizes[0], nr_compounds = sizes[1], nr_transitions = sizes[2];
+    // each protein, compound and transition has at least one string offset in
+    // the file, check this before allocating memory for them
+    reader.checkEntries(nr_proteins, sizeof(UInt64));
+    reader.checkEntries(nr_compounds, sizeof(UInt64));
+    reader.checkEntries(nr_transitions, sizeof(UInt64));
+
+    // start from a fresh object (this also resets the compound reference map)
+    exp = OpenSwath::LightTargetedExperiment();
+
+    startProgress(0, 3, "loading binary assay library");
+
+    std::vector<UInt64> offsets;
+    const char * chars;
+
+    // proteins
+    {
+      std::vector<OpenSwath::LightProtein> & proteins = exp.proteins;
+      proteins.resize(nr_proteins);
+      chars = reader.readStringColumn(offsets, nr_proteins);
+      for (Size i = 0; i < nr_proteins; ++i) assignString(proteins[i].id, chars, offsets, i);
+      chars = reader.readStringColumn(offsets, nr_proteins);
+      for (Size i = 0; i < nr_proteins; ++i) assignString(proteins[i].sequence, chars, offsets, i);
+    }
+    setProgress(1);
+
+    // compounds
+    {
+      std::vector<OpenSwath::LightCompound> & compounds = exp.compounds;
+      compounds.resize(nr_compounds);
+
+      std::vector<double> rt;
+      reader.readColumn(rt, nr_compounds);
+      std::vector<Int32> charge;
+      reader.readColumn(charge, nr_compounds);
+      for (Size i = 0; i < nr_compounds; ++i)
+      {
+        compounds[i].rt = rt[i];
+        compounds[i].charge = charge[i];
+      }
+
+      chars = reader.readStringColumn(offsets, nr_compounds);
+      for (Size i = 0; i < nr_compounds; ++i) assignString(compounds[i].sequence, chars, offsets, i);
+      chars = reader.readStringColumn(offsets, nr_compounds);
+      for (Size i = 0; i < nr_compounds; ++i) assignString(compounds[i].peptide_group_label, chars, offsets, i);
+      chars = reader.readStringColumn(offsets, nr_compounds);
+      for (Size i = 0; i < nr_compounds; ++i) assignString(compounds[i].id, chars, offsets, i);
+      chars = reader.readStringColumn(offsets, nr_compounds);
+      for (Size i = 0; i < nr_compounds; ++i) assignString(compounds[i].sum_formula, chars, offsets, i);
+      chars = reader.readStringColumn(offsets, nr_compounds);
+      for (Size i = 0; i < nr_compounds; ++i) assignString(compounds[i].compound_name, chars, offsets, i);
+
+      // protein references, stored as ranges per compound
+      std::vector<UInt64> ranges;
+      reader.readColumn(ranges, nr_compounds + 1);
+      chars = reader.readStringColumn(offsets, ranges.back());
+      for (Size i = 0; i < nr_compounds; ++i)
+      {
+        if (ranges[i] > ranges[i + 1] || ranges[i + 1] > ranges.back())
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid protein references.", filename);
+        }
+        compounds[i].protein_refs.resize(ranges[i + 1] - ranges[i]);
+        for (Size j = ranges[i]; j < ranges[i + 1]; ++j)
+        {
+          assignString(compounds[i].protein_refs[j - ranges[i]], chars, offsets, j);
+        }
+      }
+
+      // modifications, stored as ranges per compound
+      reader.readColumn(ranges, nr_compounds + 1);
+      std::vector<Int32> locations;
+      reader.readColumn(locations, ranges.back());
+      chars = reader.readStringColumn(offsets, ranges.back());
+      for (Size i = 0; i < nr_compounds; ++i)
+      {
+        if (ranges[i] > ranges[i + 1] || ranges[i + 1] > ranges.back())
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid modifications.", filename);
+        }
+        compounds[i].modifications.resize(ranges[i + 1] - ranges[i]);
+        for (Size j = ranges[i]; j < ranges[i + 1]; ++j)
+        {
+          OpenSwath::LightModification & modification = compounds[i].modifications[j - ranges[i]];
+          modification.location = locations[j];
+          assignString(modification.unimod_id, chars, offsets, j);
+        }
+      }
+    }
+    setProgress(2);
+
+    // transitions
+    {
+      std::vector<OpenSwath::LightTransition> & transitions = exp.transitions;
+      transitions.resize(nr_transitions);
+
+      chars = reader.readStringColumn(offsets, nr_transitions);
+      for (Size i = 0; i < nr_transitions; ++i) assignString(transitions[i].transition_name, chars, offsets, i);
+
+      std::vector<Int64> compound;
+      reader.readColumn(compound, nr_transitions);
+      chars = reader.readStringColumn(offsets, nr_transitions);
+      for (Size i = 0; i < nr_transitions; ++i)
+      {
+        if (compound[i] < 0)
+        {
+          assignString(transitions[i].peptide_ref, chars, offsets, i);
+        }
+        else if ((UInt64)compound[i] < nr_compounds)
+        {
+          transitions[i].peptide_ref = exp.compounds[compound[i]].id;
+        }
+        else
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid compound index.", filename);
+        }
+      }
+
+      std::vector<double> values;
+      reader.readColumn(values, nr_transitions);
+      for (Size i = 0; i < nr_transitions; ++i) transitions[i].library_intensity = values[i];
+      reader.readColumn(values, nr_transitions);
+      for (Size i = 0; i < nr_transitions; ++i) transitions[i].product_mz = values[i];
+      reader.readColumn(values, nr_transitions);
+      for (Size i = 0; i < nr_transitions; ++i) transitions[i].precursor_mz = values[i];
+
+      std::vector<Int32> fragment_charge;
+      reader.readColumn(fragment_charge, nr_transitions);
+      for (Size i = 0; i < nr_transitions; ++i) transitions[i].fragment_charge = fragment_charge[i];
+
+      std::vector<unsigned char> flags;
+      reader.readColumn(flags, nr_transitions);
+      for (Size i = 0; i < nr_transitions; ++i) transitions[i].decoy = flags[i] != 0;
+      reader.readColumn(flags, nr_transitions);
+      for (Size i = 0; i < nr_transitions; ++i) transitions[i].detecting_transition = flags[i] != 0;
+      reader.readColumn(flags, nr_transitions);
+      for (Size i = 0; i < nr_transitions; ++i) transitions[i].quantifying_transition = flags[i] != 0;
+      reader.readColumn(flags, nr_transitions);
+      for (Size i = 0; i < nr_transitions; ++i) transitions[i].identifying_transition = flags[i] != 0;
+    }
+    setProgress(3);
+
+    file.close();
+    endProgress();
+  }
+
+  bool TransitionBinaryFile::isBinaryLibrary(const String & filename)
+  {
+    std::ifstream ifs(filename.c_str(), std::ios::binary);
+    char file_identifier[sizeof(TRANSITION_BINARY_FILE_IDENTIFIER)];
+    UInt32 byte_order = 0;
+    ifs.read(file_identifier, sizeof(file_identifier));
+    ifs.read((char *)&byte_order, sizeof(byte_order));
+    return ifs.good() &&
+           std::memcmp(file_identifier, TRANSITION_BINARY_FILE_IDENTIFIER, sizeof(file_identifier)) == 0 &&
+           byte_order == TRANSITION_BINARY_FILE_BYTE_ORDER;
+  }
+
+}
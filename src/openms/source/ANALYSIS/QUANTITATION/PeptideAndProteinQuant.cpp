@@ -116,16 +116,11 @@ namespace OpenMS
 
 
   void PeptideAndProteinQuant::quantifyFeature_(const FeatureHandle& feature,
-                                                const PeptideHit& hit)
+                                                SampleAbundances& abundances)
   {
-    if (hit == PeptideHit())
-    {
-      return; // annotation for the feature is ambiguous or missing
-    }
     stats_.quant_features++;
-    const AASequence& seq = hit.getSequence();
-    pep_quant_[seq].abundances[hit.getCharge()][feature.getMapIndex()] +=
-      feature.getIntensity(); // new map element is initialized with 0
+    abundances[feature.getMapIndex()] += feature.getIntensity(); // new map
+    // element is initialized with 0
   }
 
 
@@ -158,59 +153,75 @@ namespace OpenMS
     // if inference results are given, filter quant. data accordingly:
     if (!pep_info.empty())
     {
-      PeptideQuant filtered;
       for (PeptideQuant::iterator q_it = pep_quant_.begin(); 
-           q_it != pep_quant_.end(); ++q_it)
+           q_it != pep_quant_.end(); )
       {
         String seq = q_it->first.toUnmodifiedString();
         map<String, set<String> >::iterator pos = pep_info.find(seq);
         if (pos != pep_info.end()) // sequence found in protein inference data
         {
           q_it->second.accessions = pos->second; // replace accessions
-          filtered.insert(*q_it);
+          ++q_it;
+        }
+        else
+        {
+          pep_quant_.erase(q_it++);
         }
       }
-      pep_quant_ = filtered;
     }
 
-    // now perform the actual peptide quantification:
+    // now perform the actual peptide quantification (each peptide only
+    // touches its own data, so peptides are processed in parallel):
+    bool filter_charge = param_.getValue("filter_charge") == "true";
+    vector<PeptideQuant::iterator> peptide_its;
+    peptide_its.reserve(pep_quant_.size());
     for (PeptideQuant::iterator q_it = pep_quant_.begin();
          q_it != pep_quant_.end(); ++q_it)
     {
-      if (param_.getValue("filter_charge") == "true")
+      peptide_its.push_back(q_it);
+    }
+    Size quant_peptides = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 100) reduction(+: quant_peptides)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)peptide_its.size(); ++i)
+    {
+      PeptideData& data = peptide_its[i]->second;
+      if (filter_charge)
       {
         // find charge state with abundances for highest number of samples
         // (break ties by total abundance):
         IntList charges; // sorted charge states (best first)
-        orderBest_(q_it->second.abundances, charges);
+        orderBest_(data.abundances, charges);
         if (charges.empty()) continue; // only identified, not quantified
-        Int best_charge = charges[0];
+        const SampleAbundances& best_abundances = data.abundances[charges[0]];
 
         // quantify according to the best charge state only:
-        for (SampleAbundances::iterator samp_it =
-               q_it->second.abundances[best_charge].begin(); samp_it !=
-             q_it->second.abundances[best_charge].end(); ++samp_it)
+        for (SampleAbundances::const_iterator samp_it =
+               best_abundances.begin(); samp_it != best_abundances.end();
+             ++samp_it)
         {
-          q_it->second.total_abundances[samp_it->first] = samp_it->second;
+          data.total_abundances[samp_it->first] = samp_it->second;
         }
       }
       else
       {
         // sum up abundances over all charge states:
         for (map<Int, SampleAbundances>::iterator ab_it =
-               q_it->second.abundances.begin(); ab_it !=
-             q_it->second.abundances.end(); ++ab_it)
+               data.abundances.begin(); ab_it != data.abundances.end();
+             ++ab_it)
         {
           for (SampleAbundances::iterator samp_it = ab_it->second.begin();
                samp_it != ab_it->second.end(); ++samp_it)
           {
-            q_it->second.total_abundances[samp_it->first] += samp_it->second;
+            data.total_abundances[samp_it->first] += samp_it->second;
           }
         }
       }
-      if (!q_it->second.total_abundances.empty())
-        stats_.quant_peptides++;
+      if (!data.total_abundances.empty())
+        quant_peptides++;
     }
+    stats_.quant_peptides += quant_peptides;
 
     if ((stats_.n_samples > 1) &&
         (param_.getValue("consensus:normalize") == "true"))
@@ -344,15 +355,18 @@ namespace OpenMS
                                        accession_to_leader);
       if (!accession.empty()) // proteotypic peptide
       {
-        prot_quant_[accession].id_count += pep_it->second.id_count;
+        ProteinData& prot_data = prot_quant_[accession];
+        prot_data.id_count += pep_it->second.id_count;
+        if (pep_it->second.total_abundances.empty()) continue;
+
+        // add up contributions of same peptide with different mods:
+        SampleAbundances& raw_abundances =
+          prot_data.abundances[pep_it->first.toUnmodifiedString()];
         for (SampleAbundances::const_iterator tot_it =
                pep_it->second.total_abundances.begin(); tot_it !=
              pep_it->second.total_abundances.end(); ++tot_it)
         {
-          // add up contributions of same peptide with different mods:
-          String raw_peptide = pep_it->first.toUnmodifiedString();
-          prot_quant_[accession].abundances[raw_peptide][tot_it->first] +=
-            tot_it->second;
+          raw_abundances[tot_it->first] += tot_it->second;
         }
       }
     }
@@ -362,12 +376,25 @@ namespace OpenMS
     bool include_all = param_.getValue("include_all") == "true";
     bool fix_peptides = param_.getValue("consensus:fix_peptides") == "true";
 
+    // each protein only touches its own data, so proteins are processed in
+    // parallel:
+    vector<ProteinQuant::iterator> protein_its;
+    protein_its.reserve(prot_quant_.size());
     for (ProteinQuant::iterator prot_it = prot_quant_.begin();
          prot_it != prot_quant_.end(); ++prot_it)
     {
+      protein_its.push_back(prot_it);
+    }
+    Size too_few_peptides = 0, quant_proteins = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 100) reduction(+: too_few_peptides, quant_proteins)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)protein_its.size(); ++i)
+    {
+      ProteinQuant::iterator prot_it = protein_its[i];
       if ((top > 0) && (prot_it->second.abundances.size() < top))
       {
-        stats_.too_few_peptides++;
+        too_few_peptides++;
         if (!include_all)
           continue; // not enough proteotypic peptides
       }
@@ -460,9 +487,11 @@ namespace OpenMS
       }
 
       // update statistics:
-      if (prot_it->second.total_abundances.empty()) stats_.too_few_peptides++;
-      else stats_.quant_proteins++;
+      if (prot_it->second.total_abundances.empty()) too_few_peptides++;
+      else quant_proteins++;
     }
+    stats_.too_few_peptides += too_few_peptides;
+    stats_.quant_proteins += quant_proteins;
   }
 
 
@@ -482,8 +511,13 @@ namespace OpenMS
       }
       countPeptides_(feat_it->getPeptideIdentifications());
       PeptideHit hit = getAnnotation_(feat_it->getPeptideIdentifications());
+      if (hit == PeptideHit())
+      {
+        continue; // annotation for the feature is ambiguous or missing
+      }
       FeatureHandle handle(0, *feat_it);
-      quantifyFeature_(handle, hit); // updates "stats_.quant_features"
+      quantifyFeature_(handle, pep_quant_[hit.getSequence()].
+                       abundances[hit.getCharge()]); // updates "stats_.quant_features"
     }
     countPeptides_(features.getUnassignedPeptideIdentifications());
     stats_.total_peptides = pep_quant_.size();
@@ -508,11 +542,19 @@ namespace OpenMS
       }
       countPeptides_(cons_it->getPeptideIdentifications());
       PeptideHit hit = getAnnotation_(cons_it->getPeptideIdentifications());
+      if (hit == PeptideHit())
+      {
+        continue; // annotation for the feature is ambiguous or missing
+      }
+      // look up the peptide and charge once for all features (comparing
+      // sequences is expensive):
+      SampleAbundances& abundances =
+        pep_quant_[hit.getSequence()].abundances[hit.getCharge()];
       for (ConsensusFeature::HandleSetType::const_iterator feat_it =
              cons_it->getFeatures().begin(); feat_it !=
            cons_it->getFeatures().end(); ++feat_it)
       {
-        quantifyFeature_(*feat_it, hit); // updates "stats_.quant_features"
+        quantifyFeature_(*feat_it, abundances); // updates "stats_.quant_features"
       }
     }
     countPeptides_(consensus.getUnassignedPeptideIdentifications());
@@ -49,6 +49,10 @@
 
 #include <boost/math/distributions/normal.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using boost::math::cdf;
 
@@ -157,7 +161,8 @@ namespace OpenMS
     border_length_(0),
     training_set_(NULL),
     training_problem_(NULL),
-    training_data_(SVMData())
+    training_data_(SVMData()),
+    cv_memory_limit_(Size(1) << 30)
   {
     param_ = (struct svm_parameter*) malloc(sizeof(struct svm_parameter));
     initParameters_();
@@ -582,33 +587,29 @@ namespace OpenMS
     }
   }
 
-  void SVMWrapper::createRandomPartitions(svm_problem* problem,
-                                          Size                                number,
-                                          vector<svm_problem*>& problems)
+  void SVMWrapper::createRandomPartitionIndices_(Size size,
+                                                 Size number,
+                                                 vector<vector<Size> >& partition_indices)
   {
     vector<Size> indices;
     vector<Size>::iterator indices_iterator;
 
-    for (Size i = 0; i < problems.size(); ++i)
-    {
-      delete problems[i];
-    }
-    problems.clear();
+    partition_indices.clear();
 
     if (number == 1)
     {
-      problems.push_back(problem);
+      partition_indices.resize(1);
+      for (Size i = 0; i < size; i++)
+      {
+        partition_indices[0].push_back(i);
+      }
     }
     else if (number > 1)
     {
-      // Creating the particular partition instances
-      for (Size i = 0; i < number; i++)
-      {
-        problems.push_back(new svm_problem());
-      }
+      partition_indices.resize(number);
 
       // Creating indices
-      for (Int  i = 0; i < problem->l; i++)
+      for (Size i = 0; i < size; i++)
       {
         indices.push_back(i);
       }
@@ -621,29 +622,58 @@ namespace OpenMS
            partition_index < number;
            partition_index++)
       {
-        Size actual_partition_size = 0;
         // determining the number of elements in this partition
-        Size partition_count = (problem->l / number);
-        if (problem->l % number > partition_index)
+        Size partition_count = (size / number);
+        if (size % number > partition_index)
         {
           partition_count++;
         }
 
-        // filling the actual partition with 'partition_count' elements
-        while (actual_partition_size < partition_count)
+        partition_indices[partition_index].assign(indices_iterator, indices_iterator + partition_count);
+        indices_iterator += partition_count;
+      }
+    }
+  }
+
+  void SVMWrapper::createRandomPartitions(svm_problem* problem,
+                                          Size                                number,
+                                          vector<svm_problem*>& problems)
+  {
+    vector<vector<Size> > partition_indices;
+
+    for (Size i = 0; i < problems.size(); ++i)
+    {
+      delete problems[i];
+    }
+    problems.clear();
+
+    if (number == 1)
+    {
+      problems.push_back(problem);
+    }
+    else if (number > 1)
+    {
+      createRandomPartitionIndices_(problem->l, number, partition_indices);
+
+      // Creating the particular partition instances
+      for (Size partition_index = 0;
+           partition_index < number;
+           partition_index++)
+      {
+        problems.push_back(new svm_problem());
+
+        // filling the actual partition with its elements
+        const vector<Size>& indices = partition_indices[partition_index];
+        if (!indices.empty())
         {
-          if (actual_partition_size == 0)
-          {
-            problems[partition_index]->l = (Int)partition_count;
-            problems[partition_index]->x = new svm_node*[partition_count];
-            problems[partition_index]->y = new double[partition_count];
-          }
-          problems[partition_index]->x[actual_partition_size] =
-            problem->x[*indices_iterator];
-          problems[partition_index]->y[actual_partition_size] =
-            problem->y[*indices_iterator];
-          ++actual_partition_size;
-          ++indices_iterator;
+          problems[partition_index]->l = (Int)indices.size();
+          problems[partition_index]->x = new svm_node*[indices.size()];
+          problems[partition_index]->y = new double[indices.size()];
+        }
+        for (Size i = 0; i < indices.size(); ++i)
+        {
+          problems[partition_index]->x[i] = problem->x[indices[i]];
+          problems[partition_index]->y[i] = problem->y[indices[i]];
         }
       }
     }
@@ -653,8 +683,7 @@ namespace OpenMS
                                           Size                                  number,
                                           vector<SVMData>& problems)
   {
-    vector<Size> indices;
-    vector<Size>::iterator indices_iterator;
+    vector<vector<Size> > partition_indices;
 
     for (Size i = 0; i < problems.size(); ++i)
     {
@@ -669,48 +698,23 @@ namespace OpenMS
     }
     else if (number > 1)
     {
-      // Creating the particular partition instances
-      for (Size i = 0; i < number; i++)
-      {
-        problems.push_back(SVMData());
-      }
-
-      // Creating indices
-      for (Size  i = 0; i < problem.sequences.size(); i++)
-      {
-        indices.push_back(i);
-      }
-      // Shuffling the indices => random indices
-      random_shuffle(indices.begin(), indices.end());
+      createRandomPartitionIndices_(problem.sequences.size(), number, partition_indices);
 
-      indices_iterator = indices.begin();
+      // Creating the particular partition instances
+      problems.resize(number, SVMData());
 
+      // filling the partitions with their elements
       for (Size partition_index = 0;
            partition_index < number;
            partition_index++)
       {
-        Size actual_partition_size = 0;
-        // determining the number of elements in this partition
-        Size partition_count = (problem.sequences.size() / number);
-        if (problem.sequences.size() % number > partition_index)
+        const vector<Size>& indices = partition_indices[partition_index];
+        problems[partition_index].sequences.resize(indices.size(), std::vector<std::pair<int, double> >());
+        problems[partition_index].labels.resize(indices.size(), 0.);
+        for (Size i = 0; i < indices.size(); ++i)
         {
-          partition_count++;
-        }
-
-        // filling the actual partition with 'partition_count' elements
-        while (actual_partition_size < partition_count)
-        {
-          if (actual_partition_size == 0)
-          {
-            problems[partition_index].sequences.resize(partition_count, std::vector<std::pair<int, double> >());
-            problems[partition_index].labels.resize(partition_count, 0.);
-          }
-          problems[partition_index].sequences[actual_partition_size] =
-            problem.sequences[*indices_iterator];
-          problems[partition_index].labels[actual_partition_size] =
-            problem.labels[*indices_iterator];
-          ++actual_partition_size;
-          ++indices_iterator;
+          problems[partition_index].sequences[i] = problem.sequences[indices[i]];
+          problems[partition_index].labels[i] = problem.labels[indices[i]];
         }
       }
     }
@@ -855,11 +859,7 @@ namespace OpenMS
     Size counter = 0;
     vector<svm_problem*> partitions_ul;
     svm_problem** training_data_ul = NULL;
-    vector<SVMData> partitions_l;
-    vector<SVMData> training_data_l;
     double temp_performance = 0;
-    vector<double> predicted_labels;
-    vector<double> real_labels;
     vector<double> performances;
     Size max_index = 0;
     double max = 0;
@@ -900,17 +900,91 @@ namespace OpenMS
       ++actual_index;
     }
 
-    // estimate number of training runs:
-    Size work_steps(1), work_steps_count(0);
+    // enumerate the grid cells and capture the svm parameters (and oligo gauss table) of
+    // each cell, so that cells and folds can be trained without touching the member state
+    vector<vector<double> > grid_cells(1, actual_values);
     while (nextGrid_(start_values, step_sizes, end_values, additive_step_sizes, actual_values))
-      ++work_steps;
+    {
+      grid_cells.push_back(actual_values);
+    }
     //reset actual values:
     actual_values = start_values;
-    LOG_INFO << "SVM-CrossValidation -- number of grid cells:" << work_steps << "\n";
+    LOG_INFO << "SVM-CrossValidation -- number of grid cells:" << grid_cells.size() << "\n";
+
+    vector<svm_parameter> cell_parameters(grid_cells.size());
+    vector<Size> cell_gauss_tables(grid_cells.size(), 0);
+    vector<vector<double> > gauss_tables;
+    for (Size c = 0; c < grid_cells.size(); ++c)
+    {
+      // setting svm parameters
+      for (Size v = 0; v < start_values_map.size(); ++v)
+      {
+        // testing whether actual parameters are in the defined range
+        if (grid_cells[c][v] > end_values[v])
+          throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "RTModel CV parameters are out of range!");
+        setParameter(actual_types[v], grid_cells[c][v]);
+      }
+      if ((is_labeled || kernel_type_ == OLIGO) && border_length_ != gauss_table_.size())
+      {
+        SVMWrapper::calculateGaussTable(border_length_, sigma_, gauss_table_);
+      }
+      cell_parameters[c] = *param_;
+      cell_gauss_tables[c] = find(gauss_tables.begin(), gauss_tables.end(), gauss_table_) - gauss_tables.begin();
+      if (cell_gauss_tables[c] == gauss_tables.size())
+      {
+        gauss_tables.push_back(gauss_table_);
+      }
+    }
+
+    // libsvm draws random numbers when it fits probability models and the oligo kernel
+    // of unlabeled data is computed with the member gauss table: evaluate those sequentially
+    bool parallel = param_->probability == 0 && (is_labeled || kernel_type_ != OLIGO);
+
+    // in parallel mode, cells with the same gauss table are evaluated together, so the
+    // kernel cache is computed once per table (the results are stored per cell and fold
+    // and collected in grid order afterwards)
+    vector<Size> cell_order;
+    for (Size t = 0; t < gauss_tables.size(); ++t)
+    {
+      for (Size c = 0; c < grid_cells.size(); ++c)
+      {
+        if (!parallel || cell_gauss_tables[c] == t)
+        {
+          cell_order.push_back(c);
+        }
+      }
+      if (!parallel)
+      {
+        break;
+      }
+    }
 
-    work_steps *= number_of_runs * number_of_partitions;
+    Size work_steps = grid_cells.size() * number_of_runs * number_of_partitions;
+    Size progress = 0;
     startProgress(0, work_steps, "SVM-CrossValidation");
 
+    // oligo kernel of all pairs of labeled sequences for gauss table 'cached_table'
+    // (only if it fits into the memory limit, otherwise each fold computes its own matrices)
+    vector<double> kernel_cache;
+    Size cached_table = gauss_tables.size();
+    Size number_of_sequences = is_labeled ? problem_l.sequences.size() : 0;
+    Size kernel_cache_memory = number_of_sequences * number_of_sequences * sizeof(double);
+    bool use_kernel_cache = is_labeled && kernel_cache_memory <= cv_memory_limit_;
+
+    // every concurrently evaluated fold holds its training and test matrix (about n x n svm_nodes
+    // for labeled data) and the libsvm kernel cache: limit the number of folds accordingly
+    int fold_threads = 1;
+#ifdef _OPENMP
+    if (parallel)
+    {
+      Size fold_memory = number_of_sequences * (number_of_sequences + 2) * sizeof(svm_node)
+                         + Size(param_->cache_size * 1024 * 1024);
+      Size available_memory = cv_memory_limit_ - (use_kernel_cache ? kernel_cache_memory : 0);
+      Size max_folds = std::max(Size(1), available_memory / std::max(Size(1), fold_memory));
+      fold_threads = (int) std::min(max_folds, (Size) omp_get_max_threads());
+    }
+#endif
+
     // for every run (each run is identical, except for random partitioning of the data)
     for (Size i = 0; i < number_of_runs; i++)
     {
@@ -919,93 +993,133 @@ namespace OpenMS
         best_values[index] = 0;
       }
       double max_performance = 0;
-      if (is_labeled)
-        createRandomPartitions(problem_l, number_of_partitions, partitions_l);
-      else
-        createRandomPartitions(problem_ul, number_of_partitions, partitions_ul);
-
-      counter = 0;
-      found = true;
 
+      vector<vector<Size> > partition_indices;
+      vector<vector<Size> > training_indices(number_of_partitions);
+      vector<vector<double> > test_labels(number_of_partitions);
       if (is_labeled)
-        training_data_l.resize(number_of_partitions, SVMData());
+      {
+        createRandomPartitionIndices_(problem_l.sequences.size(), number_of_partitions, partition_indices);
+        for (Size j = 0; j < number_of_partitions; j++)
+        {
+          // same order as mergePartitions()
+          for (Size k = 0; k < number_of_partitions; k++)
+          {
+            if (k != j)
+            {
+              training_indices[j].insert(training_indices[j].end(), partition_indices[k].begin(), partition_indices[k].end());
+            }
+          }
+          for (Size k = 0; k < partition_indices[j].size(); k++)
+          {
+            test_labels[j].push_back(problem_l.labels[partition_indices[j][k]]);
+          }
+        }
+      }
       else
-        training_data_ul = new svm_problem*[number_of_partitions];
-      for (Size j = 0; j < number_of_partitions; j++)
       {
-        if (is_labeled)
-          SVMWrapper::mergePartitions(partitions_l, j, training_data_l[j]);
-        else
+        createRandomPartitions(problem_ul, number_of_partitions, partitions_ul);
+        training_data_ul = new svm_problem*[number_of_partitions];
+        for (Size j = 0; j < number_of_partitions; j++)
+        {
           training_data_ul[j] = SVMWrapper::mergePartitions(partitions_ul, j);
+          getLabels(partitions_ul[j], test_labels[j]);
+        }
       }
 
-      while (found) // do grid search
+      // performance of each (grid cell, partition) of this run
+      vector<double> fold_performances(grid_cells.size() * number_of_partitions, 0.0);
+      vector<char> fold_trained(grid_cells.size() * number_of_partitions, 0);
+
+      Size block_begin = 0;
+      while (block_begin < cell_order.size())
       {
-        // setting svm parameters
-        for (Size v = 0; v < start_values_map.size(); ++v)
+        Size table = cell_gauss_tables[cell_order[block_begin]];
+        Size block_end = block_begin + 1;
+        while (block_end < cell_order.size() && cell_gauss_tables[cell_order[block_end]] == table)
         {
-          // testing whether actual parameters are in the defined range
-          if (actual_values[v] > end_values[v])
-            throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "RTModel CV parameters are out of range!");
-          setParameter(actual_types[v], actual_values[v]);
+          ++block_end;
         }
 
-        temp_performance = 0;
-
-        vector<double>::iterator it_start, it_end;
-
-        // loop over PARTITIONS
-        for (Size j = 0; j < number_of_partitions; j++)
+        if (use_kernel_cache && cached_table != table)
         {
-          setProgress(work_steps_count++);
-
-          bool success;
-          if (is_labeled)
-            success = train(training_data_l[j]);
-          else
-            success = train(training_data_ul[j]);
+          computeKernelCache_(problem_l, gauss_tables[table], kernel_cache);
+          cached_table = table;
+        }
+        else if (!use_kernel_cache)
+        {
+          gauss_table_ = gauss_tables[table];
+        }
 
-          if (success)
+        SignedSize block_folds = (block_end - block_begin) * number_of_partitions;
+        vector<char> fold_failed(block_folds, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) if (parallel) num_threads(fold_threads)
+#endif
+        for (SignedSize k = 0; k < block_folds; ++k)
+        {
+          Size cell = cell_order[block_begin + Size(k) / number_of_partitions];
+          Size j = Size(k) % number_of_partitions;
+          Size fold = cell * number_of_partitions + j;
+          try
           {
-            if (is_labeled)
-            {
-              predict(partitions_l[j], predicted_labels);
-
-              it_start = partitions_l[j].labels.begin();
-              it_end = partitions_l[j].labels.end();
-            }
-            else
-            {
-              predict(partitions_ul[j], predicted_labels);
-              getLabels(partitions_ul[j], real_labels);
+            fold_trained[fold] = evaluateCrossValidationFold_(cell_parameters[cell],
+                                                              is_labeled ? NULL : training_data_ul[j],
+                                                              is_labeled ? NULL : partitions_ul[j],
+                                                              is_labeled ? &problem_l : NULL,
+                                                              kernel_cache,
+                                                              training_indices[j],
+                                                              is_labeled ? partition_indices[j] : vector<Size>(),
+                                                              test_labels[j],
+                                                              mcc_as_performance_measure,
+                                                              fold_performances[fold]);
+          }
+          catch (std::exception&)
+          {
+            fold_failed[k] = 1;
+          }
 
-              it_start = real_labels.begin();
-              it_end = real_labels.end();
-            }
+          IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+          ++progress;
+        }
+        // exceptions cannot leave the parallel region: evaluate the failed folds again to throw
+        for (SignedSize k = 0; k < block_folds; ++k)
+        {
+          if (fold_failed[k])
+          {
+            Size cell = cell_order[block_begin + Size(k) / number_of_partitions];
+            Size j = Size(k) % number_of_partitions;
+            Size fold = cell * number_of_partitions + j;
+            fold_trained[fold] = evaluateCrossValidationFold_(cell_parameters[cell],
+                                                              is_labeled ? NULL : training_data_ul[j],
+                                                              is_labeled ? NULL : partitions_ul[j],
+                                                              is_labeled ? &problem_l : NULL,
+                                                              kernel_cache,
+                                                              training_indices[j],
+                                                              is_labeled ? partition_indices[j] : vector<Size>(),
+                                                              test_labels[j],
+                                                              mcc_as_performance_measure,
+                                                              fold_performances[fold]);
+          }
+        }
+        block_begin = block_end;
+      }
 
-            if (param_->svm_type == C_SVC || param_->svm_type == NU_SVC)
-            {
-              if (mcc_as_performance_measure)
-              {
-                temp_performance +=
-                  OpenMS::Math::matthewsCorrelationCoefficient(predicted_labels.begin(), predicted_labels.end(), it_start, it_end);
-              }
-              else
-              {
-                temp_performance +=
-                  OpenMS::Math::classificationRate(predicted_labels.begin(), predicted_labels.end(), it_start, it_end);
-              }
-            }
-            else if (param_->svm_type == NU_SVR || param_->svm_type == EPSILON_SVR)
-            {
-              temp_performance +=
-                Math::pearsonCorrelationCoefficient(predicted_labels.begin(), predicted_labels.end(), it_start, it_end);
-            }
+      for (Size c = 0; c < grid_cells.size(); ++c) // collect the grid search results
+      {
+        actual_values = grid_cells[c];
+        temp_performance = 0;
 
-            if (param_->kernel_type == PRECOMPUTED)
-            {
-              LibSVMEncoder::destroyProblem(training_problem_);
-            }
+        // loop over PARTITIONS
+        for (Size j = 0; j < number_of_partitions; j++)
+        {
+          Size fold = c * number_of_partitions + j;
+          if (fold_trained[fold])
+          {
+            temp_performance += fold_performances[fold];
 
             if (output && j == number_of_partitions - 1)
             {
@@ -1075,21 +1189,20 @@ namespace OpenMS
         }
         else // 2nd+ run, add performance (will be averaged later)
         {
-          performances[counter] = performances[counter] + temp_performance;
-          counter++;
+          performances[c] = performances[c] + temp_performance;
         }
-
-        // trying to find new parameter combination
-        found = nextGrid_(start_values, step_sizes, end_values, additive_step_sizes, actual_values);
       } // ! grid search
 
       if (!is_labeled)
       {
         for (Size k = 0; k < number_of_partitions; k++)
         {
-          delete[] training_data_ul[k]->x;
-          delete[] training_data_ul[k]->y;
-          delete training_data_ul[k]; // delete individual objects
+          if (training_data_ul[k] != NULL)
+          {
+            delete[] training_data_ul[k]->x;
+            delete[] training_data_ul[k]->y;
+            delete training_data_ul[k]; // delete individual objects
+          }
         }
         delete[] training_data_ul; // delete array of pointers
       }
@@ -1297,6 +1410,192 @@ namespace OpenMS
     return found;
   }
 
+  void SVMWrapper::computeKernelCache_(const SVMData& data,
+                                       const vector<double>& gauss_table,
+                                       vector<double>& kernel_cache)
+  {
+    Size number_of_sequences = data.sequences.size();
+    kernel_cache.resize(number_of_sequences * number_of_sequences);
+
+    // both orders of each pair are computed, since the kernel value may
+    // depend on the summation order
+    vector<char> row_failed(number_of_sequences, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
+    {
+      try
+      {
+        for (Size j = 0; j < number_of_sequences; j++)
+        {
+          kernel_cache[i * number_of_sequences + j] = SVMWrapper::kernelOligo(data.sequences[i], data.sequences[j], gauss_table);
+        }
+      }
+      catch (std::exception&)
+      {
+        row_failed[i] = 1;
+      }
+    }
+    // exceptions cannot leave the parallel region: compute the failed rows again to throw
+    for (Size i = 0; i < number_of_sequences; i++)
+    {
+      if (row_failed[i])
+      {
+        for (Size j = 0; j < number_of_sequences; j++)
+        {
+          kernel_cache[i * number_of_sequences + j] = SVMWrapper::kernelOligo(data.sequences[i], data.sequences[j], gauss_table);
+        }
+      }
+    }
+  }
+
+  svm_problem* SVMWrapper::sliceKernelMatrix_(const vector<double>& kernel_cache,
+                                              const vector<double>& labels,
+                                              const vector<Size>& rows,
+                                              const vector<Size>& columns)
+  {
+    Size number_of_sequences = labels.size();
+    // computeKernelMatrix() computes the upper triangle of a training matrix and mirrors it
+    bool symmetric = (&rows == &columns);
+
+    svm_problem* kernel_matrix = new svm_problem;
+    kernel_matrix->l = (int) rows.size();
+    kernel_matrix->x = new svm_node*[rows.size()];
+    kernel_matrix->y = new double[rows.size()];
+
+    for (Size i = 0; i < rows.size(); i++)
+    {
+      kernel_matrix->x[i] = new svm_node[columns.size() + 2];
+      kernel_matrix->x[i][0].index = 0;
+      kernel_matrix->x[i][0].value = i + 1;
+      kernel_matrix->y[i] = labels[rows[i]];
+      kernel_matrix->x[i][columns.size() + 1].index = -1;
+
+      for (Size j = 0; j < columns.size(); j++)
+      {
+        kernel_matrix->x[i][j + 1].index = int(j) + 1;
+        if (symmetric && j < i)
+        {
+          kernel_matrix->x[i][j + 1].value = kernel_cache[columns[j] * number_of_sequences + rows[i]];
+        }
+        else
+        {
+          kernel_matrix->x[i][j + 1].value = kernel_cache[rows[i] * number_of_sequences + columns[j]];
+        }
+      }
+    }
+    return kernel_matrix;
+  }
+
+  bool SVMWrapper::evaluateCrossValidationFold_(const svm_parameter& parameter,
+                                                svm_problem* training_set,
+                                                svm_problem* test_set,
+                                                const SVMData* labeled_data,
+                                                const vector<double>& kernel_cache,
+                                                const vector<Size>& training_indices,
+                                                const vector<Size>& test_indices,
+                                                const vector<double>& real_labels,
+                                                bool mcc_as_performance_measure,
+                                                double& performance)
+  {
+    svm_problem* training_problem = training_set;
+    svm_problem* test_problem = test_set;
+
+    if (labeled_data != NULL)
+    {
+      if (training_indices.empty() || test_indices.empty())
+      {
+        return false;
+      }
+      if (!kernel_cache.empty())
+      {
+        training_problem = sliceKernelMatrix_(kernel_cache, labeled_data->labels, training_indices, training_indices);
+        test_problem = sliceKernelMatrix_(kernel_cache, labeled_data->labels, test_indices, training_indices);
+      }
+      else
+      { // the kernel of all pairs did not fit into memory: compute the matrices of this fold only
+        SVMData training_data;
+        SVMData test_data;
+        for (Size i = 0; i < training_indices.size(); ++i)
+        {
+          training_data.sequences.push_back(labeled_data->sequences[training_indices[i]]);
+          training_data.labels.push_back(labeled_data->labels[training_indices[i]]);
+        }
+        for (Size i = 0; i < test_indices.size(); ++i)
+        {
+          test_data.sequences.push_back(labeled_data->sequences[test_indices[i]]);
+          test_data.labels.push_back(labeled_data->labels[test_indices[i]]);
+        }
+        training_problem = computeKernelMatrix(training_data, training_data);
+        test_problem = computeKernelMatrix(test_data, training_data);
+      }
+    }
+    else if (training_set == NULL || test_set == NULL)
+    {
+      return false;
+    }
+    else if (kernel_type_ == OLIGO)
+    {
+      training_problem = computeKernelMatrix(training_set, training_set);
+      test_problem = computeKernelMatrix(test_set, training_set);
+    }
+
+    bool trained = (svm_check_parameter(training_problem, &parameter) == NULL);
+    if (trained)
+    {
+      svm_model* model = svm_train(training_problem, &parameter);
+
+      vector<double> labels;
+      labels.reserve(test_problem->l);
+      for (Int i = 0; i < test_problem->l; i++)
+      {
+        labels.push_back(svm_predict(model, test_problem->x[i]));
+      }
+      const vector<double>& predicted_labels = labels;
+
+      performance = 0;
+      if (parameter.svm_type == C_SVC || parameter.svm_type == NU_SVC)
+      {
+        if (mcc_as_performance_measure)
+        {
+          performance = OpenMS::Math::matthewsCorrelationCoefficient(predicted_labels.begin(), predicted_labels.end(), real_labels.begin(), real_labels.end());
+        }
+        else
+        {
+          performance = OpenMS::Math::classificationRate(predicted_labels.begin(), predicted_labels.end(), real_labels.begin(), real_labels.end());
+        }
+      }
+      else if (parameter.svm_type == NU_SVR || parameter.svm_type == EPSILON_SVR)
+      {
+        performance = Math::pearsonCorrelationCoefficient(predicted_labels.begin(), predicted_labels.end(), real_labels.begin(), real_labels.end());
+      }
+
+#if OPENMS_LIBSVM_VERSION_MAJOR == 2
+      svm_destroy_model(model);
+#else
+      svm_free_and_destroy_model(&model);
+#endif
+    }
+
+    if (training_problem != training_set)
+    {
+      LibSVMEncoder::destroyProblem(training_problem);
+      LibSVMEncoder::destroyProblem(test_problem);
+    }
+    return trained;
+  }
+
+  void SVMWrapper::setCrossValidationMemoryLimit(Size bytes)
+  {
+    cv_memory_limit_ = bytes;
+  }
+
+  Size SVMWrapper::getCrossValidationMemoryLimit() const
+  {
+    return cv_memory_limit_;
+  }
+
   void SVMWrapper::predict(const std::vector<svm_node*>& vectors, vector<double>& results)
   {
     results.clear();
@@ -1595,7 +1894,6 @@ namespace OpenMS
 
   svm_problem* SVMWrapper::computeKernelMatrix(svm_problem* problem1, svm_problem* problem2)
   {
-    double temp = 0;
     svm_problem* kernel_matrix;
 
     if (problem1 == NULL || problem2 == NULL)
@@ -1619,11 +1917,15 @@ namespace OpenMS
 
     if (problem1 == problem2)
     {
-      for (Size i = 0; i < number_of_sequences; i++)
+      // row i writes the entries (i, j) and (j, i) for j >= i only, so rows can be computed concurrently
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
       {
         for (Size j = i; j < number_of_sequences; j++)
         {
-          temp = SVMWrapper::kernelOligo(problem1->x[i], problem2->x[j], gauss_table_);
+          double temp = SVMWrapper::kernelOligo(problem1->x[i], problem2->x[j], gauss_table_);
           kernel_matrix->x[i][j + 1].index = (Int)j + 1;
           kernel_matrix->x[i][j + 1].value = temp;
           kernel_matrix->x[j][i + 1].index = (Int)i + 1;
@@ -1633,11 +1935,14 @@ namespace OpenMS
     }
     else
     {
-      for (Size i = 0; i < number_of_sequences; i++)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
       {
         for (Size j = 0; j < (Size) problem2->l; j++)
         {
-          temp = SVMWrapper::kernelOligo(problem1->x[i], problem2->x[j], gauss_table_);
+          double temp = SVMWrapper::kernelOligo(problem1->x[i], problem2->x[j], gauss_table_);
 
           kernel_matrix->x[i][j + 1].index = (Int)j + 1;
           kernel_matrix->x[i][j + 1].value = temp;
@@ -1649,7 +1954,6 @@ namespace OpenMS
 
   svm_problem* SVMWrapper::computeKernelMatrix(const SVMData& problem1, const SVMData& problem2)
   {
-    double temp = 0;
     svm_problem* kernel_matrix;
 
     if (problem1.labels.empty() || problem2.labels.empty())
@@ -1680,11 +1984,15 @@ namespace OpenMS
 
     if (&problem1 == &problem2)
     {
-      for (Size i = 0; i < number_of_sequences; i++)
+      // row i writes the entries (i, j) and (j, i) for j >= i only, so rows can be computed concurrently
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
       {
         for (Size j = i; j < number_of_sequences; j++)
         {
-          temp = SVMWrapper::kernelOligo(problem1.sequences[i], problem2.sequences[j], gauss_table_);
+          double temp = SVMWrapper::kernelOligo(problem1.sequences[i], problem2.sequences[j], gauss_table_);
           kernel_matrix->x[i][j + 1].index = int(j) + 1;
           kernel_matrix->x[i][j + 1].value = temp;
           kernel_matrix->x[j][i + 1].index = int(i) + 1;
@@ -1694,11 +2002,14 @@ namespace OpenMS
     }
     else
     {
-      for (Size i = 0; i < number_of_sequences; i++)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
       {
         for (Size j = 0; j < problem2.labels.size(); j++)
         {
-          temp = SVMWrapper::kernelOligo(problem1.sequences[i], problem2.sequences[j], gauss_table_);
+          double temp = SVMWrapper::kernelOligo(problem1.sequences[i], problem2.sequences[j], gauss_table_);
 
           kernel_matrix->x[i][j + 1].index = int(j) + 1;
           kernel_matrix->x[i][j + 1].value = temp;
@@ -35,6 +35,7 @@
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/SYSTEM/StopWatch.h>
 #include <OpenMS/SYSTEM/UpdateCheck.h>
 
@@ -171,6 +172,7 @@ namespace OpenMS
       addText_("Common UTIL options:");
     registerStringOption_("ini", "<file>", "", "Use the given TOPP INI file", false);
     registerStringOption_("log", "<file>", "", "Name of log file (created only when specified)", false, true);
+    registerStringOption_("profile", "<file>", "", "Writes a JSON report with run time per processing phase, peak memory and I/O statistics to the given file (created only when specified)", false, true);
     registerIntOption_("instance", "<n>", 1, "Instance number for the TOPP INI file", false, true);
     registerIntOption_("debug", "<n>", 0, "Sets the debug level", false, true);
     registerIntOption_("threads", "<n>", 1, "Sets the number of threads allowed to be used by the TOPP tool", false);
@@ -474,11 +476,20 @@ namespace OpenMS
     //----------------------------------------------------------
     //main
     //----------------------------------------------------------
+    String profile_file = getParamAsString_("profile");
+    if (!profile_file.empty())
+    {
+      outputFileWritable_(profile_file, "profile");
+    }
+    // the report is written when leaving this scope, also if main_ throws
+    Profiler::ScopedReport profile_report(profile_file, tool_name_, threads);
+
     StopWatch sw;
     sw.start();
     result = main_(argc, argv);
     sw.stop();
     LOG_INFO << this->tool_name_ << " took " << sw.toString() << "." << std::endl;
+    profile_report.setExitCode(result);
 
 #ifndef DEBUG_TOPP
   }
@@ -1990,7 +2001,7 @@ namespace OpenMS
     //parameters
     for (vector<ParameterInformation>::const_iterator it = parameters_.begin(); it != parameters_.end(); ++it)
     {
-      if (it->name == "ini" || it->name == "-help" || it->name == "-helphelp" || it->name == "instance" || it->name == "write_ini" || it->name == "write_wsdl" || it->name == "write_ctd") // do not store those params in ini file
+      if (it->name == "ini" || it->name == "-help" || it->name == "-helphelp" || it->name == "instance" || it->name == "write_ini" || it->name == "write_wsdl" || it->name == "write_ctd" || it->name == "profile") // do not store those params in ini file
       {
         continue;
       }
@@ -344,7 +344,7 @@ namespace OpenMS
     return formula_.find(element) != formula_.end();
   }
 
-  bool EmpiricalFormula::contains(const EmpiricalFormula& ef)
+  bool EmpiricalFormula::contains(const EmpiricalFormula& ef) const
   {
     for (EmpiricalFormula::const_iterator it = ef.begin(); it != ef.end(); ++it)
     {
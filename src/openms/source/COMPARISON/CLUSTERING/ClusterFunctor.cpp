@@ -39,10 +39,46 @@
 #include <OpenMS/COMPARISON/CLUSTERING/AverageLinkage.h>
 #include <OpenMS/CONCEPT/Factory.h>
 
+#include <algorithm>
+
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// a merge of the clusters represented by their smallest element indices low < high
+    struct ChainMerge
+    {
+      float distance;
+      Size low;
+      Size high;
+
+      ChainMerge(float d, Size l, Size h) :
+        distance(d), low(l), high(h)
+      {
+      }
+
+      /// order of the greedy algorithm: by distance, then by the (larger, smaller) cluster index
+      bool operator<(const ChainMerge & rhs) const
+      {
+        if (distance != rhs.distance) return distance < rhs.distance;
+        if (high != rhs.high) return high < rhs.high;
+        return low < rhs.low;
+      }
+    };
+
+    Size findRoot(std::vector<Size> & parent, Size i)
+    {
+      while (parent[i] != i)
+      {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+      }
+      return i;
+    }
+  }
+
   ClusterFunctor::ClusterFunctor()
   {
   }
@@ -67,6 +103,116 @@ namespace OpenMS
     Factory<ClusterFunctor>::registerProduct(AverageLinkage::getProductName(), &AverageLinkage::create);
   }
 
+  void ClusterFunctor::nearestNeighborChain_(DistanceMatrix<float> & original_distance, std::vector<BinaryTreeNode> & cluster_tree, const float threshold, LinkageUpdate update, const ProgressLogger & logger) const
+  {
+    const Size n = original_distance.dimensionsize();
+
+    // each cluster is stored at the index of its smallest element, which therefore also is its representative
+    std::vector<Size> active(n), cluster_size(n, 1);
+    for (Size i = 0; i < n; ++i)
+    {
+      active[i] = i;
+    }
+
+    std::vector<ChainMerge> merges;
+    merges.reserve(n - 1);
+    std::vector<Size> chain;
+    chain.reserve(n);
+
+    while (active.size() > 1)
+    {
+      if (chain.empty())
+      {
+        chain.push_back(active.front());
+      }
+
+      // follow the nearest neighbors until two clusters are mutual nearest neighbors
+      Size x, y;
+      float d_xy;
+      while (true)
+      {
+        x = chain.back();
+        y = n;
+        d_xy = 0.0f;
+        for (Size k = 0; k < active.size(); ++k)
+        {
+          Size z = active[k];
+          if (z == x) continue;
+          float d_xz = original_distance.getValue(x, z);
+          // among equally distant clusters prefer the smaller (larger index, smaller index) pair
+          if (y == n || d_xz < d_xy || (d_xz == d_xy && ChainMerge(d_xz, std::min(x, z), std::max(x, z)) < ChainMerge(d_xy, std::min(x, y), std::max(x, y))))
+          {
+            y = z;
+            d_xy = d_xz;
+          }
+        }
+        if (chain.size() > 1 && chain[chain.size() - 2] == y)
+        {
+          break;
+        }
+        chain.push_back(y);
+      }
+      chain.pop_back();
+      chain.pop_back();
+
+      Size low = std::min(x, y), high = std::max(x, y);
+      merges.push_back(ChainMerge(d_xy, low, high));
+
+      // Lance-Williams update of the distances to the merged cluster (stored at low)
+      float alpha_high = (float)(cluster_size[high] / (float)(cluster_size[high] + cluster_size[low]));
+      float alpha_low = (float)(cluster_size[low] / (float)(cluster_size[high] + cluster_size[low]));
+      for (Size k = 0; k < active.size(); ++k)
+      {
+        Size z = active[k];
+        if (z == low || z == high) continue;
+        float d_high = original_distance.getValue(high, z);
+        float d_low = original_distance.getValue(low, z);
+        if (update == COMPLETE_LINKAGE_UPDATE)
+        {
+          original_distance.setValueQuick(low, z, std::max(d_high, d_low));
+        }
+        else
+        {
+          original_distance.setValueQuick(low, z, alpha_high * d_high + alpha_low * d_low);
+        }
+      }
+      cluster_size[low] += cluster_size[high];
+      active.erase(std::find(active.begin(), active.end(), high));
+
+      logger.setProgress(n - active.size());
+    }
+
+    // replay the merges in the order of the greedy algorithm until the threshold is reached
+    std::sort(merges.begin(), merges.end());
+    std::vector<Size> parent(n);
+    for (Size i = 0; i < n; ++i)
+    {
+      parent[i] = i;
+    }
+
+    cluster_tree.clear();
+    cluster_tree.reserve(n - 1);
+    for (Size i = 0; i < merges.size() && merges[i].distance < threshold; ++i)
+    {
+      Size left = findRoot(parent, merges[i].low), right = findRoot(parent, merges[i].high);
+      if (left > right)
+      {
+        std::swap(left, right);
+      }
+      cluster_tree.push_back(BinaryTreeNode(left, right, merges[i].distance));
+      parent[right] = left;
+    }
+
+    //fill tree with dummy nodes
+    for (Size i = 1; i < n; ++i)
+    {
+      if (findRoot(parent, i) == i)
+      {
+        cluster_tree.push_back(BinaryTreeNode(0, i, -1.0));
+      }
+    }
+  }
+
   ClusterFunctor::InsufficientInput::InsufficientInput(const char * file, int line, const char * function, const char * message) throw() :
     BaseException(file, line, function, "ClusterFunctor::InsufficentInput", message)
   {
@@ -49,14 +49,26 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/StreamHandler.h>
 
-#ifdef _OPENMP
-#include <omp.h>
-#endif
-
-#define BUFFER_LENGTH 32768
+#include <QtCore/QAtomicInt>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThreadStorage>
 
 using namespace std;
 
+namespace
+{
+  // Lock for distributing lines to the associated streams. It is shared by all
+  // LogStreamBufs, since they usually write to the same streams (cout / cerr).
+  // Recursive, so a LogStreamNotifier may log itself. Never destroyed, as
+  // static LogStreams may still log during static destruction.
+  QMutex & distributionMutex()
+  {
+    static QMutex * mutex = new QMutex(QMutex::Recursive);
+    return *mutex;
+  }
+}
+
 namespace OpenMS
 {
   namespace Logger
@@ -65,42 +77,90 @@ namespace OpenMS
     const time_t LogStreamBuf::MAX_TIME = numeric_limits<time_t>::max();
     const std::string LogStreamBuf::UNKNOWN_LOG_LEVEL = "UNKNOWN_LOG_LEVEL";
 
+    struct LogStreamBuf::ThreadBuffer
+    {
+      explicit ThreadBuffer(LogStreamBuf * owner) :
+        owner(owner),
+        buffer()
+      {
+      }
+
+      // called by QThreadStorage when the thread ends: the incomplete line is
+      // written out, unless the LogStreamBuf is already gone (owner == 0)
+      ~ThreadBuffer()
+      {
+        QMutexLocker distribution_lock(&distributionMutex());
+        if (owner == 0)
+          return;
+
+        if (!buffer.empty() && *owner->has_streams_ != 0)
+          owner->distribute_(buffer);
+        owner->all_thread_buffers_.remove(this);
+      }
+
+      LogStreamBuf * owner;
+      std::string buffer;
+    };
+
     LogStreamBuf::LogStreamBuf(std::string log_level) :
       std::streambuf(),
-      pbuf_(0),
+      thread_buffers_(new QThreadStorage<ThreadBuffer *>()),
+      all_thread_buffers_(),
+      has_streams_(new QAtomicInt(0)),
       level_(log_level),
       stream_list_(),
-      incomplete_line_(),
       log_cache_counter_(0),
       log_cache_(),
       log_time_cache_()
     {
-      pbuf_ = new char[BUFFER_LENGTH];
-      std::streambuf::setp(pbuf_, pbuf_ + BUFFER_LENGTH - 1);
+      // no put area: all characters are passed to overflow() / xsputn(),
+      // which append them to the buffer of the calling thread
     }
 
     LogStreamBuf::~LogStreamBuf()
     {
       sync();
-#ifdef _OPENMP
-#pragma omp critical
-#endif
+
+      // write out what is left in the buffers of all threads (only incomplete lines now)
+      // and detach them, as the buffers of other threads are only deleted when these end
       {
+        QMutexLocker distribution_lock(&distributionMutex());
         clearCache();
-        if (incomplete_line_.size() > 0)
-          distribute_(incomplete_line_);
-        delete[] pbuf_;
-        pbuf_ = 0;
+        for (std::list<ThreadBuffer *>::const_iterator it = all_thread_buffers_.begin(); it != all_thread_buffers_.end(); ++it)
+        {
+          if (!stream_list_.empty() && !(*it)->buffer.empty())
+            distribute_((*it)->buffer);
+          (*it)->buffer.clear();
+          (*it)->owner = 0;
+        }
+        all_thread_buffers_.clear();
+      }
+
+      // deletes the buffer of the calling thread
+      thread_buffers_->setLocalData(0);
+      delete thread_buffers_;
+      delete has_streams_;
+    }
+
+    std::string & LogStreamBuf::getThreadBuffer_()
+    {
+      ThreadBuffer * thread_buffer = thread_buffers_->localData();
+      if (thread_buffer == 0)
+      {
+        // first output of this thread
+        thread_buffer = new ThreadBuffer(this);
+        thread_buffers_->setLocalData(thread_buffer);
+        QMutexLocker distribution_lock(&distributionMutex());
+        all_thread_buffers_.push_back(thread_buffer);
       }
+      return thread_buffer->buffer;
     }
 
     int LogStreamBuf::overflow(int c)
     {
       if (c != traits_type::eof())
       {
-        *pptr() = c;
-        pbump(1);
-        sync();
+        getThreadBuffer_().push_back(traits_type::to_char_type(c));
         return c;
       }
       else
@@ -109,6 +169,12 @@ namespace OpenMS
       }
     }
 
+    std::streamsize LogStreamBuf::xsputn(const char * s, std::streamsize n)
+    {
+      getThreadBuffer_().append(s, n);
+      return n;
+    }
+
     LogStreamBuf * LogStream::rdbuf()
     {
       return (LogStreamBuf *)std::ios::rdbuf();
@@ -223,98 +289,70 @@ namespace OpenMS
 
     int LogStreamBuf::sync()
     {
-#ifdef _OPENMP
-#pragma omp critical
-#endif
+      std::string & buffer = getThreadBuffer_();
+
+      // check if we have attached streams, so we don't waste time to
+      // prepare the output
+      if (*has_streams_ == 0)
+      {
+        buffer.clear();
+        return 0;
+      }
+
+      // only complete lines are processed, an incomplete line remains in the buffer
+      std::string::size_type last_line_end = buffer.rfind('\n');
+      if (last_line_end == std::string::npos)
+      {
+        return 0;
+      }
+
+      // take the complete lines out of the buffer, before taking the lock
+      std::string lines(buffer, last_line_end + 1);
+      lines.swap(buffer);
+
       {
-        // sync our streambuffer...
-        if (pptr() != pbase())
+        QMutexLocker distribution_lock(&distributionMutex());
+        std::string::size_type line_start = 0;
+        while (line_start <= last_line_end)
         {
-          // check if we have attached streams, so we don't waste time to
-          // prepare the output
-          if (!stream_list_.empty())
+          // search for the end of the current line
+          std::string::size_type line_end = lines.find('\n', line_start);
+          std::string outstring(lines, line_start, line_end - line_start);
+
+          // avoid adding empty lines to the cache
+          if (outstring.empty())
           {
-            char * line_start = pbase();
-            char * line_end = pbase();
-
-            static char buf[BUFFER_LENGTH];
-
-            while (line_end < pptr())
-            {
-              // search for the first end of line
-              for (; line_end < pptr() && *line_end != '\n'; line_end++)
-              {
-              }
-
-              if (line_end >= pptr())
-              {
-                // Copy the incomplete line to the incomplete_line_ buffer
-                size_t length = line_end - line_start;
-                length = std::min(length, (size_t)(BUFFER_LENGTH - 1));
-                strncpy(&(buf[0]), line_start, length);
-
-                // if length was too large, we copied one byte less than BUFFER_LENGTH to have
-                // room for the final \0
-                buf[length] = '\0';
-
-                incomplete_line_ += &(buf[0]);
-
-                // mark everything as read
-                line_end = pptr() + 1;
-              }
-              else
-              {
-                // note: pptr() - pbase() should be bounded by BUFFER_LENGTH, so this should always work
-                memcpy(&(buf[0]), line_start, line_end - line_start + 1);
-                buf[line_end - line_start] = '\0';
-
-                // assemble the string to be written
-                // (consider leftovers of the last buffer from incomplete_line_)
-                std::string outstring;
-                std::swap(outstring, incomplete_line_); // init outstring, while resetting incomplete_line_ 
-                outstring += &(buf[0]);
-
-                // avoid adding empty lines to the cache
-                if (outstring.empty())
-                {
-                  distribute_(outstring);
-                }
-                // check if we have already seen this log message
-                else if (!isInCache_(outstring))
-                {
-                  // add line to the log cache
-                  std::string extra_message = addToCache_(outstring);
-
-                  // send outline (and extra_message) to attached streams
-                  if (!extra_message.empty())
-                    distribute_(extra_message);
-
-                  distribute_(outstring);
-                }
-
-                // update the line pointers (increment both)
-                line_start = ++line_end;
-              }
-            }
+            distribute_(outstring);
           }
-          // remove all processed lines from the buffer
-          pbump((int)(pbase() - pptr()));
-        }
+          // check if we have already seen this log message
+          else if (!isInCache_(outstring))
+          {
+            // add line to the log cache
+            std::string extra_message = addToCache_(outstring);
 
-      } // ! OMP
+            // send outline (and extra_message) to attached streams
+            if (!extra_message.empty())
+              distribute_(extra_message);
+
+            distribute_(outstring);
+          }
+
+          line_start = line_end + 1;
+        }
+      }
 
       return 0;
     }
 
-    void LogStreamBuf::distribute_(std::string outstring)
+    void LogStreamBuf::distribute_(const std::string & outstring)
     {
       // if there are any streams in our list, we
       // copy the line into that streams, too and flush them
       std::list<StreamStruct>::iterator list_it = stream_list_.begin();
       for (; list_it != stream_list_.end(); ++list_it)
       {
-        *(list_it->stream) << expandPrefix_(list_it->prefix, time(0)).c_str()
-                           << outstring.c_str() << std::endl;
+        *(list_it->stream) << expandPrefix_(list_it->prefix, time(0))
+                           << outstring << std::endl;
 
         if (list_it->target != 0)
         {
@@ -464,7 +502,9 @@ namespace OpenMS
       // we didn't find it - create a new entry in the list
       LogStreamBuf::StreamStruct s_struct;
       s_struct.stream = &stream;
+      QMutexLocker distribution_lock(&distributionMutex());
       rdbuf()->stream_list_.push_back(s_struct);
+      rdbuf()->has_streams_->fetchAndStoreRelease(1);
     }
 
     void LogStream::remove(std::ostream & stream)
@@ -477,8 +517,10 @@ namespace OpenMS
       {
         rdbuf()->sync();
         // HINT: we do NOT clear the cache (because we cannot access it from here)
-        //       and we do not flush incomplete_line_!!!
+        //       and we do not flush incomplete lines!!!
+        QMutexLocker distribution_lock(&distributionMutex());
         rdbuf()->stream_list_.erase(it);
+        rdbuf()->has_streams_->fetchAndStoreRelease(rdbuf()->stream_list_.empty() ? 0 : 1);
       }
     }
 
@@ -543,6 +585,18 @@ namespace OpenMS
       std::ostream::flush();
     }
 
+    bool LogStream::hasStreams() const
+    {
+      LogStream * non_const_this = const_cast<LogStream *>(this);
+
+      LogStreamBuf * buf = non_const_this->rdbuf();
+      if (buf == 0)
+        return false;
+
+      // no lock: called for every LOG_DEBUG statement, also if nothing is logged
+      return *buf->has_streams_ != 0;
+    }
+
     bool LogStream::bound_() const
     {
       LogStream * non_const_this = const_cast<LogStream *>(this);
@@ -34,6 +34,177 @@
 
 #include <OpenMS/CONCEPT/PrecisionWrapper.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
 namespace OpenMS
 {
+  namespace
+  {
+    /// Powers of ten, exactly representable in a long double with a 64 bit significand
+    const long double POWERS_OF_TEN[] =
+    {
+      1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L, 1e9L,
+      1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L,
+      1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L
+    };
+    const Int MAX_POWER_OF_TEN = 27;
+
+    /// Limits the length of the printf output ("-", digits, ".", "e-4951"), so it always fits into the 64 character buffer
+    const Int MAX_PRECISION = 40;
+
+    /// printf uses the C locale (which might have been changed, e.g. by Qt), streams use the classic locale
+    Size fixDecimalPoint_(char* buffer, Int length)
+    {
+      for (Int i = 0; i < length; ++i)
+      {
+        if (buffer[i] == ',')
+        {
+          buffer[i] = '.';
+        }
+      }
+      return length;
+    }
+
+    /**
+      @brief Computes the first @p precision decimal digits of |@p value| (correctly rounded) and the decimal exponent of the first digit
+
+      Returns false if the digits cannot be determined reliably, i.e. if the
+      value is too close to the middle between two decimals of that precision.
+    */
+    bool roundToDigits_(double value, Int precision, UInt64& digits, Int& exponent)
+    {
+      long double magnitude = std::fabs(static_cast<long double>(value));
+      exponent = static_cast<Int>(std::floor(std::log10(std::fabs(value))));
+      for (Int attempt = 0; attempt < 3; ++attempt)
+      {
+        Int shift = precision - 1 - exponent;
+        if (shift > MAX_POWER_OF_TEN || shift < -MAX_POWER_OF_TEN)
+        {
+          return false;
+        }
+        // a single rounding step, i.e. off by at most half an ulp of the 64 bit significand
+        long double scaled = (shift >= 0) ? magnitude * POWERS_OF_TEN[shift] : magnitude / POWERS_OF_TEN[-shift];
+        if (scaled < POWERS_OF_TEN[precision - 1])
+        {
+          --exponent;
+          continue;
+        }
+        if (scaled >= POWERS_OF_TEN[precision])
+        {
+          ++exponent;
+          continue;
+        }
+        long double integral = std::floor(scaled);
+        long double fraction = scaled - integral;
+        if (std::fabs(fraction - 0.5L) < 1e-3L)
+        {
+          return false; // too close to a tie
+        }
+        digits = static_cast<UInt64>(integral) + (fraction > 0.5L ? 1 : 0);
+        if (digits == static_cast<UInt64>(POWERS_OF_TEN[precision]))
+        {
+          digits /= 10;
+          ++exponent;
+        }
+        return true;
+      }
+      return false;
+    }
+  }
+
+  Size formatFloatingPoint(char* buffer, double value, Int precision)
+  {
+    precision = std::min(precision, MAX_PRECISION);
+    UInt64 digits;
+    Int exponent;
+    // the fast path needs a significand of 64 bits (x87 extended precision) to scale the value exactly enough;
+    // where long double is the same as double (e.g. MSVC, ARM) every value falls back to printf;
+    // zero (which might be negative), infinity and NaN (for which value - value != 0) are left to printf
+    if (std::numeric_limits<long double>::digits < 64 || precision < 1 || precision > 15 ||
+        value == 0 || value - value != 0 || !roundToDigits_(value, precision, digits, exponent))
+    {
+      return fixDecimalPoint_(buffer, sprintf(buffer, "%.*g", precision, value));
+    }
+
+    char digit_chars[16];
+    for (Int i = precision - 1; i >= 0; --i)
+    {
+      digit_chars[i] = static_cast<char>('0' + digits % 10);
+      digits /= 10;
+    }
+    // like "%g", no trailing zeros
+    Int significant = precision;
+    while (significant > 1 && digit_chars[significant - 1] == '0')
+    {
+      --significant;
+    }
+
+    char* out = buffer;
+    if (value < 0)
+    {
+      *out++ = '-';
+    }
+    if (exponent < -4 || exponent >= precision) // scientific notation
+    {
+      *out++ = digit_chars[0];
+      if (significant > 1)
+      {
+        *out++ = '.';
+        for (Int i = 1; i < significant; ++i)
+        {
+          *out++ = digit_chars[i];
+        }
+      }
+      *out++ = 'e';
+      *out++ = (exponent < 0) ? '-' : '+';
+      Int abs_exponent = std::abs(exponent);
+      if (abs_exponent >= 100)
+      {
+        *out++ = static_cast<char>('0' + abs_exponent / 100);
+        abs_exponent %= 100;
+      }
+      *out++ = static_cast<char>('0' + abs_exponent / 10);
+      *out++ = static_cast<char>('0' + abs_exponent % 10);
+    }
+    else if (exponent >= 0)
+    {
+      for (Int i = 0; i <= exponent; ++i)
+      {
+        *out++ = (i < significant) ? digit_chars[i] : '0';
+      }
+      if (significant > exponent + 1)
+      {
+        *out++ = '.';
+        for (Int i = exponent + 1; i < significant; ++i)
+        {
+          *out++ = digit_chars[i];
+        }
+      }
+    }
+    else
+    {
+      *out++ = '0';
+      *out++ = '.';
+      for (Int i = -1; i > exponent; --i)
+      {
+        *out++ = '0';
+      }
+      for (Int i = 0; i < significant; ++i)
+      {
+        *out++ = digit_chars[i];
+      }
+    }
+    return out - buffer;
+  }
+
+  Size formatFloatingPoint(char* buffer, long double value, Int precision)
+  {
+    precision = std::min(precision, MAX_PRECISION);
+    return fixDecimalPoint_(buffer, sprintf(buffer, "%.*Lg", precision, value));
+  }
+
 }
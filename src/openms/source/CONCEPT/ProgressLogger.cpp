@@ -38,6 +38,7 @@
 
 #include <OpenMS/DATASTRUCTURES/String.h>
 
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/SYSTEM/StopWatch.h>
 
 #include <QtCore/QString>
@@ -239,6 +240,7 @@ public:
     last_invoke_ = time(NULL);
     current_logger_->startProgress(begin, end, label, recursion_depth_);
     ++recursion_depth_;
+    Profiler::startPhase(label);
   }
 
   void ProgressLogger::setProgress(SignedSize value) const
@@ -255,6 +257,7 @@ public:
     if (recursion_depth_)
     {
       --recursion_depth_;
+      Profiler::endPhase();
     }
     current_logger_->endProgress(recursion_depth_);
   }
@@ -403,26 +403,23 @@ namespace OpenMS
 
   String String::operator+(float f) const
   {
-    stringstream s;
-    s.precision(writtenDigits(f));
-    s << *this << f;
-    return s.str();
+    String s(*this);
+    s.append(StringConversions::toString(f));
+    return s;
   }
 
   String String::operator+(double d) const
   {
-    stringstream s;
-    s.precision(writtenDigits(d));
-    s << *this << d;
-    return s.str();
+    String s(*this);
+    s.append(StringConversions::toString(d));
+    return s;
   }
 
   String String::operator+(long double ld) const
   {
-    stringstream s;
-    s.precision(writtenDigits(ld));
-    s << *this << ld;
-    return s.str();
+    String s(*this);
+    s.append(StringConversions::toString(ld));
+    return s;
   }
 
   String String::operator+(char c) const
@@ -267,12 +267,13 @@ namespace OpenMS
     int min_index = 0;
     int max_index = static_cast<Int>((*packages_).size()) - 1;
     int i = static_cast<Int>(last_package_);
-    SplinePackage package = (*packages_)[i];
+    // refer to the packages instead of copying their splines at every step
+    const SplinePackage* package = &(*packages_)[i];
 
     // find correct package
-    while (!(package.isInPackage(mz)))
+    while (!(package->isInPackage(mz)))
     {
-      if (mz < package.getMzMin())
+      if (mz < package->getMzMin())
       {
         --i;
         // check index limit
@@ -282,14 +283,14 @@ namespace OpenMS
           return (*packages_)[min_index].getMzMin();
         }
         // m/z in the gap?
-        package = (*packages_)[i];
-        if (mz > package.getMzMax())
+        package = &(*packages_)[i];
+        if (mz > package->getMzMax())
         {
           last_package_ = i + 1;
           return (*packages_)[i + 1].getMzMin();
         }
       }
-      else if (mz > package.getMzMax())
+      else if (mz > package->getMzMax())
       {
 
         ++i;
@@ -300,17 +301,17 @@ namespace OpenMS
           return mz_max_;
         }
         // m/z in the gap?
-        package = (*packages_)[i];
-        if (mz < package.getMzMin())
+        package = &(*packages_)[i];
+        if (mz < package->getMzMin())
         {
           last_package_ = i;
-          return package.getMzMin();
+          return package->getMzMin();
         }
       }
     }
 
     // find m/z in the package
-    if (mz + package.getMzStepWidth() > package.getMzMax())
+    if (mz + package->getMzStepWidth() > package->getMzMax())
     {
       // The next step gets us outside the current package.
       // Let's move to the package to the right.
@@ -329,7 +330,7 @@ namespace OpenMS
     {
       // make a small step within the package
       last_package_ = i;
-      return mz + package.getMzStepWidth();
+      return mz + package->getMzStepWidth();
     }
   }
 
@@ -0,0 +1,1125 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/BinaryDataFile.h>
+
+#include <OpenMS/CHEMISTRY/EnzymesDB.h>
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/METADATA/DataProcessing.h>
+
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// Kind of data stored in a file (part of the file header)
+    enum ContentType
+    {
+      FEATURE_MAP = 1,
+      CONSENSUS_MAP = 2,
+      IDENTIFICATIONS = 3
+    };
+
+    /// Magic string at the beginning of each file (ends with a newline to detect text mode conversions)
+    const char MAGIC[8] = {'O', 'M', 'S', '-', 'B', 'I', 'N', '\n'};
+
+    /// Written in native byte order, used to detect files written on machines with a different byte order
+    const UInt32 BYTE_ORDER_MARK = 0x01020304;
+
+    /**
+      @brief Writes values in their in-memory representation to a stream
+
+      Each distinct string is written only once: the first occurrence is
+      stored as an id followed by the characters, subsequent occurrences only
+      as the id.
+    */
+    class BinaryWriter
+    {
+public:
+      BinaryWriter(ostream& os, const String& filename) :
+        os_(os),
+        filename_(filename)
+      {
+      }
+
+      template <typename T>
+      void writeValue(const T& value)
+      {
+        os_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      void writeSize(Size size)
+      {
+        writeValue(static_cast<UInt32>(size));
+      }
+
+      void writeBool(bool value)
+      {
+        writeValue(static_cast<Byte>(value));
+      }
+
+      void writeString(const String& s)
+      {
+        map<String, UInt32>::const_iterator pos = string_ids_.find(s);
+        if (pos != string_ids_.end())
+        {
+          writeValue(pos->second);
+          return;
+        }
+        UInt32 id = static_cast<UInt32>(string_ids_.size());
+        string_ids_.insert(make_pair(s, id));
+        writeValue(id);
+        writeSize(s.size());
+        os_.write(s.data(), s.size());
+      }
+
+      void writeStrings(const vector<String>& strings)
+      {
+        writeSize(strings.size());
+        for (Size i = 0; i < strings.size(); ++i)
+        {
+          writeString(strings[i]);
+        }
+      }
+
+      void writeDateTime(const DateTime& date)
+      {
+        writeBool(date.isValid());
+        if (date.isValid())
+        {
+          writeString(date.get());
+        }
+      }
+
+      void writeDataValue(const DataValue& value)
+      {
+        writeValue(static_cast<Byte>(value.valueType()));
+        switch (value.valueType())
+        {
+        case DataValue::STRING_VALUE:
+          writeString(value.toString());
+          break;
+
+        case DataValue::INT_VALUE:
+          writeValue(static_cast<Int64>((long long)value));
+          break;
+
+        case DataValue::DOUBLE_VALUE:
+          writeValue((double)value);
+          break;
+
+        case DataValue::STRING_LIST:
+        {
+          StringList list = value.toStringList();
+          writeSize(list.size());
+          for (Size i = 0; i < list.size(); ++i)
+          {
+            writeString(list[i]);
+          }
+          break;
+        }
+
+        case DataValue::INT_LIST:
+        {
+          IntList list = value.toIntList();
+          writeSize(list.size());
+          for (Size i = 0; i < list.size(); ++i)
+          {
+            writeValue(list[i]);
+          }
+          break;
+        }
+
+        case DataValue::DOUBLE_LIST:
+        {
+          DoubleList list = value.toDoubleList();
+          writeSize(list.size());
+          for (Size i = 0; i < list.size(); ++i)
+          {
+            writeValue(list[i]);
+          }
+          break;
+        }
+
+        case DataValue::EMPTY_VALUE:
+          break;
+        }
+        writeString(value.getUnit());
+      }
+
+      void writeMetaInfo(const MetaInfoInterface& meta)
+      {
+        vector<UInt> keys;
+        meta.getKeys(keys);
+        writeSize(keys.size());
+        for (Size i = 0; i < keys.size(); ++i)
+        {
+          // the registry is shared between threads and locks on each access, so resolve every index only once
+          map<UInt, String>::iterator pos = meta_names_.find(keys[i]);
+          if (pos == meta_names_.end())
+          {
+            pos = meta_names_.insert(make_pair(keys[i], MetaInfoInterface::metaRegistry().getName(keys[i]))).first;
+          }
+          writeString(pos->second);
+          writeDataValue(meta.getMetaValue(keys[i]));
+        }
+      }
+
+      void writeDataProcessing(const vector<DataProcessing>& processing)
+      {
+        writeSize(processing.size());
+        for (Size i = 0; i < processing.size(); ++i)
+        {
+          const Software& software = processing[i].getSoftware();
+          writeString(software.getName());
+          writeString(software.getVersion());
+          writeMetaInfo(software);
+
+          const set<DataProcessing::ProcessingAction>& actions = processing[i].getProcessingActions();
+          writeSize(actions.size());
+          for (set<DataProcessing::ProcessingAction>::const_iterator it = actions.begin(); it != actions.end(); ++it)
+          {
+            writeValue(static_cast<Int32>(*it));
+          }
+          writeDateTime(processing[i].getCompletionTime());
+          writeMetaInfo(processing[i]);
+        }
+      }
+
+      void writeProteinGroups(const vector<ProteinIdentification::ProteinGroup>& groups)
+      {
+        writeSize(groups.size());
+        for (Size i = 0; i < groups.size(); ++i)
+        {
+          writeValue(groups[i].probability);
+          writeStrings(groups[i].accessions);
+        }
+      }
+
+      void writeSearchParameters(const ProteinIdentification::SearchParameters& params)
+      {
+        writeString(params.db);
+        writeString(params.db_version);
+        writeString(params.taxonomy);
+        writeString(params.charges);
+        writeValue(static_cast<Int32>(params.mass_type));
+        writeStrings(params.fixed_modifications);
+        writeStrings(params.variable_modifications);
+        writeValue(static_cast<UInt32>(params.missed_cleavages));
+        writeValue(params.fragment_mass_tolerance);
+        writeBool(params.fragment_mass_tolerance_ppm);
+        writeValue(params.precursor_mass_tolerance);
+        writeBool(params.precursor_mass_tolerance_ppm);
+        writeString(params.digestion_enzyme.getName());
+        writeMetaInfo(params);
+      }
+
+      void writeProteinIdentifications(const vector<ProteinIdentification>& ids)
+      {
+        writeSize(ids.size());
+        for (Size i = 0; i < ids.size(); ++i)
+        {
+          const ProteinIdentification& id = ids[i];
+          writeString(id.getIdentifier());
+          writeString(id.getSearchEngine());
+          writeString(id.getSearchEngineVersion());
+          writeDateTime(id.getDateTime());
+          writeString(id.getScoreType());
+          writeBool(id.isHigherScoreBetter());
+          writeValue(id.getSignificanceThreshold());
+
+          const vector<ProteinHit>& hits = id.getHits();
+          writeSize(hits.size());
+          for (Size j = 0; j < hits.size(); ++j)
+          {
+            writeString(hits[j].getAccession());
+            writeString(hits[j].getSequence());
+            writeValue(hits[j].getScore());
+            writeValue(hits[j].getRank());
+            writeValue(hits[j].getCoverage());
+            writeMetaInfo(hits[j]);
+          }
+
+          writeProteinGroups(id.getProteinGroups());
+          writeProteinGroups(id.getIndistinguishableProteins());
+          writeSearchParameters(id.getSearchParameters());
+          writeMetaInfo(id);
+        }
+      }
+
+      void writePeptideHit(const PeptideHit& hit)
+      {
+        writeString(hit.getSequence().toString());
+        writeValue(hit.getScore());
+        writeValue(hit.getRank());
+        writeValue(hit.getCharge());
+
+        const vector<PeptideEvidence>& evidences = hit.getPeptideEvidences();
+        writeSize(evidences.size());
+        for (Size i = 0; i < evidences.size(); ++i)
+        {
+          writeString(evidences[i].getProteinAccession());
+          writeValue(evidences[i].getStart());
+          writeValue(evidences[i].getEnd());
+          writeValue(evidences[i].getAABefore());
+          writeValue(evidences[i].getAAAfter());
+        }
+
+        const vector<PeptideHit::PepXMLAnalysisResult>& results = hit.getAnalysisResults();
+        writeSize(results.size());
+        for (Size i = 0; i < results.size(); ++i)
+        {
+          writeString(results[i].score_type);
+          writeBool(results[i].higher_is_better);
+          writeValue(results[i].main_score);
+          writeSize(results[i].sub_scores.size());
+          for (map<String, double>::const_iterator it = results[i].sub_scores.begin(); it != results[i].sub_scores.end(); ++it)
+          {
+            writeString(it->first);
+            writeValue(it->second);
+          }
+        }
+
+        writeMetaInfo(hit);
+      }
+
+      void writePeptideIdentifications(const vector<PeptideIdentification>& ids)
+      {
+        writeSize(ids.size());
+        for (Size i = 0; i < ids.size(); ++i)
+        {
+          const PeptideIdentification& id = ids[i];
+          writeString(id.getIdentifier());
+          writeValue(id.getRT());
+          writeValue(id.getMZ());
+          writeString(id.getScoreType());
+          writeBool(id.isHigherScoreBetter());
+          writeValue(id.getSignificanceThreshold());
+          writeString(id.getBaseName());
+          writeMetaInfo(id);
+
+          const vector<PeptideHit>& hits = id.getHits();
+          writeSize(hits.size());
+          for (Size j = 0; j < hits.size(); ++j)
+          {
+            writePeptideHit(hits[j]);
+          }
+        }
+      }
+
+      /// Writes the meta data shared by feature and consensus maps
+      template <typename MapType>
+      void writeMapMetaData(const MapType& map)
+      {
+        writeString(map.getIdentifier());
+        writeValue(map.getUniqueId());
+        writeMetaInfo(map);
+        writeProteinIdentifications(map.getProteinIdentifications());
+        writePeptideIdentifications(map.getUnassignedPeptideIdentifications());
+        writeDataProcessing(map.getDataProcessing());
+      }
+
+      void writeBaseFeature(const BaseFeature& feature)
+      {
+        writeValue(feature.getRT());
+        writeValue(feature.getMZ());
+        writeValue(feature.getIntensity());
+        writeValue(feature.getQuality());
+        writeValue(feature.getCharge());
+        writeValue(feature.getWidth());
+        writeValue(feature.getUniqueId());
+        writeMetaInfo(feature);
+        writePeptideIdentifications(feature.getPeptideIdentifications());
+      }
+
+      void writeFeature(const Feature& feature)
+      {
+        writeBaseFeature(feature);
+        writeValue(feature.getQuality(0));
+        writeValue(feature.getQuality(1));
+
+        const vector<ConvexHull2D>& hulls = feature.getConvexHulls();
+        writeSize(hulls.size());
+        for (Size i = 0; i < hulls.size(); ++i)
+        {
+          const ConvexHull2D::PointArrayType& points = hulls[i].getHullPoints();
+          writeSize(points.size());
+          for (Size j = 0; j < points.size(); ++j)
+          {
+            writeValue(points[j][0]);
+            writeValue(points[j][1]);
+          }
+        }
+
+        const vector<Feature>& subordinates = feature.getSubordinates();
+        writeSize(subordinates.size());
+        for (Size i = 0; i < subordinates.size(); ++i)
+        {
+          writeFeature(subordinates[i]);
+        }
+      }
+
+      void writeConsensusFeature(const ConsensusFeature& feature)
+      {
+        writeBaseFeature(feature);
+
+        writeSize(feature.size());
+        for (ConsensusFeature::const_iterator it = feature.begin(); it != feature.end(); ++it)
+        {
+          writeValue(it->getMapIndex());
+          writeValue(it->getUniqueId());
+          writeValue(it->getRT());
+          writeValue(it->getMZ());
+          writeValue(it->getIntensity());
+          writeValue(it->getCharge());
+          writeValue(it->getWidth());
+        }
+
+        const vector<ConsensusFeature::Ratio> ratios = feature.getRatios();
+        writeSize(ratios.size());
+        for (Size i = 0; i < ratios.size(); ++i)
+        {
+          writeValue(ratios[i].ratio_value_);
+          writeString(ratios[i].denominator_ref_);
+          writeString(ratios[i].numerator_ref_);
+          writeStrings(ratios[i].description_);
+        }
+      }
+
+      /// Flushes the stream and checks that everything was written
+      void finish()
+      {
+        os_.flush();
+        if (!os_)
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_);
+        }
+      }
+
+private:
+      ostream& os_;
+      String filename_;
+      map<String, UInt32> string_ids_;
+      map<UInt, String> meta_names_;
+    };
+
+    /// Reads values written by BinaryWriter
+    class BinaryReader
+    {
+public:
+      BinaryReader(istream& is, const String& filename) :
+        is_(is),
+        filename_(filename),
+        remaining_(0)
+      {
+        streampos start = is_.tellg();
+        is_.seekg(0, ios::end);
+        remaining_ = static_cast<Size>(is_.tellg() - start);
+        is_.seekg(start);
+      }
+
+      template <typename T>
+      T readValue()
+      {
+        T value;
+        is_.read(reinterpret_cast<char*>(&value), sizeof(T));
+        if (!is_)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unexpected end of binary file.", filename_);
+        }
+        remaining_ -= sizeof(T);
+        return value;
+      }
+
+      Size readSize()
+      {
+        return readValue<UInt32>();
+      }
+
+      /// Reads the number of entries of a list and checks that they fit into the rest of the file (each entry takes at least @p min_entry_size bytes), before memory is allocated for them
+      Size readCount(Size min_entry_size)
+      {
+        Size count = readSize();
+        if (count > remaining_ / min_entry_size)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid number of entries (" + String(count) + "), the binary file is corrupt or truncated.", filename_);
+        }
+        return count;
+      }
+
+      bool readBool()
+      {
+        return readValue<Byte>() != 0;
+      }
+
+      /// Returns the string (references stay valid until the reader is destroyed)
+      const String& readString()
+      {
+        return strings_[readStringId_()];
+      }
+
+      void readStrings(vector<String>& strings)
+      {
+        strings.resize(readCount(sizeof(UInt32)));
+        for (Size i = 0; i < strings.size(); ++i)
+        {
+          strings[i] = readString();
+        }
+      }
+
+      /// Returns the peptide sequence, each distinct sequence is parsed only once
+      const AASequence& readSequence()
+      {
+        UInt32 id = readStringId_();
+        map<UInt32, AASequence>::iterator pos = sequences_.find(id);
+        if (pos == sequences_.end())
+        {
+          pos = sequences_.insert(make_pair(id, AASequence::fromString(strings_[id]))).first;
+        }
+        return pos->second;
+      }
+
+      DateTime readDateTime()
+      {
+        DateTime date;
+        if (readBool())
+        {
+          date.set(readString());
+        }
+        return date;
+      }
+
+      DataValue readDataValue()
+      {
+        DataValue value;
+        Byte type = readValue<Byte>();
+        switch (type)
+        {
+        case DataValue::STRING_VALUE:
+          value = DataValue(readString());
+          break;
+
+        case DataValue::INT_VALUE:
+          value = DataValue(readValue<Int64>());
+          break;
+
+        case DataValue::DOUBLE_VALUE:
+          value = DataValue(readValue<double>());
+          break;
+
+        case DataValue::STRING_LIST:
+        {
+          StringList list;
+          readStrings(list);
+          value = DataValue(list);
+          break;
+        }
+
+        case DataValue::INT_LIST:
+        {
+          IntList list(readCount(sizeof(Int)));
+          for (Size i = 0; i < list.size(); ++i)
+          {
+            list[i] = readValue<Int>();
+          }
+          value = DataValue(list);
+          break;
+        }
+
+        case DataValue::DOUBLE_LIST:
+        {
+          DoubleList list(readCount(sizeof(double)));
+          for (Size i = 0; i < list.size(); ++i)
+          {
+            list[i] = readValue<double>();
+          }
+          value = DataValue(list);
+          break;
+        }
+
+        case DataValue::EMPTY_VALUE:
+          break;
+
+        default:
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid meta value type " + String(Int(type)) + " in binary file.", filename_);
+        }
+
+        const String& unit = readString();
+        if (!unit.empty())
+        {
+          value.setUnit(unit);
+        }
+        return value;
+      }
+
+      void readMetaInfo(MetaInfoInterface& meta)
+      {
+        Size count = readSize();
+        for (Size i = 0; i < count; ++i)
+        {
+          // register every name only once, the registry locks on each access
+          UInt32 name_id = readStringId_();
+          map<UInt32, UInt>::iterator pos = meta_indices_.find(name_id);
+          if (pos == meta_indices_.end())
+          {
+            pos = meta_indices_.insert(make_pair(name_id, MetaInfoInterface::metaRegistry().registerName(strings_[name_id]))).first;
+          }
+          meta.setMetaValue(pos->second, readDataValue());
+        }
+      }
+
+      void readDataProcessing(vector<DataProcessing>& processing)
+      {
+        processing.resize(readCount(sizeof(UInt32)));
+        for (Size i = 0; i < processing.size(); ++i)
+        {
+          Software& software = processing[i].getSoftware();
+          software.setName(readString());
+          software.setVersion(readString());
+          readMetaInfo(software);
+
+          set<DataProcessing::ProcessingAction>& actions = processing[i].getProcessingActions();
+          Size action_count = readSize();
+          for (Size j = 0; j < action_count; ++j)
+          {
+            Int32 action = readValue<Int32>();
+            if (action < 0 || action >= DataProcessing::SIZE_OF_PROCESSINGACTION)
+            {
+              throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid processing action " + String(action) + " in binary file.", filename_);
+            }
+            actions.insert(static_cast<DataProcessing::ProcessingAction>(action));
+          }
+          processing[i].setCompletionTime(readDateTime());
+          readMetaInfo(processing[i]);
+        }
+      }
+
+      void readProteinGroups(vector<ProteinIdentification::ProteinGroup>& groups)
+      {
+        groups.resize(readCount(sizeof(double)));
+        for (Size i = 0; i < groups.size(); ++i)
+        {
+          groups[i].probability = readValue<double>();
+          readStrings(groups[i].accessions);
+        }
+      }
+
+      void readSearchParameters(ProteinIdentification::SearchParameters& params)
+      {
+        params.db = readString();
+        params.db_version = readString();
+        params.taxonomy = readString();
+        params.charges = readString();
+        Int32 mass_type = readValue<Int32>();
+        if (mass_type < 0 || mass_type >= ProteinIdentification::SIZE_OF_PEAKMASSTYPE)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid mass type " + String(mass_type) + " in binary file.", filename_);
+        }
+        params.mass_type = static_cast<ProteinIdentification::PeakMassType>(mass_type);
+        readStrings(params.fixed_modifications);
+        readStrings(params.variable_modifications);
+        params.missed_cleavages = readValue<UInt32>();
+        params.fragment_mass_tolerance = readValue<double>();
+        params.fragment_mass_tolerance_ppm = readBool();
+        params.precursor_mass_tolerance = readValue<double>();
+        params.precursor_mass_tolerance_ppm = readBool();
+        const String& enzyme = readString();
+        if (EnzymesDB::getInstance()->hasEnzyme(enzyme))
+        {
+          params.digestion_enzyme = *EnzymesDB::getInstance()->getEnzyme(enzyme);
+        }
+        readMetaInfo(params);
+      }
+
+      void readProteinIdentifications(vector<ProteinIdentification>& ids)
+      {
+        ids.resize(readCount(sizeof(UInt32)));
+        for (Size i = 0; i < ids.size(); ++i)
+        {
+          ProteinIdentification& id = ids[i];
+          id.setIdentifier(readString());
+          id.setSearchEngine(readString());
+          id.setSearchEngineVersion(readString());
+          id.setDateTime(readDateTime());
+          id.setScoreType(readString());
+          id.setHigherScoreBetter(readBool());
+          id.setSignificanceThreshold(readValue<double>());
+
+          vector<ProteinHit>& hits = id.getHits();
+          hits.resize(readCount(sizeof(UInt32)));
+          for (Size j = 0; j < hits.size(); ++j)
+          {
+            hits[j].setAccession(readString());
+            hits[j].setSequence(readString());
+            hits[j].setScore(readValue<float>());
+            hits[j].setRank(readValue<UInt>());
+            hits[j].setCoverage(readValue<double>());
+            readMetaInfo(hits[j]);
+          }
+
+          readProteinGroups(id.getProteinGroups());
+          readProteinGroups(id.getIndistinguishableProteins());
+          ProteinIdentification::SearchParameters params;
+          readSearchParameters(params);
+          id.setSearchParameters(params);
+          readMetaInfo(id);
+        }
+      }
+
+      void readPeptideHit(PeptideHit& hit)
+      {
+        hit.setSequence(readSequence());
+        hit.setScore(readValue<double>());
+        hit.setRank(readValue<UInt>());
+        hit.setCharge(readValue<Int>());
+
+        vector<PeptideEvidence> evidences(readCount(sizeof(UInt32)));
+        for (Size i = 0; i < evidences.size(); ++i)
+        {
+          evidences[i].setProteinAccession(readString());
+          evidences[i].setStart(readValue<Int>());
+          evidences[i].setEnd(readValue<Int>());
+          evidences[i].setAABefore(readValue<char>());
+          evidences[i].setAAAfter(readValue<char>());
+        }
+        hit.setPeptideEvidences(evidences);
+
+        // only set if present, an empty list is not stored in the hit
+        Size result_count = readCount(sizeof(UInt32));
+        if (result_count > 0)
+        {
+          vector<PeptideHit::PepXMLAnalysisResult> results(result_count);
+          for (Size i = 0; i < result_count; ++i)
+          {
+            results[i].score_type = readString();
+            results[i].higher_is_better = readBool();
+            results[i].main_score = readValue<double>();
+            Size sub_score_count = readSize();
+            for (Size j = 0; j < sub_score_count; ++j)
+            {
+              const String& name = readString();
+              results[i].sub_scores[name] = readValue<double>();
+            }
+          }
+          hit.setAnalysisResults(results);
+        }
+
+        readMetaInfo(hit);
+      }
+
+      void readPeptideIdentifications(vector<PeptideIdentification>& ids)
+      {
+        ids.resize(readCount(sizeof(UInt32)));
+        for (Size i = 0; i < ids.size(); ++i)
+        {
+          PeptideIdentification& id = ids[i];
+          id.setIdentifier(readString());
+          id.setRT(readValue<double>());
+          id.setMZ(readValue<double>());
+          id.setScoreType(readString());
+          id.setHigherScoreBetter(readBool());
+          id.setSignificanceThreshold(readValue<double>());
+          id.setBaseName(readString());
+          readMetaInfo(id);
+
+          vector<PeptideHit>& hits = id.getHits();
+          hits.resize(readCount(sizeof(UInt32)));
+          for (Size j = 0; j < hits.size(); ++j)
+          {
+            readPeptideHit(hits[j]);
+          }
+        }
+      }
+
+      /// Reads the meta data shared by feature and consensus maps
+      template <typename MapType>
+      void readMapMetaData(MapType& map)
+      {
+        map.setIdentifier(readString());
+        map.setUniqueId(readValue<UInt64>());
+        readMetaInfo(map);
+        readProteinIdentifications(map.getProteinIdentifications());
+        readPeptideIdentifications(map.getUnassignedPeptideIdentifications());
+        readDataProcessing(map.getDataProcessing());
+      }
+
+      void readBaseFeature(BaseFeature& feature)
+      {
+        feature.setRT(readValue<BaseFeature::CoordinateType>());
+        feature.setMZ(readValue<BaseFeature::CoordinateType>());
+        feature.setIntensity(readValue<BaseFeature::IntensityType>());
+        feature.setQuality(readValue<BaseFeature::QualityType>());
+        feature.setCharge(readValue<BaseFeature::ChargeType>());
+        feature.setWidth(readValue<BaseFeature::WidthType>());
+        feature.setUniqueId(readValue<UInt64>());
+        readMetaInfo(feature);
+        readPeptideIdentifications(feature.getPeptideIdentifications());
+      }
+
+      void readFeature(Feature& feature)
+      {
+        readBaseFeature(feature);
+        feature.setQuality(0, readValue<Feature::QualityType>());
+        feature.setQuality(1, readValue<Feature::QualityType>());
+
+        vector<ConvexHull2D>& hulls = feature.getConvexHulls();
+        hulls.resize(readCount(sizeof(UInt32)));
+        for (Size i = 0; i < hulls.size(); ++i)
+        {
+          ConvexHull2D::PointArrayType points(readCount(2 * sizeof(double)));
+          for (Size j = 0; j < points.size(); ++j)
+          {
+            points[j][0] = readValue<double>();
+            points[j][1] = readValue<double>();
+          }
+          hulls[i].setHullPoints(points);
+        }
+
+        vector<Feature>& subordinates = feature.getSubordinates();
+        subordinates.resize(readCount(sizeof(UInt32)));
+        for (Size i = 0; i < subordinates.size(); ++i)
+        {
+          readFeature(subordinates[i]);
+        }
+      }
+
+      void readConsensusFeature(ConsensusFeature& feature)
+      {
+        readBaseFeature(feature);
+
+        Size handle_count = readSize();
+        for (Size i = 0; i < handle_count; ++i)
+        {
+          FeatureHandle handle;
+          handle.setMapIndex(readValue<UInt64>());
+          handle.setUniqueId(readValue<UInt64>());
+          handle.setRT(readValue<FeatureHandle::CoordinateType>());
+          handle.setMZ(readValue<FeatureHandle::CoordinateType>());
+          handle.setIntensity(readValue<FeatureHandle::IntensityType>());
+          handle.setCharge(readValue<FeatureHandle::ChargeType>());
+          handle.setWidth(readValue<FeatureHandle::WidthType>());
+          feature.insert(handle);
+        }
+
+        vector<ConsensusFeature::Ratio>& ratios = feature.getRatios();
+        ratios.resize(readCount(sizeof(double)));
+        for (Size i = 0; i < ratios.size(); ++i)
+        {
+          ratios[i].ratio_value_ = readValue<double>();
+          ratios[i].denominator_ref_ = readString();
+          ratios[i].numerator_ref_ = readString();
+          readStrings(ratios[i].description_);
+        }
+      }
+
+private:
+      UInt32 readStringId_()
+      {
+        UInt32 id = readValue<UInt32>();
+        if (id < strings_.size())
+        {
+          return id;
+        }
+        if (id != strings_.size())
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid string reference " + String(id) + " in binary file.", filename_);
+        }
+        String s;
+        s.resize(readCount(1));
+        if (!s.empty())
+        {
+          is_.read(&s[0], s.size());
+          if (!is_)
+          {
+            throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unexpected end of binary file.", filename_);
+          }
+          remaining_ -= s.size();
+        }
+        strings_.push_back(s);
+        return id;
+      }
+
+      istream& is_;
+      String filename_;
+      /// number of bytes left in the stream
+      Size remaining_;
+      /// all strings read so far, indexed by their id (a deque does not invalidate references on growth)
+      deque<String> strings_;
+      map<UInt32, AASequence> sequences_;
+      map<UInt32, UInt> meta_indices_;
+    };
+
+    void writeHeader(BinaryWriter& writer, ContentType content)
+    {
+      for (Size i = 0; i < sizeof(MAGIC); ++i)
+      {
+        writer.writeValue(MAGIC[i]);
+      }
+      writer.writeValue(BYTE_ORDER_MARK);
+      writer.writeValue(BinaryDataFile::VERSION);
+      writer.writeValue(static_cast<UInt32>(content));
+    }
+
+    void readHeader(BinaryReader& reader, ContentType content, const String& filename)
+    {
+      char magic[sizeof(MAGIC)];
+      for (Size i = 0; i < sizeof(MAGIC); ++i)
+      {
+        magic[i] = reader.readValue<char>();
+      }
+      if (memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Not a binary OpenMS data file (wrong magic string).", filename);
+      }
+      if (reader.readValue<UInt32>() != BYTE_ORDER_MARK)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Binary file was written on a machine with a different byte order.", filename);
+      }
+      UInt32 version = reader.readValue<UInt32>();
+      if (version > BinaryDataFile::VERSION)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Binary file version " + String(version) + " is newer than the supported version " + String(BinaryDataFile::VERSION) + ".", filename);
+      }
+      if (reader.readValue<UInt32>() != static_cast<UInt32>(content))
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Binary file contains a different kind of data.", filename);
+      }
+    }
+
+    void openForReading(ifstream& is, const String& filename)
+    {
+      is.open(filename.c_str(), ios::in | ios::binary);
+      if (!is)
+      {
+        throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+    }
+
+    void openForWriting(ofstream& os, const String& filename)
+    {
+      os.open(filename.c_str(), ios::out | ios::binary | ios::trunc);
+      if (!os)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+    }
+  }
+
+  const UInt32 BinaryDataFile::VERSION = 1;
+
+  BinaryDataFile::BinaryDataFile()
+  {
+  }
+
+  BinaryDataFile::~BinaryDataFile()
+  {
+  }
+
+  void BinaryDataFile::load(const String& filename, FeatureMap& feature_map)
+  {
+    feature_map.clear(true);
+
+    ifstream is;
+    openForReading(is, filename);
+    BinaryReader reader(is, filename);
+    readHeader(reader, FEATURE_MAP, filename);
+
+    reader.readMapMetaData(feature_map);
+    Size count = reader.readCount(sizeof(UInt32));
+    feature_map.resize(count);
+    startProgress(0, count, "loading binary feature map");
+    for (Size i = 0; i < count; ++i)
+    {
+      setProgress(i);
+      reader.readFeature(feature_map[i]);
+    }
+    endProgress();
+
+    feature_map.setLoadedFilePath(filename);
+    feature_map.setLoadedFileType(filename);
+    feature_map.updateRanges();
+  }
+
+  void BinaryDataFile::store(const String& filename, const FeatureMap& feature_map)
+  {
+    ofstream os;
+    openForWriting(os, filename);
+    BinaryWriter writer(os, filename);
+    writeHeader(writer, FEATURE_MAP);
+
+    writer.writeMapMetaData(feature_map);
+    writer.writeSize(feature_map.size());
+    startProgress(0, feature_map.size(), "storing binary feature map");
+    for (Size i = 0; i < feature_map.size(); ++i)
+    {
+      setProgress(i);
+      writer.writeFeature(feature_map[i]);
+    }
+    writer.finish();
+    endProgress();
+  }
+
+  void BinaryDataFile::load(const String& filename, ConsensusMap& consensus_map)
+  {
+    consensus_map.clear(true);
+
+    ifstream is;
+    openForReading(is, filename);
+    BinaryReader reader(is, filename);
+    readHeader(reader, CONSENSUS_MAP, filename);
+
+    reader.readMapMetaData(consensus_map);
+    Size description_count = reader.readSize();
+    for (Size i = 0; i < description_count; ++i)
+    {
+      UInt64 map_index = reader.readValue<UInt64>();
+      ConsensusMap::FileDescription& description = consensus_map.getFileDescriptions()[map_index];
+      description.filename = reader.readString();
+      description.label = reader.readString();
+      description.size = reader.readValue<UInt64>();
+      description.unique_id = reader.readValue<UInt64>();
+      reader.readMetaInfo(description);
+    }
+    consensus_map.setExperimentType(reader.readString());
+
+    Size count = reader.readCount(sizeof(UInt32));
+    consensus_map.resize(count);
+    startProgress(0, count, "loading binary consensus map");
+    for (Size i = 0; i < count; ++i)
+    {
+      setProgress(i);
+      reader.readConsensusFeature(consensus_map[i]);
+    }
+    endProgress();
+
+    consensus_map.setLoadedFilePath(filename);
+    consensus_map.setLoadedFileType(filename);
+    consensus_map.updateRanges();
+  }
+
+  void BinaryDataFile::store(const String& filename, const ConsensusMap& consensus_map)
+  {
+    ofstream os;
+    openForWriting(os, filename);
+    BinaryWriter writer(os, filename);
+    writeHeader(writer, CONSENSUS_MAP);
+
+    writer.writeMapMetaData(consensus_map);
+    const ConsensusMap::FileDescriptions& descriptions = consensus_map.getFileDescriptions();
+    writer.writeSize(descriptions.size());
+    for (ConsensusMap::FileDescriptions::const_iterator it = descriptions.begin(); it != descriptions.end(); ++it)
+    {
+      writer.writeValue(it->first);
+      writer.writeString(it->second.filename);
+      writer.writeString(it->second.label);
+      writer.writeValue(static_cast<UInt64>(it->second.size));
+      writer.writeValue(it->second.unique_id);
+      writer.writeMetaInfo(it->second);
+    }
+    writer.writeString(consensus_map.getExperimentType());
+
+    writer.writeSize(consensus_map.size());
+    startProgress(0, consensus_map.size(), "storing binary consensus map");
+    for (Size i = 0; i < consensus_map.size(); ++i)
+    {
+      setProgress(i);
+      writer.writeConsensusFeature(consensus_map[i]);
+    }
+    writer.finish();
+    endProgress();
+  }
+
+  void BinaryDataFile::load(const String& filename, vector<ProteinIdentification>& protein_ids, vector<PeptideIdentification>& peptide_ids)
+  {
+    ifstream is;
+    openForReading(is, filename);
+    BinaryReader reader(is, filename);
+    readHeader(reader, IDENTIFICATIONS, filename);
+
+    startProgress(0, 1, "loading binary identifications");
+    reader.readProteinIdentifications(protein_ids);
+    reader.readPeptideIdentifications(peptide_ids);
+    endProgress();
+  }
+
+  void BinaryDataFile::store(const String& filename, const vector<ProteinIdentification>& protein_ids, const vector<PeptideIdentification>& peptide_ids)
+  {
+    ofstream os;
+    openForWriting(os, filename);
+    BinaryWriter writer(os, filename);
+    writeHeader(writer, IDENTIFICATIONS);
+
+    startProgress(0, 1, "storing binary identifications");
+    writer.writeProteinIdentifications(protein_ids);
+    writer.writePeptideIdentifications(peptide_ids);
+    writer.finish();
+    endProgress();
+  }
+
+  FileTypes::Type BinaryDataFile::getFileType(const String& filename)
+  {
+    ifstream is(filename.c_str(), ios::in | ios::binary);
+    char magic[sizeof(MAGIC)];
+    UInt32 byte_order = 0, version = 0, content = 0;
+    is.read(magic, sizeof(MAGIC));
+    is.read(reinterpret_cast<char*>(&byte_order), sizeof(byte_order));
+    is.read(reinterpret_cast<char*>(&version), sizeof(version));
+    is.read(reinterpret_cast<char*>(&content), sizeof(content));
+    if (!is || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || byte_order != BYTE_ORDER_MARK)
+    {
+      return FileTypes::UNKNOWN;
+    }
+    switch (content)
+    {
+    case FEATURE_MAP:
+      return FileTypes::FEATUREBIN;
+
+    case CONSENSUS_MAP:
+      return FileTypes::CONSENSUSBIN;
+
+    case IDENTIFICATIONS:
+      return FileTypes::IDBIN;
+
+    default:
+      return FileTypes::UNKNOWN;
+    }
+  }
+
+} // namespace OpenMS
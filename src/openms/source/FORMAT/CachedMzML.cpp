@@ -204,6 +204,14 @@ namespace OpenMS
   }
 
   void CachedmzML::writeMetadata(MapType exp, String out_meta, bool addCacheMetaValue)
+  {
+    createMetadata(exp, addCacheMetaValue);
+
+    // store the meta data using the regular MzMLFile
+    MzMLFile().store(out_meta, exp);
+  }
+
+  void CachedmzML::createMetadata(MapType& exp, bool addCacheMetaValue)
   {
     // delete the actual data for all spectra and chromatograms, leave only metadata
     // TODO : remove copy
@@ -237,9 +245,6 @@ namespace OpenMS
       }
       exp.setChromatograms(l_chromatograms);
     }
-
-    // store the meta data using the regular MzMLFile
-    MzMLFile().store(out_meta, exp);
   }
 
   void CachedmzML::readSpectrum_(Datavector& data1, Datavector& data2, std::ifstream& ifs, int& ms_level, double& rt) const
@@ -36,6 +36,9 @@
 #include <OpenMS/FORMAT/TextFile.h>
 #include <OpenMS/FORMAT/GzipIfstream.h>
 #include <OpenMS/FORMAT/Bzip2Ifstream.h>
+#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/FORMAT/MzIdentMLFile.h>
 
 #include <QFile>
 #include <QCryptographicHash>
@@ -104,6 +107,19 @@ namespace OpenMS
 
   FileTypes::Type FileHandler::getTypeByContent(const String& filename)
   {
+    // binary OpenMS files carry their type in the header (only probed if the
+    // extension does not name another format, so other files are not opened twice)
+    FileTypes::Type name_type = getTypeByFileName(filename);
+    if (name_type == FileTypes::UNKNOWN || name_type == FileTypes::FEATUREBIN ||
+        name_type == FileTypes::CONSENSUSBIN || name_type == FileTypes::IDBIN)
+    {
+      FileTypes::Type binary_type = BinaryDataFile::getFileType(filename);
+      if (binary_type != FileTypes::UNKNOWN)
+      {
+        return binary_type;
+      }
+    }
+
     String first_line;
     String two_five;
     String all_simple;
@@ -480,6 +496,10 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     {
       FeatureXMLFile().load(filename, map);
     }
+    else if (type == FileTypes::FEATUREBIN)
+    {
+      BinaryDataFile().load(filename, map);
+    }
     else if (type == FileTypes::TSV)
     {
       MsInspectFile().load(filename, map);
@@ -500,4 +520,143 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     return true;
   }
 
+  bool FileHandler::storeFeatures(const String& filename, const FeatureMap& map)
+  {
+    FileTypes::Type type = getTypeByFileName(filename);
+    if (type == FileTypes::FEATUREXML)
+    {
+      FeatureXMLFile().store(filename, map);
+    }
+    else if (type == FileTypes::FEATUREBIN)
+    {
+      BinaryDataFile().store(filename, map);
+    }
+    else
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  bool FileHandler::loadConsensusFeatures(const String& filename, ConsensusMap& map, FileTypes::Type force_type)
+  {
+    //determine file type
+    FileTypes::Type type;
+    if (force_type != FileTypes::UNKNOWN)
+    {
+      type = force_type;
+    }
+    else
+    {
+      try
+      {
+        type = getType(filename);
+      }
+      catch (Exception::FileNotFound)
+      {
+        return false;
+      }
+    }
+
+    //load right file
+    if (type == FileTypes::CONSENSUSXML)
+    {
+      ConsensusXMLFile().load(filename, map);
+    }
+    else if (type == FileTypes::CONSENSUSBIN)
+    {
+      BinaryDataFile().load(filename, map);
+    }
+    else
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  bool FileHandler::storeConsensusFeatures(const String& filename, const ConsensusMap& map)
+  {
+    FileTypes::Type type = getTypeByFileName(filename);
+    if (type == FileTypes::CONSENSUSXML)
+    {
+      ConsensusXMLFile().store(filename, map);
+    }
+    else if (type == FileTypes::CONSENSUSBIN)
+    {
+      BinaryDataFile().store(filename, map);
+    }
+    else
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  bool FileHandler::loadIdentifications(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids, FileTypes::Type force_type)
+  {
+    //determine file type
+    FileTypes::Type type;
+    if (force_type != FileTypes::UNKNOWN)
+    {
+      type = force_type;
+    }
+    else
+    {
+      try
+      {
+        type = getType(filename);
+      }
+      catch (Exception::FileNotFound)
+      {
+        return false;
+      }
+    }
+
+    //load right file
+    if (type == FileTypes::IDXML)
+    {
+      IdXMLFile().load(filename, protein_ids, peptide_ids);
+    }
+    else if (type == FileTypes::MZIDENTML)
+    {
+      MzIdentMLFile().load(filename, protein_ids, peptide_ids);
+    }
+    else if (type == FileTypes::IDBIN)
+    {
+      BinaryDataFile().load(filename, protein_ids, peptide_ids);
+    }
+    else
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  bool FileHandler::storeIdentifications(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids)
+  {
+    FileTypes::Type type = getTypeByFileName(filename);
+    if (type == FileTypes::IDXML)
+    {
+      IdXMLFile().store(filename, protein_ids, peptide_ids);
+    }
+    else if (type == FileTypes::MZIDENTML)
+    {
+      MzIdentMLFile().store(filename, protein_ids, peptide_ids);
+    }
+    else if (type == FileTypes::IDBIN)
+    {
+      BinaryDataFile().store(filename, protein_ids, peptide_ids);
+    }
+    else
+    {
+      return false;
+    }
+
+    return true;
+  }
+
 } // namespace OpenMS
@@ -130,6 +130,10 @@ namespace OpenMS
     targetMap[FileTypes::PSQ] = "psq";
     targetMap[FileTypes::MRM] = "mrm";
     targetMap[FileTypes::PSMS] = "psms";
+    targetMap[FileTypes::OSLIB] = "oslib";
+    targetMap[FileTypes::FEATUREBIN] = "featureBin";
+    targetMap[FileTypes::CONSENSUSBIN] = "consensusBin";
+    targetMap[FileTypes::IDBIN] = "idBin";
 
     return targetMap;
   }
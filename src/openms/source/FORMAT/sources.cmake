@@ -4,6 +4,7 @@ set(directory source/FORMAT)
 ### list all filenames of the directory here
 set(sources_list
 Base64.cpp
+BinaryDataFile.cpp
 Bzip2Ifstream.cpp
 Bzip2InputStream.cpp
 CachedMzML.cpp
@@ -0,0 +1,303 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/SYSTEM/Profiler.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/SYSTEM/SysInfo.h>
+
+#include <fstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// Returns @p s as quoted JSON string
+    String jsonString(const String& s)
+    {
+      String result = "\"";
+      for (String::const_iterator it = s.begin(); it != s.end(); ++it)
+      {
+        switch (*it)
+        {
+          case '"': result += "\\\""; break;
+          case '\\': result += "\\\\"; break;
+          case '\n': result += "\\n"; break;
+          case '\r': result += "\\r"; break;
+          case '\t': result += "\\t"; break;
+          default:
+            if ((unsigned char)*it < 0x20)
+            {
+              const char* hex = "0123456789abcdef";
+              result += "\\u00";
+              result += hex[(unsigned char)*it >> 4];
+              result += hex[(unsigned char)*it & 0xf];
+            }
+            else
+            {
+              result += *it;
+            }
+        }
+      }
+      return result + "\"";
+    }
+
+    /// Returns the share of @p threads that was used on average (null if undefined)
+    String utilization(double cpu_time, double wall_time, Int threads)
+    {
+      if (wall_time <= 0.0 || threads < 1) return "null";
+      return String(cpu_time / (wall_time * threads));
+    }
+
+    /// Returns if phases can be recorded by the calling thread (i.e. it is not in a parallel region)
+    bool recordsPhases()
+    {
+#ifdef _OPENMP
+      return !omp_in_parallel();
+#else
+      return true;
+#endif
+    }
+  }
+
+  bool Profiler::enabled_ = false;
+  std::vector<Profiler::OpenPhase_> Profiler::open_phases_;
+  std::map<String, Profiler::PhaseStatistics> Profiler::phases_;
+  std::map<String, UInt64> Profiler::counters_;
+
+  Profiler::PhaseStatistics::PhaseStatistics() :
+    calls(0),
+    wall_time(0.0),
+    cpu_time(0.0)
+  {
+  }
+
+  Profiler::ScopedPhase::ScopedPhase(const String& name) :
+    active_(Profiler::isEnabled())
+  {
+    if (active_) Profiler::startPhase(name);
+  }
+
+  Profiler::ScopedPhase::~ScopedPhase()
+  {
+    if (active_) Profiler::endPhase();
+  }
+
+  Profiler::ScopedReport::ScopedReport(const String& filename, const String& tool_name, Int threads) :
+    filename_(filename),
+    tool_name_(tool_name),
+    threads_(threads),
+    exit_code_(-1)
+  {
+    if (filename_.empty()) return;
+
+    Profiler::clear();
+    Profiler::setEnabled(true);
+    total_time_.start();
+  }
+
+  Profiler::ScopedReport::~ScopedReport()
+  {
+    if (filename_.empty()) return;
+
+    total_time_.stop();
+    Profiler::setEnabled(false);
+    // do not throw from the destructor (the scope may be left by an exception)
+    try
+    {
+      Profiler::writeReport(filename_, tool_name_, exit_code_, total_time_, threads_);
+    }
+    catch (Exception::BaseException& e)
+    {
+      LOG_ERROR << "Error: Unable to write the profiling report (" << e.what() << ")" << std::endl;
+    }
+  }
+
+  void Profiler::ScopedReport::setExitCode(Int exit_code)
+  {
+    exit_code_ = exit_code;
+  }
+
+  void Profiler::setEnabled(bool enabled)
+  {
+    enabled_ = enabled;
+  }
+
+  bool Profiler::isEnabled()
+  {
+    return enabled_;
+  }
+
+  void Profiler::startPhase(const String& name)
+  {
+    if (!enabled_ || !recordsPhases()) return;
+
+#ifdef _OPENMP
+#pragma omp critical (Profiler)
+#endif
+    {
+      open_phases_.push_back(OpenPhase_());
+      open_phases_.back().name = name;
+      open_phases_.back().watch.start();
+    }
+  }
+
+  void Profiler::endPhase()
+  {
+    if (!enabled_ || !recordsPhases()) return;
+
+#ifdef _OPENMP
+#pragma omp critical (Profiler)
+#endif
+    {
+      // phases started before profiling was enabled are not on the stack
+      if (!open_phases_.empty())
+      {
+        OpenPhase_& phase = open_phases_.back();
+        phase.watch.stop();
+        PhaseStatistics& stats = phases_[phase.name];
+        ++stats.calls;
+        stats.wall_time += phase.watch.getClockTime();
+        stats.cpu_time += phase.watch.getCPUTime();
+        open_phases_.pop_back();
+      }
+    }
+  }
+
+  void Profiler::addCount(const String& name, UInt64 count)
+  {
+    if (!enabled_) return;
+
+#ifdef _OPENMP
+#pragma omp critical (Profiler)
+#endif
+    counters_[name] += count;
+  }
+
+  std::map<String, Profiler::PhaseStatistics> Profiler::getPhases()
+  {
+    std::map<String, PhaseStatistics> result;
+#ifdef _OPENMP
+#pragma omp critical (Profiler)
+#endif
+    result = phases_;
+    return result;
+  }
+
+  std::map<String, UInt64> Profiler::getCounters()
+  {
+    std::map<String, UInt64> result;
+#ifdef _OPENMP
+#pragma omp critical (Profiler)
+#endif
+    result = counters_;
+    return result;
+  }
+
+  void Profiler::clear()
+  {
+#ifdef _OPENMP
+#pragma omp critical (Profiler)
+#endif
+    {
+      open_phases_.clear();
+      phases_.clear();
+      counters_.clear();
+    }
+  }
+
+  void Profiler::writeReport(const String& filename, const String& tool_name, Int exit_code, const StopWatch& total_time, Int threads)
+  {
+    ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    size_t peak_memory;
+    bool has_memory = SysInfo::getProcessPeakMemoryConsumption(peak_memory);
+    UInt64 bytes_read, bytes_written;
+    bool has_io = SysInfo::getProcessIOStatistics(bytes_read, bytes_written);
+
+    os << "{\n";
+    os << "  \"tool\": " << jsonString(tool_name) << ",\n";
+    os << "  \"exit_code\": ";
+    if (exit_code >= 0) os << exit_code; else os << "null";
+    os << ",\n";
+    os << "  \"threads\": " << threads << ",\n";
+    os << "  \"wall_time\": " << total_time.getClockTime() << ",\n";
+    os << "  \"cpu_time\": " << total_time.getCPUTime() << ",\n";
+    os << "  \"thread_utilization\": " << utilization(total_time.getCPUTime(), total_time.getClockTime(), threads) << ",\n";
+    os << "  \"peak_memory_kb\": ";
+    if (has_memory) os << peak_memory; else os << "null";
+    os << ",\n";
+    os << "  \"bytes_read\": ";
+    if (has_io) os << bytes_read; else os << "null";
+    os << ",\n";
+    os << "  \"bytes_written\": ";
+    if (has_io) os << bytes_written; else os << "null";
+    os << ",\n";
+
+    std::map<String, PhaseStatistics> phases = getPhases();
+    os << "  \"phases\": [";
+    for (std::map<String, PhaseStatistics>::const_iterator it = phases.begin(); it != phases.end(); ++it)
+    {
+      os << (it == phases.begin() ? "\n" : ",\n");
+      os << "    {\"name\": " << jsonString(it->first)
+         << ", \"calls\": " << it->second.calls
+         << ", \"wall_time\": " << it->second.wall_time
+         << ", \"cpu_time\": " << it->second.cpu_time
+         << ", \"thread_utilization\": " << utilization(it->second.cpu_time, it->second.wall_time, threads) << "}";
+    }
+    os << (phases.empty() ? "],\n" : "\n  ],\n");
+
+    std::map<String, UInt64> counters = getCounters();
+    os << "  \"counters\": {";
+    for (std::map<String, UInt64>::const_iterator it = counters.begin(); it != counters.end(); ++it)
+    {
+      os << (it == counters.begin() ? "\n" : ",\n");
+      os << "    " << jsonString(it->first) << ": " << it->second;
+    }
+    os << (counters.empty() ? "}\n" : "\n  }\n");
+    os << "}\n";
+  }
+
+} // namespace OpenMS
@@ -40,8 +40,10 @@
 #elif __APPLE__
 #include <mach/mach.h>
 #include <mach/mach_init.h>
+#include <sys/resource.h>
 #else
 #include <cstdio>
+#include <cstring>
 #include <unistd.h>
 #include <stdlib.h>
 #define OMS_USELINUXMEMORYPLATFORM
@@ -96,6 +98,30 @@ namespace OpenMS
     fclose(f);
     return true;
   }
+
+  // reads the value of a 'key: value' line from a file in /proc/self/
+  bool read_proc_value_linux(const char* path, const char* key, unsigned long long& value)
+  {
+    FILE *f = fopen(path, "r");
+    if (!f)
+    {
+      return false;
+    }
+
+    bool found = false;
+    size_t key_length = strlen(key);
+    char line[256];
+    while (fgets(line, sizeof(line), f))
+    {
+      if (strncmp(line, key, key_length) == 0 && line[key_length] == ':')
+      {
+        found = (1 == sscanf(line + key_length + 1, "%llu", &value));
+        break;
+      }
+    }
+    fclose(f);
+    return found;
+  }
 #endif
 
   bool SysInfo::getProcessMemoryConsumption(size_t& mem_virtual)
@@ -130,4 +156,59 @@ namespace OpenMS
     return true;
   }
 
+  bool SysInfo::getProcessPeakMemoryConsumption(size_t& mem_peak)
+  {
+    mem_peak = 0;
+#ifdef OPENMS_WINDOWSPLATFORM
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    {
+      return false;
+    }
+    mem_peak = pmc.PeakWorkingSetSize / 1024; // byte to KB
+#elif __APPLE__
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+      return false;
+    }
+    mem_peak = usage.ru_maxrss / 1024; // byte to KB
+#else // Linux
+    unsigned long long hwm;
+    if (!read_proc_value_linux("/proc/self/status", "VmHWM", hwm))
+    {
+      return false;
+    }
+    mem_peak = (size_t)hwm; // already in KB
+#endif
+    return true;
+  }
+
+  bool SysInfo::getProcessIOStatistics(UInt64& bytes_read, UInt64& bytes_written)
+  {
+    bytes_read = 0;
+    bytes_written = 0;
+#ifdef OPENMS_WINDOWSPLATFORM
+    IO_COUNTERS io;
+    if (!GetProcessIoCounters(GetCurrentProcess(), &io))
+    {
+      return false;
+    }
+    bytes_read = io.ReadTransferCount;
+    bytes_written = io.WriteTransferCount;
+#elif __APPLE__
+    return false;
+#else // Linux
+    unsigned long long rchar, wchar;
+    if (!read_proc_value_linux("/proc/self/io", "rchar", rchar) ||
+        !read_proc_value_linux("/proc/self/io", "wchar", wchar))
+    {
+      return false;
+    }
+    bytes_read = rchar;
+    bytes_written = wchar;
+#endif
+    return true;
+  }
+
 } // namespace OpenMS
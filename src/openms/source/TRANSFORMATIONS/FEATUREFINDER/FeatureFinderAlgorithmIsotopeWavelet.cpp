@@ -204,19 +204,21 @@ namespace OpenMS
       if (!hr_data_)                   //LowRes data
       {
         iwt->initializeScan((*this->map_)[i]);
-        for (UInt c = 0; c < max_charge_; ++c)
-        {
-          MSSpectrum<PeakType> c_trans(c_ref);
 
-          iwt->getTransform(c_trans, c_ref, c);
+        // the transforms of all charge states only depend on the scan, compute them together
+        std::vector<MSSpectrum<PeakType> > c_trans(max_charge_, c_ref);
+        iwt->getTransforms(c_trans, c_ref);
 
+        // the charge recognition updates the boxes and has to see the charge states in order
+        for (UInt c = 0; c < max_charge_; ++c)
+        {
 #ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
           std::stringstream stream;
           stream << "cpu_lowres_" << c_ref.getRT() << "_" << c + 1 << ".trans\0";
           std::ofstream ofile(stream.str().c_str());
           for (UInt k = 0; k < c_ref.size(); ++k)
           {
-            ofile << ::std::setprecision(8) << std::fixed << c_trans[k].getMZ() << "\t" << c_trans[k].getIntensity() << "\t" << c_ref[k].getIntensity() << std::endl;
+            ofile << ::std::setprecision(8) << std::fixed << c_trans[c][k].getMZ() << "\t" << c_trans[c][k].getIntensity() << "\t" << c_ref[k].getIntensity() << std::endl;
           }
           ofile.close();
 #endif
@@ -226,7 +228,7 @@ namespace OpenMS
 #endif
           this->ff_->setProgress(++progress_counter_);
 
-          iwt->identifyCharge(c_trans, c_ref, i, c, intensity_threshold_, check_PPMs_);
+          iwt->identifyCharge(c_trans[c], c_ref, i, c, intensity_threshold_, check_PPMs_);
 
 #ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
           std::cout << "charge recognition O.K. ... "; std::cout.flush();
@@ -236,13 +238,20 @@ namespace OpenMS
       }
       else                   //HighRes data
       {
+        // the interpolated scan does not depend on the charge state
+        MSSpectrum<PeakType>* new_spec = createHRData(i);
+
+        // the transforms only use the charge independent part of the scan initialization
+        iwt->initializeScan(*new_spec);
+        std::vector<MSSpectrum<PeakType> > c_trans(max_charge_, *new_spec);
+        iwt->getTransforms(c_trans, *new_spec, true);
+
         for (UInt c = 0; c < max_charge_; ++c)
         {
-          MSSpectrum<PeakType>* new_spec = createHRData(i);
-          iwt->initializeScan(*new_spec, c);
-          MSSpectrum<PeakType> c_trans(*new_spec);
-
-          iwt->getTransformHighRes(c_trans, *new_spec, c);
+          if (c > 0)
+          {
+            iwt->initializeScan(*new_spec, c);
+          }
 
 #ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
           std::stringstream stream;
@@ -250,7 +259,7 @@ namespace OpenMS
           std::ofstream ofile(stream.str().c_str());
           for (UInt k = 0; k < new_spec->size(); ++k)
           {
-            ofile << ::std::setprecision(8) << std::fixed << c_trans[k].getMZ() << "\t" << c_trans[k].getIntensity() << "\t" << (*new_spec)[k].getIntensity() << std::endl;
+            ofile << ::std::setprecision(8) << std::fixed << c_trans[c][k].getMZ() << "\t" << c_trans[c][k].getIntensity() << "\t" << (*new_spec)[k].getIntensity() << std::endl;
           }
           ofile.close();
 #endif
@@ -260,15 +269,14 @@ namespace OpenMS
 #endif
           this->ff_->setProgress(++progress_counter_);
 
-          iwt->identifyCharge(c_trans, *new_spec, i, c, intensity_threshold_, check_PPMs_);
+          iwt->identifyCharge(c_trans[c], *new_spec, i, c, intensity_threshold_, check_PPMs_);
 
 #ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
           std::cout << "charge recognition O.K. ... "; std::cout.flush();
 #endif
           this->ff_->setProgress(++progress_counter_);
-
-          delete (new_spec); new_spec = NULL;
         }
+        delete (new_spec); new_spec = NULL;
       }
 
 
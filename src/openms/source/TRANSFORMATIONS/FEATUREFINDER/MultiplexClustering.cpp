@@ -186,18 +186,26 @@ namespace OpenMS
     unsigned progress = 0;
     startProgress(0, filter_results.size(), "clustering filtered LC-MS data");
       
-    std::vector<std::map<int, GridBasedCluster> > cluster_results;
+    std::vector<std::map<int, GridBasedCluster> > cluster_results(filter_results.size());
 
     // loop over patterns i.e. cluster each of the corresponding filter results
-    for (unsigned i = 0; i < filter_results.size(); ++i)
+    // (the patterns are independent of each other)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)filter_results.size(); ++i)
     {
-      setProgress(++progress);
-        
+      IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++progress;
+
       GridBasedClustering<MultiplexDistance> clustering(MultiplexDistance(rt_scaling_), filter_results[i].getMZ(), filter_results[i].getRT(), grid_spacing_mz_, grid_spacing_rt_);
       clustering.cluster();
       //clustering.extendClustersY();
       clustering.removeSmallClustersY(rt_minimum_);
-      cluster_results.push_back(clustering.getResults());
+      cluster_results[i] = clustering.getResults();
     }
 
     endProgress();
@@ -51,8 +51,14 @@
 #include <iostream>
 #include <QDir>
 
+#include <boost/shared_ptr.hpp>
+
 #include <QDir>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace boost::math;
 
@@ -132,194 +138,308 @@ namespace OpenMS
     startProgress(0, patterns_.size() * exp_profile_.size(), "filtering LC-MS data");
 
     // list of filter results for each peak pattern
-    vector<MultiplexFilterResult> filter_results;
+    vector<MultiplexFilterResult> filter_results(patterns_.size());
+
+    if (patterns_.empty())
+    {
+      endProgress();
+      return filter_results;
+    }
+
+    // Peaks blacklisted by one pattern are excluded from the following patterns. Blacklisting reaches two spectra to
+    // each side, so pattern p can filter spectrum s as soon as pattern p-1 is done with spectrum s+4. Each step below
+    // filters spectrum s with pattern 0, spectrum s-5 with pattern 1 and so on. The blacklist is accessed in the same
+    // order as when filtering pattern after pattern, but the spline of a spectrum is only needed for a few steps and
+    // is freed together with its intensities once the last pattern is done.
+    const int lag = 5;
+    const int nr_patterns = (int) patterns_.size();
+    const int nr_spectra = (int) exp_profile_.size();
+    vector<SplineIntensities> splines(nr_spectra);
+
+    // the splines are fitted in parallel in blocks of spectra ahead of the first pattern
+    int block_size = 1;
+#ifdef _OPENMP
+    block_size = 4 * omp_get_max_threads();
+#endif
+    int fitted = 0;
+
+    for (int step = 0; step < nr_spectra + lag * (nr_patterns - 1); ++step)
+    {
+      if (step == fitted && fitted < nr_spectra)
+      {
+        fitted = std::min(fitted + block_size, nr_spectra);
+        fitSplines_(splines, step, fitted);
+      }
+
+      for (int pattern = 0; pattern < nr_patterns; ++pattern)
+      {
+        int spectrum = step - lag * pattern; // index of the spectrum in exp_profile_, exp_picked_ and boundaries_
+        if (spectrum < 0)
+        {
+          break;
+        }
+        if (spectrum >= nr_spectra)
+        {
+          continue;
+        }
+
+        filterSpectrum_(pattern, spectrum, splines[spectrum], filter_results[pattern], progress);
+
+        if (pattern == nr_patterns - 1)
+        {
+          // the spectrum is done, free its spline and intensities
+          splines[spectrum] = SplineIntensities();
+        }
+      }
+    }
+
+    endProgress();
+
+    return filter_results;
+  }
+
+  void MultiplexFilteringProfile::fitSplines_(vector<SplineIntensities>& splines, int begin, int end)
+  {
+    // exceptions must not leave the parallel region, a fit that failed is repeated in filterSpectrum_() to throw it
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int spectrum = begin; spectrum < end; ++spectrum)
+    {
+      if (exp_profile_[spectrum].size() == 0 || exp_picked_[spectrum].size() == 0 || boundaries_[spectrum].size() == 0)
+      {
+        continue;
+      }
+      try
+      {
+        splines[spectrum].spline = boost::shared_ptr<SplineSpectrum>(new SplineSpectrum(exp_profile_[spectrum]));
+      }
+      catch (Exception::BaseException&)
+      {
+        splines[spectrum].spline.reset();
+      }
+      catch (std::exception&)
+      {
+        splines[spectrum].spline.reset();
+      }
+    }
+  }
+
+  const vector<double>& MultiplexFilteringProfile::getMzGrid_(SplineIntensities& spline, SplineSpectrum::Navigator& nav, int peak) const
+  {
+    vector<double>& mz_grid = spline.mz_grid[peak];
+    if (mz_grid.empty())
+    {
+      for (double mz = spline.peak_min[peak]; mz < spline.peak_max[peak]; mz = nav.getNextMz(mz))
+      {
+        mz_grid.push_back(mz);
+      }
+    }
+    return mz_grid;
+  }
+
+  const vector<double>& MultiplexFilteringProfile::getShiftedIntensities_(SplineIntensities& spline, SplineSpectrum::Navigator& nav, int peak, int shifted_peak) const
+  {
+    std::map<std::pair<int, int>, std::vector<double> >::iterator it = spline.intensities.find(std::make_pair(peak, shifted_peak));
+    if (it == spline.intensities.end())
+    {
+      it = spline.intensities.insert(std::make_pair(std::make_pair(peak, shifted_peak), std::vector<double>())).first;
+      const vector<double>& mz_grid = getMzGrid_(spline, nav, peak);
+      double mz_shift = spline.peak_position[shifted_peak] - spline.peak_position[peak];
+      it->second.reserve(mz_grid.size());
+      for (Size i = 0; i < mz_grid.size(); ++i)
+      {
+        it->second.push_back(nav.eval(mz_grid[i] + mz_shift));
+      }
+    }
+    return it->second;
+  }
 
-    // loop over patterns
-    for (unsigned pattern = 0; pattern < patterns_.size(); ++pattern)
+  void MultiplexFilteringProfile::filterSpectrum_(int pattern, int spectrum, SplineIntensities& spline, MultiplexFilterResult& result, unsigned& progress)
+  {
+    const MSSpectrum<Peak1D>& spectrum_profile = exp_profile_[spectrum];
+    const MSSpectrum<Peak1D>& spectrum_picked = exp_picked_[spectrum];
+    const vector<PeakPickerHiRes::PeakBoundary>& spectrum_boundaries = boundaries_[spectrum];
+
+    // skip empty spectra
+    if (spectrum_profile.size() == 0 || spectrum_picked.size() == 0 || spectrum_boundaries.size() == 0)
+    {
+      return;
+    }
+
+    if (spectrum_picked.size() != spectrum_boundaries.size())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Number of peaks and number of peak boundaries differ.");
+    }
+
+    setProgress(++progress);
+
+    double rt_picked = spectrum_picked.getRT();
+
+    // spline fit profile data (only if the parallel fit failed, to throw its exception here)
+    if (!spline.spline)
+    {
+      spline.spline = boost::shared_ptr<SplineSpectrum>(new SplineSpectrum(exp_profile_[spectrum]));
+    }
+    SplineSpectrum::Navigator nav = spline.spline->getNavigator();
+
+    // vectors of peak details
+    if (spline.peak_position.empty())
+    {
+      MSSpectrum<Peak1D>::ConstIterator it_mz;
+      vector<PeakPickerHiRes::PeakBoundary>::const_iterator it_mz_boundary;
+      for (it_mz = spectrum_picked.begin(), it_mz_boundary = spectrum_boundaries.begin();
+           it_mz < spectrum_picked.end() && it_mz_boundary < spectrum_boundaries.end();
+           ++it_mz, ++it_mz_boundary)
+      {
+        spline.peak_position.push_back(it_mz->getMZ());
+        spline.peak_min.push_back((*it_mz_boundary).mz_min);
+        spline.peak_max.push_back((*it_mz_boundary).mz_max);
+        spline.peak_intensity.push_back(it_mz->getIntensity());
+      }
+      spline.mz_grid.resize(spline.peak_position.size());
+    }
+    const vector<double>& peak_position = spline.peak_position;
+    const vector<double>& peak_intensity = spline.peak_intensity;
+
+    // iterate over peaks in spectrum (mz)
+    for (unsigned peak = 0; peak < peak_position.size(); ++peak)
     {
-      // data structure storing peaks which pass all filters
-      MultiplexFilterResult result;
-
-      // iterate over spectra
-      MSExperiment<Peak1D>::Iterator it_rt_profile;
-      MSExperiment<Peak1D>::ConstIterator it_rt_picked;
-      vector<vector<PeakPickerHiRes::PeakBoundary> >::const_iterator it_rt_boundaries;
-      for (it_rt_profile = exp_profile_.begin(), it_rt_picked = exp_picked_.begin(), it_rt_boundaries = boundaries_.begin();
-           it_rt_profile < exp_profile_.end() && it_rt_picked < exp_picked_.end() && it_rt_boundaries < boundaries_.end();
-           ++it_rt_profile, ++it_rt_picked, ++it_rt_boundaries)
+
+      /**
+       * Filter (1): m/z position and blacklist filter
+       * Are there non-black peaks with the expected relative m/z shifts?
+       */
+      vector<double> mz_shifts_actual; // actual m/z shifts (differ slightly from expected m/z shifts)
+      vector<int> mz_shifts_actual_indices; // peak indices in the spectrum corresponding to the actual m/z shifts
+
+      mz_shifts_actual.reserve(patterns_[pattern].getMZShiftCount());
+      mz_shifts_actual_indices.reserve(patterns_[pattern].getMZShiftCount());
+
+      int peaks_found_in_all_peptides = positionsAndBlacklistFilter_(patterns_[pattern], spectrum, peak_position, peak, mz_shifts_actual, mz_shifts_actual_indices);
+      if (peaks_found_in_all_peptides < peaks_per_peptide_min_)
       {
-        // skip empty spectra
-        if ((*it_rt_profile).size() == 0 || (*it_rt_picked).size() == 0 || (*it_rt_boundaries).size() == 0)
+        continue;
+      }
+
+      /**
+       * Filter (2): blunt intensity filter
+       * Are the mono-isotopic peak intensities of all peptides above the cutoff?
+       */
+      bool bluntVeto = monoIsotopicPeakIntensityFilter_(patterns_[pattern], spectrum, mz_shifts_actual_indices);
+      if (bluntVeto)
+      {
+        continue;
+      }
+
+      // Arrangement of peaks looks promising. Now scan through the spline fitted data.
+      // (The spline intensities at the positions of the pattern are shared by all patterns.)
+      const vector<double>& mz_grid = getMzGrid_(spline, nav, peak);
+      vector<const vector<double>*> shifted_intensities(mz_shifts_actual_indices.size(), static_cast<const vector<double>*>(0));
+      for (unsigned i = 0; i < mz_shifts_actual_indices.size(); ++i)
+      {
+        if (mz_shifts_actual_indices[i] != -1)
+        {
+          shifted_intensities[i] = &getShiftedIntensities_(spline, nav, peak, mz_shifts_actual_indices[i]);
+        }
+      }
+
+      vector<MultiplexFilterResultRaw> results_raw; // raw data points of this peak that will pass the remaining filters
+      bool blacklisted = false; // Has this peak already been blacklisted?
+      for (Size mz_index = 0; mz_index < mz_grid.size(); ++mz_index)
+      {
+        double mz = mz_grid[mz_index];
+
+        /**
+         * Filter (3): non-local intensity filter
+         * Are the spline interpolated intensities at m/z above the threshold?
+         */
+        vector<double> intensities_actual; // spline interpolated intensities @ m/z + actual m/z shift
+        int peaks_found_in_all_peptides_spline = nonLocalIntensityFilter_(patterns_[pattern], shifted_intensities, mz_index, intensities_actual, peaks_found_in_all_peptides);
+        if (peaks_found_in_all_peptides_spline < peaks_per_peptide_min_)
         {
           continue;
         }
-        
-        if ((*it_rt_picked).size() != (*it_rt_boundaries).size())
+
+        /**
+         * Filter (4): zeroth peak filter
+         * There should not be a significant peak to the left of the mono-isotopic
+         * (i.e. first) peak.
+         */
+        bool zero_peak = zerothPeakFilter_(patterns_[pattern], intensities_actual);
+        if (zero_peak)
         {
-          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Number of peaks and number of peak boundaries differ.");
+          continue;
         }
 
-        setProgress(++progress);
-
-        int spectrum = it_rt_profile - exp_profile_.begin(); // index of the spectrum in exp_profile_, exp_picked_ and boundaries_
-        double rt_picked = it_rt_picked->getRT();
-
-        // spline fit profile data
-        SplineSpectrum spline(*it_rt_profile);
-        SplineSpectrum::Navigator nav = spline.getNavigator();
-
-        // vectors of peak details
-        vector<double> peak_position;
-        vector<double> peak_min;
-        vector<double> peak_max;
-        vector<double> peak_intensity;
-        MSSpectrum<Peak1D>::ConstIterator it_mz;
-        vector<PeakPickerHiRes::PeakBoundary>::const_iterator it_mz_boundary;
-        for (it_mz = it_rt_picked->begin(), it_mz_boundary = it_rt_boundaries->begin();
-             it_mz < it_rt_picked->end() && it_mz_boundary < it_rt_boundaries->end();
-             ++it_mz, ++it_mz_boundary)
+        /**
+         * Filter (5): peptide similarity filter
+         * How similar are the isotope patterns of the peptides?
+         */
+        bool peptide_similarity = peptideSimilarityFilter_(patterns_[pattern], intensities_actual, peaks_found_in_all_peptides_spline);
+        if (!peptide_similarity)
         {
-          peak_position.push_back(it_mz->getMZ());
-          peak_min.push_back((*it_mz_boundary).mz_min);
-          peak_max.push_back((*it_mz_boundary).mz_max);
-          peak_intensity.push_back(it_mz->getIntensity());
+          continue;
         }
 
-        // iterate over peaks in spectrum (mz)
-        for (unsigned peak = 0; peak < peak_position.size(); ++peak)
+        /**
+         * Filter (6): averagine similarity filter
+         * Does each individual isotope pattern resemble a peptide?
+         */
+        bool averagine_similarity = averagineSimilarityFilter_(patterns_[pattern], intensities_actual, peaks_found_in_all_peptides_spline, mz);
+        if (!averagine_similarity)
         {
+          continue;
+        }
 
-          /**
-           * Filter (1): m/z position and blacklist filter
-           * Are there non-black peaks with the expected relative m/z shifts?
-           */
-          vector<double> mz_shifts_actual; // actual m/z shifts (differ slightly from expected m/z shifts)
-          vector<int> mz_shifts_actual_indices; // peak indices in the spectrum corresponding to the actual m/z shifts
-          
-          mz_shifts_actual.reserve(patterns_[pattern].getMZShiftCount());
-          mz_shifts_actual_indices.reserve(patterns_[pattern].getMZShiftCount());
-          
-          int peaks_found_in_all_peptides = positionsAndBlacklistFilter_(patterns_[pattern], spectrum, peak_position, peak, mz_shifts_actual, mz_shifts_actual_indices);
-          if (peaks_found_in_all_peptides < peaks_per_peptide_min_)
-          {
-            continue;
-          }
+        /**
+         * All filters passed.
+         */
+        // add raw data point to list that passed all filters
+        MultiplexFilterResultRaw result_raw(mz, mz_shifts_actual, intensities_actual);
+        results_raw.push_back(result_raw);
 
-          /**
-           * Filter (2): blunt intensity filter
-           * Are the mono-isotopic peak intensities of all peptides above the cutoff?
-           */
-          bool bluntVeto = monoIsotopicPeakIntensityFilter_(patterns_[pattern], spectrum, mz_shifts_actual_indices);
-          if (bluntVeto)
-          {
-            continue;
-          }
+        // blacklist peaks in the current spectrum and the two neighbouring ones
+        if (!blacklisted)
+        {
+          blacklistPeaks_(patterns_[pattern], spectrum, mz_shifts_actual_indices, peaks_found_in_all_peptides_spline);
+          blacklisted = true;
+        }
 
-          // Arrangement of peaks looks promising. Now scan through the spline fitted data.
-          vector<MultiplexFilterResultRaw> results_raw; // raw data points of this peak that will pass the remaining filters
-          bool blacklisted = false; // Has this peak already been blacklisted?
-          for (double mz = peak_min[peak]; mz < peak_max[peak]; mz = nav.getNextMz(mz))
-          {
-            /**
-             * Filter (3): non-local intensity filter
-             * Are the spline interpolated intensities at m/z above the threshold?
-             */
-            vector<double> intensities_actual; // spline interpolated intensities @ m/z + actual m/z shift
-            int peaks_found_in_all_peptides_spline = nonLocalIntensityFilter_(patterns_[pattern], mz_shifts_actual, mz_shifts_actual_indices, nav, intensities_actual, peaks_found_in_all_peptides, mz);
-            if (peaks_found_in_all_peptides_spline < peaks_per_peptide_min_)
-            {
-              continue;
-            }
-
-            /**
-             * Filter (4): zeroth peak filter
-             * There should not be a significant peak to the left of the mono-isotopic
-             * (i.e. first) peak.
-             */
-            bool zero_peak = zerothPeakFilter_(patterns_[pattern], intensities_actual);
-            if (zero_peak)
-            {
-              continue;
-            }
-
-            /**
-             * Filter (5): peptide similarity filter
-             * How similar are the isotope patterns of the peptides?
-             */
-            bool peptide_similarity = peptideSimilarityFilter_(patterns_[pattern], intensities_actual, peaks_found_in_all_peptides_spline);
-            if (!peptide_similarity)
-            {
-              continue;
-            }
-
-            /**
-             * Filter (6): averagine similarity filter
-             * Does each individual isotope pattern resemble a peptide?
-             */
-            bool averagine_similarity = averagineSimilarityFilter_(patterns_[pattern], intensities_actual, peaks_found_in_all_peptides_spline, mz);
-            if (!averagine_similarity)
-            {
-              continue;
-            }
-
-            /**
-             * All filters passed.
-             */
-            // add raw data point to list that passed all filters
-            MultiplexFilterResultRaw result_raw(mz, mz_shifts_actual, intensities_actual);
-            results_raw.push_back(result_raw);
-            
-            // blacklist peaks in the current spectrum and the two neighbouring ones
-            if (!blacklisted)
-            {
-              blacklistPeaks_(patterns_[pattern], spectrum, mz_shifts_actual_indices, peaks_found_in_all_peptides_spline);
-              blacklisted = true;
-            }
+      }
 
+      // add the peak with its corresponding raw data to the result
+      if (results_raw.size() > 2)
+      {
+        // Scanning over the profile of the peak, we want at least three raw data points to pass all filters.
+        vector<double> intensities_actual;
+        for (unsigned i = 0; i < mz_shifts_actual_indices.size(); ++i)
+        {
+          int index = mz_shifts_actual_indices[i];
+          if (index == -1)
+          {
+            // no peak found
+            intensities_actual.push_back(std::numeric_limits<double>::quiet_NaN());
           }
-
-          // add the peak with its corresponding raw data to the result
-          if (results_raw.size() > 2)
+          else
           {
-            // Scanning over the profile of the peak, we want at least three raw data points to pass all filters.
-            vector<double> intensities_actual;
-            for (unsigned i = 0; i < mz_shifts_actual_indices.size(); ++i)
-            {
-              int index = mz_shifts_actual_indices[i];
-              if (index == -1)
-              {
-                // no peak found
-                intensities_actual.push_back(std::numeric_limits<double>::quiet_NaN());
-              }
-              else
-              {
-                intensities_actual.push_back(peak_intensity[mz_shifts_actual_indices[i]]);
-              }
-            }
-            result.addFilterResultPeak(peak_position[peak], rt_picked, mz_shifts_actual, intensities_actual, results_raw);
+            intensities_actual.push_back(peak_intensity[mz_shifts_actual_indices[i]]);
           }
-
         }
-
+        result.addFilterResultPeak(peak_position[peak], rt_picked, mz_shifts_actual, intensities_actual, results_raw);
       }
 
-      // add results of this pattern to list
-      filter_results.push_back(result);
     }
-
-    endProgress();
-
-    return filter_results;
   }
 
-  int MultiplexFilteringProfile::nonLocalIntensityFilter_(const MultiplexIsotopicPeakPattern& pattern, const vector<double>& mz_shifts_actual, const vector<int>& mz_shifts_actual_indices, SplineSpectrum::Navigator nav, std::vector<double>& intensities_actual, int peaks_found_in_all_peptides, double mz) const
+  int MultiplexFilteringProfile::nonLocalIntensityFilter_(const MultiplexIsotopicPeakPattern& pattern, const vector<const vector<double>*>& shifted_intensities, Size mz_index, std::vector<double>& intensities_actual, int peaks_found_in_all_peptides) const
   {
-    // calculate intensities
-    for (int i = 0; i < (int) mz_shifts_actual_indices.size(); ++i)
+    // look up intensities
+    for (int i = 0; i < (int) shifted_intensities.size(); ++i)
     {
-      if (mz_shifts_actual_indices[i] != -1)
+      if (shifted_intensities[i] != 0)
       {
-        intensities_actual.push_back(nav.eval(mz + mz_shifts_actual[i]));
+        intensities_actual.push_back((*shifted_intensities[i])[mz_index]);
       }
       else
       {
@@ -53,6 +53,8 @@
 
 namespace OpenMS
 {
+  class MaxIntensityPyramid;
+
   /**
   @brief Class that stores the data for one layer
 
@@ -144,6 +146,7 @@ public:
       consensus(new ConsensusMapType()),
       peaks(new ExperimentType()),
       chromatograms(new ExperimentType()),
+      max_intensity_pyramid_(),
       current_spectrum_(0)
     {
       annotations_1d.resize(1);
@@ -188,6 +191,21 @@ public:
       return peaks;
     }
 
+    /**
+      @brief Returns the maximum intensity pyramid of the peak data
+
+      The pyramid is built on first access and rebuilt when the peak data was
+      replaced or changed in size. Other in-place modifications of the peak
+      data require a call to resetMaxIntensityPyramid().
+    */
+    const MaxIntensityPyramid & getMaxIntensityPyramid() const;
+
+    /// Discards the maximum intensity pyramid of the peak data
+    void resetMaxIntensityPyramid()
+    {
+      max_intensity_pyramid_.reset();
+    }
+
     /// Returns a const reference to the current chromatogram data
     const ExperimentSharedPtrType & getChromatogramData() const
     {
@@ -320,6 +338,9 @@ private:
     /// chromatogram data
     ExperimentSharedPtrType chromatograms;
 
+    /// maximum intensity pyramid of the peak data (built on demand)
+    mutable boost::shared_ptr<MaxIntensityPyramid> max_intensity_pyramid_;
+
     /// Index of the current spectrum
     Size current_spectrum_;
   };
@@ -0,0 +1,149 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#ifndef OPENMS_VISUAL_MAXINTENSITYPYRAMID_H
+#define OPENMS_VISUAL_MAXINTENSITYPYRAMID_H
+
+// OpenMS_GUI config
+#include <OpenMS/VISUAL/OpenMS_GUIConfig.h>
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Multi-resolution RT x m/z grid of maximum intensities of a peak map.
+
+    The base level is a regular grid over the RT and m/z range of the MS1
+    spectra of a map, where each bin stores the maximum intensity of all peaks
+    falling into it (-1 for empty bins). Each further level halves the
+    resolution in both dimensions by taking the maximum of 2x2 bins of the
+    level below.
+
+    The pyramid is used by Spectrum2DCanvas to paint zoomed-out views of large
+    maps: instead of iterating over all visible peaks, the maximum intensity of
+    a pixel is taken from the coarsest level whose bins are not larger than a
+    pixel. Since bins and pixels are not aligned, a peak may also show up in a
+    directly neighboring pixel. When the view is zoomed in further than the
+    base level resolution, render() returns @em false and the raw data has to
+    be used.
+
+    Data filters are not taken into account, the pyramid always reflects the
+    complete MS1 data.
+
+    @ingroup Visual
+  */
+  class OPENMS_GUI_DLLAPI MaxIntensityPyramid
+  {
+public:
+    /// Default constructor (empty pyramid)
+    MaxIntensityPyramid();
+
+    /**
+      @brief Builds the pyramid from the MS1 spectra of @p map
+
+      The spectra of @p map have to be sorted by RT and their peaks by m/z.
+
+      @param map The peak map
+      @param rt_bins Maximum number of RT bins of the base level (reduced to the number of MS1 spectra)
+      @param mz_bins Number of m/z bins of the base level
+    */
+    void build(const MSExperiment<> & map, Size rt_bins = 2048, Size mz_bins = 2048);
+
+    /// Removes all levels
+    void clear();
+
+    /// Returns if the pyramid contains no data
+    bool empty() const;
+
+    /// Returns the number of resolution levels (0 if empty)
+    Size getNumberOfLevels() const;
+
+    /**
+      @brief Returns if the pyramid was built from @p map in its current state
+
+      Compares the address, number of spectra and number of peaks of @p map to
+      the values recorded in build().
+    */
+    bool isBuiltFrom(const MSExperiment<> & map) const;
+
+    /**
+      @brief Computes the maximum intensity of each pixel of a raster covering the given area
+
+      The result is stored row by row (RT major) in @p max_intensities, which
+      is resized to @p rt_pixel_count * @p mz_pixel_count. Pixels without data
+      are set to -1.
+
+      @return @em false (and leaves @p max_intensities untouched) if the pyramid
+      is empty or its base level is too coarse for the requested raster.
+    */
+    bool render(double rt_min, double rt_max, double mz_min, double mz_max,
+                Size rt_pixel_count, Size mz_pixel_count, std::vector<float> & max_intensities) const;
+
+protected:
+    /// One resolution level of the pyramid
+    struct Level_
+    {
+      Size rt_bins;
+      Size mz_bins;
+      /// maximum intensities, row by row (RT major)
+      std::vector<float> data;
+    };
+
+    /// Resolution levels, finest first
+    std::vector<Level_> levels_;
+
+    /// RT of the first bin of all levels
+    double rt_offset_;
+    /// RT width of a base level bin
+    double rt_bin_width_;
+    /// m/z of the first bin of all levels
+    double mz_offset_;
+    /// m/z width of a base level bin
+    double mz_bin_width_;
+
+    /// Address of the map the pyramid was built from
+    const MSExperiment<> * source_;
+    /// Number of spectra of the map the pyramid was built from
+    Size source_spectra_;
+    /// Number of peaks of the map the pyramid was built from
+    UInt64 source_peaks_;
+  };
+
+} // namespace OpenMS
+
+#endif // OPENMS_VISUAL_MAXINTENSITYPYRAMID_H
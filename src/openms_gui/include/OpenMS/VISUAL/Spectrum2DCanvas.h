@@ -188,6 +188,19 @@ protected:
     */
     void paintMaximumIntensities_(Size layer_index, Size rt_pixel_count, Size mz_pixel_count, QPainter& p);
 
+    /**
+      @brief Computes the maximum intensity of each pixel of the visible area from the raw peaks.
+
+      Used by paintMaximumIntensities_ when the maximum intensity pyramid of the layer cannot be used
+      (active data filters or zoomed in beyond its resolution).
+
+      @param layer The layer.
+      @param rt_pixel_count
+      @param mz_pixel_count
+      @param max_intensities Pixel intensities (RT major), initialized to -1 by the caller.
+    */
+    void computeMaximumIntensities_(const LayerData& layer, Size rt_pixel_count, Size mz_pixel_count, std::vector<float>& max_intensities) const;
+
     /**
       @brief Paints the precursor peaks.
 
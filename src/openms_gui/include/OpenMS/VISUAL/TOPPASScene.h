@@ -44,6 +44,7 @@
 
 #include <QtGui/QGraphicsScene>
 #include <QtCore/QProcess>
+#include <QtCore/QMap>
 
 namespace OpenMS
 {
@@ -94,11 +95,13 @@ public:
     struct TOPPProcess
     {
       /// Constructor
-      TOPPProcess(QProcess * p, const QString & cmd, const QStringList & arg, TOPPASToolVertex * const tool) :
+      TOPPProcess(QProcess * p, const QString & cmd, const QStringList & arg, TOPPASToolVertex * const tool, int num_threads = 1) :
         proc(p),
         command(cmd),
         args(arg),
-        tv(tool)
+        tv(tool),
+        threads(num_threads),
+        priority(0)
       {
       }
 
@@ -110,6 +113,10 @@ public:
       QStringList args;
       /// The tool which is started (used to call its slots)
       TOPPASToolVertex * tv;
+      /// The number of threads the tool is configured to use ('threads' parameter)
+      int threads;
+      /// Length of the longest chain of tools depending on this one (set by TOPPASScene::enqueueProcess)
+      int priority;
     };
 
     /// The current action mode (creation of a new edge, or panning of the widget)
@@ -205,10 +212,29 @@ public:
     bool isPipelineRunning();
     /// Shows a dialog that allows to specify the output directory. If @p always_ask == false, the dialog won't be shown if a directory has been set, already.
     bool askForOutputDir(bool always_ask = true);
-    /// Enqueues the process, it will be run when the currently pending processes have finished
+    /// Enqueues the process, it will be run when enough of the allowed threads are available
     void enqueueProcess(const TOPPProcess & process);
-    /// Runs the next process in the queue, if any
+    /**
+      @brief Starts queued processes as long as not all allowed threads are in use
+
+      Processes on the longest remaining chain of tools (critical path) are started first.
+      A process always runs with the number of threads it is configured to use; it stays
+      in the queue until enough of the allowed threads are free, while processes that fit
+      may start ahead of it (see selectNextProcess()).
+    */
     void runNextProcess();
+    /**
+      @brief Returns the index of the process in @p queue that should be started next, or -1 if none can be started yet
+
+      This is the process with the highest priority (first come, first served for ties) among
+      those whose threads fit into the budget of @p allowed_threads, i.e. a process waiting for
+      threads does not block processes with a lower priority which fit. If nothing is running
+      (@p threads_active == 0) and no process fits, the process with the highest priority is
+      started, so that processes configured with more threads than allowed in total still run
+      (on their own). A waiting process is delayed by the processes started ahead of it, but
+      not indefinitely, as a pipeline only enqueues a finite number of processes.
+    */
+    static int selectNextProcess(const QList<TOPPProcess> & queue, int threads_active, int allowed_threads);
     /// Resets the processes queue
     void resetProcessesQueue();
     /// Sets the clipboard content
@@ -237,7 +263,7 @@ public:
     QString getDescription() const;
     /// when description is updated by user, use this to update the description for later storage in file
     void setDescription(const QString & desc);
-    /// sets the maximum number of jobs
+    /// sets the maximum number of threads used by all running jobs together
     void setAllowedThreads(int num_threads);
     /// returns the hovering edge
     TOPPASEdge* getHoveringEdge();
@@ -272,8 +298,8 @@ public slots:
     void changedParameter(const bool invalidates_running_pipeline);
     /// Invoked by OutfilelistVertex of user changed the folder name
     void changedOutputFolder();
-    /// Called by a finished QProcess to indicate that we are free to start a new one
-    void processFinished();
+    /// Called by a finished QProcess to indicate that its threads are free for new ones (@p proc is used as key only and may be deleted already)
+    void processFinished(QProcess * proc);
     /// dirty solution: when using ExecutePipeline this slot is called when the pipeline crashes. This will quit the app
     void quitWithError();
 
@@ -352,8 +378,10 @@ protected:
     TOPPASScene * clipboard_;
     /// dry run mode (no tools are actually called)
     bool dry_run_;
-    /// currently running processes...
+    /// threads used by the currently running processes
     int threads_active_;
+    /// threads used by each running process
+    QMap<QProcess *, int> threads_running_;
     /// description text
     QString description_text_;
     /// maximum number of allowed threads
@@ -363,6 +391,9 @@ protected:
 
     /// Returns the vertex in the foreground at position @p pos , if existent, otherwise 0.
     TOPPASVertex * getVertexAt_(const QPointF & pos);
+
+    /// Returns the number of tools on the longest path starting at @p vertex (results are memoized in @p cache)
+    int criticalPathLength_(TOPPASVertex * vertex, QMap<TOPPASVertex *, int> & cache) const;
     /// Returns whether an edge between node u and v would be allowed
     bool isEdgeAllowed_(TOPPASVertex * u, TOPPASVertex * v);
     /// DFS helper method. Returns true, if a back edge has been discovered
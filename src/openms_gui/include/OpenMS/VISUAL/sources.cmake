@@ -65,6 +65,7 @@ EnhancedTabBar.h
 GUIProgressLoggerImpl.h
 HistogramWidget.h
 LayerData.h
+MaxIntensityPyramid.h
 MetaDataBrowser.h
 MultiGradient.h
 MultiGradientSelector.h
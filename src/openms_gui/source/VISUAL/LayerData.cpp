@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/VISUAL/LayerData.h>
+#include <OpenMS/VISUAL/MaxIntensityPyramid.h>
 
 using namespace std;
 
@@ -45,6 +46,16 @@ namespace OpenMS
     return (*peaks)[current_spectrum_];
   }
 
+  const MaxIntensityPyramid & LayerData::getMaxIntensityPyramid() const
+  {
+    if (!max_intensity_pyramid_ || !max_intensity_pyramid_->isBuiltFrom(*peaks))
+    {
+      max_intensity_pyramid_.reset(new MaxIntensityPyramid());
+      max_intensity_pyramid_->build(*peaks);
+    }
+    return *max_intensity_pyramid_;
+  }
+
   std::ostream & operator<<(std::ostream & os, const LayerData & rhs)
   {
     os << "--LayerData BEGIN--" << std::endl;
@@ -0,0 +1,267 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/VISUAL/MaxIntensityPyramid.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// Returns the bin of @p pos, clamped to the range of @p bins
+    inline Size binIndex(double pos, double offset, double width, Size bins)
+    {
+      double index = (pos - offset) / width;
+      if (index <= 0.0) return 0;
+      return std::min(Size(index), bins - 1);
+    }
+
+    /// Determines the half-open range of bins overlapping the interval [start, end)
+    inline void binRange(double start, double end, double offset, double width, Size bins, Size & first, Size & last)
+    {
+      double a = (start - offset) / width;
+      double b = (end - offset) / width;
+      if (b <= 0.0 || a >= double(bins))
+      {
+        first = last = 0;
+        return;
+      }
+      first = (a <= 0.0) ? 0 : Size(a);
+      last = std::min(bins, Size(std::ceil(b)));
+    }
+  }
+
+  MaxIntensityPyramid::MaxIntensityPyramid() :
+    levels_(),
+    rt_offset_(0.0),
+    rt_bin_width_(1.0),
+    mz_offset_(0.0),
+    mz_bin_width_(1.0),
+    source_(0),
+    source_spectra_(0),
+    source_peaks_(0)
+  {
+  }
+
+  void MaxIntensityPyramid::clear()
+  {
+    levels_.clear();
+    rt_offset_ = 0.0;
+    rt_bin_width_ = 1.0;
+    mz_offset_ = 0.0;
+    mz_bin_width_ = 1.0;
+    source_ = 0;
+    source_spectra_ = 0;
+    source_peaks_ = 0;
+  }
+
+  bool MaxIntensityPyramid::empty() const
+  {
+    return levels_.empty();
+  }
+
+  Size MaxIntensityPyramid::getNumberOfLevels() const
+  {
+    return levels_.size();
+  }
+
+  bool MaxIntensityPyramid::isBuiltFrom(const MSExperiment<> & map) const
+  {
+    return source_ == &map && source_spectra_ == map.size() && source_peaks_ == map.getSize();
+  }
+
+  void MaxIntensityPyramid::build(const MSExperiment<> & map, Size rt_bins, Size mz_bins)
+  {
+    clear();
+    source_ = &map;
+    source_spectra_ = map.size();
+    source_peaks_ = map.getSize();
+
+    // collect non-empty MS1 spectra and their m/z range
+    vector<Size> ms1;
+    double mz_min = numeric_limits<double>::max();
+    double mz_max = -numeric_limits<double>::max();
+    for (Size i = 0; i < map.size(); ++i)
+    {
+      if (map[i].getMSLevel() == 1 && !map[i].empty())
+      {
+        ms1.push_back(i);
+        mz_min = std::min(mz_min, double(map[i].front().getMZ()));
+        mz_max = std::max(mz_max, double(map[i].back().getMZ()));
+      }
+    }
+    if (ms1.empty() || rt_bins == 0 || mz_bins == 0) return;
+
+    // more RT bins than spectra would only leave empty rows
+    rt_bins = std::min(rt_bins, ms1.size());
+
+    rt_offset_ = map[ms1.front()].getRT();
+    rt_bin_width_ = (map[ms1.back()].getRT() - rt_offset_) / rt_bins;
+    if (rt_bin_width_ <= 0.0) rt_bin_width_ = 1.0;
+    mz_offset_ = mz_min;
+    mz_bin_width_ = (mz_max - mz_min) / mz_bins;
+    if (mz_bin_width_ <= 0.0) mz_bin_width_ = 1.0;
+
+    // spectra are sorted by RT, so each RT bin covers a consecutive range of 'ms1'
+    vector<Size> row_begin(rt_bins + 1, ms1.size());
+    for (Size k = ms1.size(); k > 0; --k)
+    {
+      row_begin[binIndex(map[ms1[k - 1]].getRT(), rt_offset_, rt_bin_width_, rt_bins)] = k - 1;
+    }
+    for (Size b = rt_bins; b > 0; --b)
+    {
+      row_begin[b - 1] = std::min(row_begin[b - 1], row_begin[b]);
+    }
+
+    // base level: rows are filled independently
+    levels_.push_back(Level_());
+    Level_ & base = levels_.back();
+    base.rt_bins = rt_bins;
+    base.mz_bins = mz_bins;
+    base.data.assign(rt_bins * mz_bins, -1.0f);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (SignedSize b = 0; b < (SignedSize)rt_bins; ++b)
+    {
+      float * row = &base.data[b * mz_bins];
+      for (Size k = row_begin[b]; k < row_begin[b + 1]; ++k)
+      {
+        const MSSpectrum<> & spectrum = map[ms1[k]];
+        for (MSSpectrum<>::ConstIterator it = spectrum.begin(); it != spectrum.end(); ++it)
+        {
+          float & bin = row[binIndex(it->getMZ(), mz_offset_, mz_bin_width_, mz_bins)];
+          bin = std::max(bin, float(it->getIntensity()));
+        }
+      }
+    }
+
+    // coarser levels: maximum of 2x2 bins of the level below
+    while (levels_.back().rt_bins > 1 || levels_.back().mz_bins > 1)
+    {
+      Level_ next;
+      {
+        const Level_ & prev = levels_.back();
+        next.rt_bins = (prev.rt_bins + 1) / 2;
+        next.mz_bins = (prev.mz_bins + 1) / 2;
+        next.data.assign(next.rt_bins * next.mz_bins, -1.0f);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (SignedSize r = 0; r < (SignedSize)next.rt_bins; ++r)
+        {
+          float * row = &next.data[r * next.mz_bins];
+          for (Size pr = 2 * r; pr < std::min(Size(2 * r + 2), prev.rt_bins); ++pr)
+          {
+            const float * prev_row = &prev.data[pr * prev.mz_bins];
+            for (Size pc = 0; pc < prev.mz_bins; ++pc)
+            {
+              row[pc / 2] = std::max(row[pc / 2], prev_row[pc]);
+            }
+          }
+        }
+      }
+      levels_.push_back(next);
+    }
+  }
+
+  bool MaxIntensityPyramid::render(double rt_min, double rt_max, double mz_min, double mz_max,
+                                   Size rt_pixel_count, Size mz_pixel_count, vector<float> & max_intensities) const
+  {
+    if (empty() || rt_pixel_count == 0 || mz_pixel_count == 0) return false;
+
+    double rt_step_size = (rt_max - rt_min) / rt_pixel_count;
+    double mz_step_size = (mz_max - mz_min) / mz_pixel_count;
+
+    // base level bins must not be larger than a pixel, otherwise the raw data has to be used
+    if (rt_bin_width_ > rt_step_size || mz_bin_width_ > mz_step_size) return false;
+
+    // choose the coarsest level that still satisfies this
+    Size level = 0;
+    double factor = 1.0;
+    while (level + 1 < levels_.size() &&
+           2.0 * factor * rt_bin_width_ <= rt_step_size &&
+           2.0 * factor * mz_bin_width_ <= mz_step_size)
+    {
+      ++level;
+      factor *= 2.0;
+    }
+    const Level_ & lvl = levels_[level];
+    const double rt_width = factor * rt_bin_width_;
+    const double mz_width = factor * mz_bin_width_;
+
+    // the m/z bins of a pixel column are the same for all rows
+    vector<Size> mz_first(mz_pixel_count), mz_last(mz_pixel_count);
+    for (Size mz = 0; mz < mz_pixel_count; ++mz)
+    {
+      double mz_start = mz_min + mz_step_size * mz;
+      binRange(mz_start, mz_start + mz_step_size, mz_offset_, mz_width, lvl.mz_bins, mz_first[mz], mz_last[mz]);
+    }
+
+    max_intensities.assign(rt_pixel_count * mz_pixel_count, -1.0f);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (SignedSize rt = 0; rt < (SignedSize)rt_pixel_count; ++rt)
+    {
+      double rt_start = rt_min + rt_step_size * rt;
+      Size rt_first, rt_last;
+      binRange(rt_start, rt_start + rt_step_size, rt_offset_, rt_width, lvl.rt_bins, rt_first, rt_last);
+
+      float * out = &max_intensities[rt * mz_pixel_count];
+      for (Size r = rt_first; r < rt_last; ++r)
+      {
+        const float * row = &lvl.data[r * lvl.mz_bins];
+        for (Size mz = 0; mz < mz_pixel_count; ++mz)
+        {
+          for (Size c = mz_first[mz]; c < mz_last[mz]; ++c)
+          {
+            out[mz] = std::max(out[mz], row[c]);
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+} // namespace OpenMS
@@ -642,7 +642,6 @@ namespace OpenMS
     Int image_height = buffer_.height();
 
     const LayerData & layer = getLayer(layer_index);
-    const ExperimentType & map = *layer.getPeakData();
     const double rt_min = visible_area_.minPosition()[1];
     const double rt_max = visible_area_.maxPosition()[1];
     const double mz_min = visible_area_.minPosition()[0];
@@ -654,6 +653,49 @@ namespace OpenMS
     double rt_step_size = (rt_max - rt_min) / rt_pixel_count;
     double mz_step_size = (mz_max - mz_min) / mz_pixel_count;
 
+    // maximum intensity of each pixel (RT major), -1 for pixels without data
+    vector<float> max_intensities;
+
+    // zoomed-out views of unfiltered data are taken from the precomputed pyramid,
+    // otherwise all visible peaks have to be visited
+    if (layer.filters.isActive() ||
+        !layer.getMaxIntensityPyramid().render(rt_min, rt_max, mz_min, mz_max, rt_pixel_count, mz_pixel_count, max_intensities))
+    {
+      max_intensities.assign(rt_pixel_count * mz_pixel_count, -1.0f);
+      computeMaximumIntensities_(layer, rt_pixel_count, mz_pixel_count, max_intensities);
+    }
+
+    //draw to buffer
+    for (Size rt = 0; rt < rt_pixel_count; ++rt)
+    {
+      for (Size mz = 0; mz < mz_pixel_count; ++mz)
+      {
+        float max = max_intensities[rt * mz_pixel_count + mz];
+        if (max >= 0.0)
+        {
+          QPoint pos;
+          dataToWidget_(mz_min + (mz + 0.5) * mz_step_size, rt_min + (rt + 0.5) * rt_step_size, pos);
+          if (pos.y() < image_height && pos.x() < image_width)
+          {
+            buffer_.setPixel(pos.x(), pos.y(), heightColor_(max, layer.gradient, snap_factor).rgb());
+          }
+        }
+      }
+    }
+  }
+
+  void Spectrum2DCanvas::computeMaximumIntensities_(const LayerData & layer, Size rt_pixel_count, Size mz_pixel_count, vector<float> & max_intensities) const
+  {
+    const ExperimentType & map = *layer.getPeakData();
+    const double rt_min = visible_area_.minPosition()[1];
+    const double rt_max = visible_area_.maxPosition()[1];
+    const double mz_min = visible_area_.minPosition()[0];
+    const double mz_max = visible_area_.maxPosition()[0];
+
+    //calculate pixel size in data coordinates
+    double rt_step_size = (rt_max - rt_min) / rt_pixel_count;
+    double mz_step_size = (mz_max - mz_min) / mz_pixel_count;
+
     // start at first visible RT scan
     Size scan_index = std::distance(map.begin(), map.RTBegin(rt_min));
     //iterate over all pixels (RT dimension)
@@ -710,17 +752,7 @@ namespace OpenMS
           }
           peak_indices[i] = p;   //store last peak index for next m/z pixel
         }
-
-        //draw to buffer
-        if (max >= 0.0)
-        {
-          QPoint pos;
-          dataToWidget_(mz_start + 0.5 * mz_step_size, rt_start + 0.5 * rt_step_size, pos);
-          if (pos.y() < image_height && pos.x() < image_width)
-          {
-            buffer_.setPixel(pos.x(), pos.y(), heightColor_(max, layer.gradient, snap_factor).rgb());
-          }
-        }
+        max_intensities[rt * mz_pixel_count + mz] = max;
       }
     }
   }
@@ -2820,6 +2852,7 @@ namespace OpenMS
   {
     //update nearest peak
     selected_peak_.clear();
+    getLayer_(i).resetMaxIntensityPyramid();
     recalculateRanges_(0, 1, 2);
     resetZoom(false);     //no repaint as this is done in intensityModeChange_() anyway
     intensityModeChange_();
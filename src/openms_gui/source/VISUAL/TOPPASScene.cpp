@@ -58,6 +58,8 @@
 #include <QtCore/QTextStream>
 #include <QtGui/QMessageBox>
 
+#include <algorithm>
+
 namespace OpenMS
 {
 
@@ -1663,9 +1665,9 @@ namespace OpenMS
     }
   }
 
-  void TOPPASScene::processFinished()
+  void TOPPASScene::processFinished(QProcess* proc)
   {
-    --threads_active_;
+    threads_active_ -= threads_running_.take(proc);
     // try to run next in line
     runNextProcess();
   }
@@ -1990,9 +1992,54 @@ namespace OpenMS
     event->accept();
   }
 
+  int TOPPASScene::criticalPathLength_(TOPPASVertex* vertex, QMap<TOPPASVertex*, int>& cache) const
+  {
+    QMap<TOPPASVertex*, int>::const_iterator it = cache.find(vertex);
+    if (it != cache.end())
+      return it.value();
+
+    int length = 0;
+    for (TOPPASVertex::ConstEdgeIterator e = vertex->outEdgesBegin(); e != vertex->outEdgesEnd(); ++e)
+    {
+      length = std::max(length, criticalPathLength_((*e)->getTargetVertex(), cache));
+    }
+    if (qobject_cast<TOPPASToolVertex*>(vertex))
+      ++length;
+
+    cache[vertex] = length;
+    return length;
+  }
+
   void TOPPASScene::enqueueProcess(const TOPPProcess& process)
   {
-    topp_processes_queue_ << process;
+    QMap<TOPPASVertex*, int> cache;
+    TOPPProcess tp = process;
+    tp.priority = criticalPathLength_(tp.tv, cache);
+    topp_processes_queue_ << tp;
+  }
+
+  int TOPPASScene::selectNextProcess(const QList<TOPPProcess>& queue, int threads_active, int allowed_threads)
+  {
+    if (queue.empty())
+      return -1;
+
+    // the process with the longest chain of dependent tools comes first (first come, first served for ties),
+    // among those whose threads fit into the free part of the budget
+    int next = -1;
+    int first = 0;
+    for (int i = 0; i < queue.size(); ++i)
+    {
+      if (queue[i].priority > queue[first].priority)
+        first = i;
+      if (threads_active + queue[i].threads <= allowed_threads && (next == -1 || queue[i].priority > queue[next].priority))
+        next = i;
+    }
+
+    // a process which needs more threads than allowed runs alone
+    if (next == -1 && threads_active == 0)
+      next = first;
+
+    return next;
   }
 
   void TOPPASScene::runNextProcess()
@@ -2003,11 +2050,14 @@ namespace OpenMS
 
     used = true;
 
-    while (!topp_processes_queue_.empty() && threads_active_ < allowed_threads_)
+    int next;
+    while ((next = selectNextProcess(topp_processes_queue_, threads_active_, allowed_threads_)) != -1)
     {
-      ++threads_active_; // will be decreased, once the tool finishes
-      TOPPProcess tp = topp_processes_queue_.first();
-      topp_processes_queue_.pop_front();
+      TOPPProcess tp = topp_processes_queue_.takeAt(next);
+
+      threads_active_ += tp.threads; // will be decreased, once the tool finishes
+      threads_running_[tp.proc] = tp.threads;
+
       FakeProcess* p = qobject_cast<FakeProcess*>(tp.proc);
       if (p)
       {
@@ -52,6 +52,8 @@
 
 #include <QSvgRenderer>
 
+#include <algorithm>
+
 namespace OpenMS
 {
 
@@ -716,8 +718,15 @@ namespace OpenMS
           ts->logTOPPOutput(msg_enqueue.toQString());
         }
       }
+      // the number of threads the tool will use determines how many other tools can run alongside
+      int threads = 1;
+      if (param_tmp.exists("threads"))
+      {
+        threads = std::max(1, (int) param_tmp.getValue("threads"));
+      }
+
       toolScheduledSlot();
-      ts->enqueueProcess(TOPPASScene::TOPPProcess(p, File::findExecutable(name_).toQString(), args, this));
+      ts->enqueueProcess(TOPPASScene::TOPPProcess(p, File::findExecutable(name_).toQString(), args, this, threads));
     }
 
     // run pending processes
@@ -782,15 +791,14 @@ namespace OpenMS
       }
     }
 
-    //clean up
+    //clean up (release the threads of the process while it is still alive)
     QProcess* p = qobject_cast<QProcess*>(QObject::sender());
+    ts->processFinished(p);
     if (p)
     {
       delete p;
     }
 
-    ts->processFinished();
-
     __DEBUG_END_METHOD__
   }
 
@@ -14,6 +14,7 @@ GUIProgressLoggerImpl.cpp
 HistogramWidget.cpp
 LayerData.cpp
 ListEditor.cpp
+MaxIntensityPyramid.cpp
 MetaDataBrowser.cpp
 MultiGradient.cpp
 MultiGradientSelector.cpp
@@ -67,6 +67,24 @@ namespace OpenSwath
                                              std::vector<double>& integratedWindowsIntensity,
                                              std::vector<double>& integratedWindowsMZ, bool remZero = false);
 
+/**
+  @brief Integrate intensity in a spectrum for a batch of windows
+
+  Computes the same result as integrateWindow() for each window from
+  windowsStart[i] to windowsEnd[i], but visits the windows in order of their
+  start position. The search for the window boundaries therefore only covers
+  the part of the spectrum after the previous window start, instead of the
+  whole spectrum for every window.
+
+  The results are stored in the order of the windows. Windows without signal
+  get an intensity of 0 and an m/z of -1.
+*/
+  OPENSWATHALGO_DLLAPI void integrateWindows(const OpenSwath::SpectrumPtr spectrum, //!< [in] Spectrum
+                                             const std::vector<double>& windowsStart, //!< [in] start of each window
+                                             const std::vector<double>& windowsEnd, //!< [in] end of each window
+                                             std::vector<double>& integratedWindowsIntensity,
+                                             std::vector<double>& integratedWindowsMZ, bool centroided = false);
+
 }
 
 #endif // OPENMS_ANALYSIS_OPENSWATH_OPENSWATHALGO_DATAACCESS_SPECTRUMHELPERS_H
@@ -48,25 +48,87 @@ namespace OpenSwath
                         std::vector<double> & integratedWindowsMZ,
                         bool remZero)
   {
-    std::vector<double>::const_iterator beg = windowsCenter.begin();
-    std::vector<double>::const_iterator end = windowsCenter.end();
-    double mz, intensity;
-    for (; beg != end; ++beg)
+    std::vector<double> windowsStart, windowsEnd;
+    windowsStart.reserve(windowsCenter.size());
+    windowsEnd.reserve(windowsCenter.size());
+    for (std::vector<double>::const_iterator beg = windowsCenter.begin(); beg != windowsCenter.end(); ++beg)
     {
-      double left = *beg - width / 2.0;
-      double right = *beg + width / 2.0;
-      if (integrateWindow(spectrum, left, right, mz, intensity, false))
+      windowsStart.push_back(*beg - width / 2.0);
+      windowsEnd.push_back(*beg + width / 2.0);
+    }
+
+    std::vector<double> intensity, mz;
+    integrateWindows(spectrum, windowsStart, windowsEnd, intensity, mz, false);
+    for (std::size_t i = 0; i < windowsCenter.size(); ++i)
+    {
+      if (intensity[i] > 0.)
       {
-        integratedWindowsIntensity.push_back(intensity);
-        integratedWindowsMZ.push_back(mz);
+        integratedWindowsIntensity.push_back(intensity[i]);
+        integratedWindowsMZ.push_back(mz[i]);
       }
       else if (!remZero)
       {
         integratedWindowsIntensity.push_back(0.);
-        integratedWindowsMZ.push_back(*beg);
+        integratedWindowsMZ.push_back(windowsCenter[i]);
       }
-      else
+    }
+  }
+
+  void integrateWindows(const OpenSwath::SpectrumPtr spectrum,
+                        const std::vector<double> & windowsStart,
+                        const std::vector<double> & windowsEnd,
+                        std::vector<double> & integratedWindowsIntensity,
+                        std::vector<double> & integratedWindowsMZ,
+                        bool centroided)
+  {
+    //check precondtion
+    OPENSWATH_PRECONDITION(windowsStart.size() == windowsEnd.size(), "Precondition violated: need as many window starts as ends")
+    OPENSWATH_PRECONDITION( std::adjacent_find(spectrum->getMZArray()->data.begin(),
+            spectrum->getMZArray()->data.end(), std::greater<double>()) == spectrum->getMZArray()->data.end(),
+          "Precondition violated: m/z vector needs to be sorted!" )
+
+    if (centroided)
+    {
+      // not implemented
+      throw "Not implemented";
+    }
+
+    const std::vector<double> & mz_arr = spectrum->getMZArray()->data;
+    const std::vector<double> & int_arr = spectrum->getIntensityArray()->data;
+
+    integratedWindowsIntensity.assign(windowsStart.size(), 0.);
+    integratedWindowsMZ.assign(windowsStart.size(), -1.);
+
+    // visit the windows by increasing start, so the left boundary only moves forward
+    std::vector<std::pair<double, std::size_t> > order;
+    order.reserve(windowsStart.size());
+    for (std::size_t i = 0; i < windowsStart.size(); ++i)
+    {
+      order.push_back(std::make_pair(windowsStart[i], i));
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<double>::const_iterator mz_start_it = mz_arr.begin();
+    for (std::size_t k = 0; k < order.size(); ++k)
+    {
+      std::size_t i = order[k].second;
+      // this assumes that the spectra are sorted!
+      mz_start_it = std::lower_bound(mz_start_it, mz_arr.end(), windowsStart[i]);
+      std::vector<double>::const_iterator mz_end_it = std::lower_bound(mz_start_it, mz_arr.end(), windowsEnd[i]);
+      std::vector<double>::const_iterator int_it = int_arr.begin() + (mz_start_it - mz_arr.begin());
+
+      // get the weighted average for noncentroided data (same as integrateWindow)
+      double mz = 0, intensity = 0;
+      for (std::vector<double>::const_iterator mz_it = mz_start_it; mz_it != mz_end_it; ++mz_it, ++int_it)
+      {
+        intensity += (*int_it);
+        mz += (*int_it) * (*mz_it);
+      }
+
+      if (intensity > 0.)
       {
+        integratedWindowsIntensity[i] = intensity;
+        integratedWindowsMZ[i] = mz / intensity;
       }
     }
   }
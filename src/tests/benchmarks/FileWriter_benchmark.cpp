@@ -0,0 +1,159 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+using namespace OpenMS;
+using namespace std;
+
+// feature map with typical m/z, RT, intensity and quality values and a convex hull for each feature
+void createFeatureMap(Size size, FeatureMap & features)
+{
+  srand(1);
+  for (Size i = 0; i < size; ++i)
+  {
+    Feature f;
+    f.setMZ(400.0 + rand() % 1200 + rand() / (double)RAND_MAX);
+    f.setRT(rand() % 7200 + rand() / (double)RAND_MAX);
+    f.setIntensity(1e3 + rand() % 1000000 * 12.345678);
+    f.setCharge(1 + rand() % 4);
+    f.setOverallQuality(rand() / (double)RAND_MAX);
+    ConvexHull2D hull;
+    for (Size j = 0; j < 10; ++j)
+    {
+      hull.addPoint(DPosition<2>(f.getRT() + j * 1.37, f.getMZ() + j * 1.0033548 / f.getCharge()));
+    }
+    f.getConvexHulls().push_back(hull);
+    features.push_back(f);
+  }
+}
+
+// profile experiment, the peak data is stored base64 encoded, the spectrum meta data as text
+void createExperiment(Size size, MSExperiment<> & exp)
+{
+  srand(1);
+  for (Size i = 0; i < size; ++i)
+  {
+    MSSpectrum<> spectrum;
+    spectrum.setRT(i * 0.87);
+    spectrum.setMSLevel(1);
+    for (double mz = 400.0; mz < 1600.0; mz += 0.01)
+    {
+      spectrum.push_back(Peak1D(mz, (float)(rand() % 10000)));
+    }
+    exp.addSpectrum(spectrum);
+  }
+}
+
+// Times storing a featureXML and an mzML file and formatting the numbers of
+// the featureXML file (with String and with a stringstream).
+int main(int argc, const char ** argv)
+{
+  Size repeats = (argc > 1) ? atoi(argv[1]) : 3;
+  const String filename = File::getTemporaryFile();
+  StopWatch watch;
+
+  FeatureMap features;
+  createFeatureMap(50000, features);
+  watch.start();
+  for (Size r = 0; r < repeats; ++r)
+  {
+    FeatureXMLFile().store(filename + ".featureXML", features);
+  }
+  watch.stop();
+  cout << "featureXML (" << features.size() << " features): " << watch.getClockTime() / repeats << " s per file" << endl;
+  File::remove(filename + ".featureXML");
+
+  MSExperiment<> exp;
+  createExperiment(500, exp);
+  watch.reset();
+  watch.start();
+  for (Size r = 0; r < repeats; ++r)
+  {
+    MzMLFile().store(filename + ".mzML", exp);
+  }
+  watch.stop();
+  cout << "mzML (" << exp.size() << " spectra): " << watch.getClockTime() / repeats << " s per file" << endl;
+  File::remove(filename + ".mzML");
+
+  // the numbers written for the features (position, intensity and convex hull points)
+  vector<double> values;
+  for (Size i = 0; i < features.size(); ++i)
+  {
+    values.push_back(features[i].getMZ());
+    values.push_back(features[i].getRT());
+    values.push_back(features[i].getIntensity());
+    const ConvexHull2D::PointArrayType & points = features[i].getConvexHulls()[0].getHullPoints();
+    for (Size j = 0; j < points.size(); ++j)
+    {
+      values.push_back(points[j][0]);
+      values.push_back(points[j][1]);
+    }
+  }
+
+  watch.reset();
+  watch.start();
+  Size length_string = 0;
+  for (Size i = 0; i < values.size(); ++i)
+  {
+    length_string += String(values[i]).size();
+  }
+  watch.stop();
+  double time_string = watch.getClockTime();
+
+  watch.reset();
+  watch.start();
+  Size length_stream = 0;
+  for (Size i = 0; i < values.size(); ++i)
+  {
+    stringstream ss;
+    ss.precision(writtenDigits<double>());
+    ss << values[i];
+    length_stream += ss.str().size();
+  }
+  watch.stop();
+  double time_stream = watch.getClockTime();
+
+  cout << "formatting " << values.size() << " values: " << time_string << " s (String), " << time_stream
+       << " s (stringstream), " << (length_string == length_stream ? "same" : "different") << " output length" << endl;
+  return 0;
+}
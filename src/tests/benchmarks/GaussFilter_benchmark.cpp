@@ -0,0 +1,123 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FILTERING/SMOOTHING/GaussFilterAlgorithm.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace OpenMS;
+using namespace std;
+
+// gives access to the exact integration of every data point
+class GaussFilterAlgorithmExact :
+  public GaussFilterAlgorithm
+{
+public:
+  void filterExact(const vector<double> & mz, const vector<double> & intensities, vector<double> & intensities_out)
+  {
+    intensities_out.resize(mz.size());
+    for (Size i = 0; i < mz.size(); ++i)
+    {
+      intensities_out[i] = integrate_(mz.begin() + i, intensities.begin() + i, mz.begin(), mz.end());
+    }
+  }
+};
+
+// profile spectrum with the given spacing at m/z 400, growing with m/z to the power of 'exponent'
+void createProfileSpectrum(double spacing, double exponent, bool single_precision, vector<double> & mz, vector<double> & intensities)
+{
+  mz.clear();
+  intensities.clear();
+  srand(1);
+  for (double pos = 400.0; pos < 1600.0; pos += spacing * pow(pos / 400.0, exponent))
+  {
+    mz.push_back(single_precision ? (float)pos : pos);
+    // a peak every 1.3 Th on a noisy background
+    double offset = fmod(pos, 1.3) - 0.65;
+    intensities.push_back(100.0 + rand() % 50 + 1e5 * exp(-offset * offset / (2 * 0.004 * 0.004)));
+  }
+}
+
+// Times GaussFilterAlgorithm::filter against the exact integration of every data point
+// on synthetic profile spectra with the default parameters of GaussFilter.
+int main(int argc, const char ** argv)
+{
+  Size repeats = (argc > 1) ? atoi(argv[1]) : 5;
+
+  // Orbitrap: spacing grows with m/z^1.5, TOF: spacing grows with sqrt(m/z), resampled data: constant spacing
+  const char * names[] = {"Orbitrap", "TOF", "resampled", "Orbitrap (32 bit m/z)"};
+  double spacings[] = {0.0015, 0.005, 0.002, 0.0015};
+  double exponents[] = {1.5, 0.5, 0.0, 1.5};
+  bool single_precision[] = {false, false, false, true};
+
+  for (Size k = 0; k < 4; ++k)
+  {
+    vector<double> mz, intensities, intensities_exact;
+    createProfileSpectrum(spacings[k], exponents[k], single_precision[k], mz, intensities);
+    vector<double> mz_out(mz.size()), intensities_out(mz.size());
+
+    GaussFilterAlgorithmExact gauss;
+    gauss.initialize(0.2, 0.01, 10.0, false);
+
+    StopWatch watch;
+    watch.start();
+    for (Size r = 0; r < repeats; ++r)
+    {
+      gauss.filterExact(mz, intensities, intensities_exact);
+    }
+    watch.stop();
+    double time_exact = watch.getClockTime() / repeats;
+
+    watch.reset();
+    watch.start();
+    for (Size r = 0; r < repeats; ++r)
+    {
+      gauss.filter(mz.begin(), mz.end(), intensities.begin(), mz_out.begin(), intensities_out.begin());
+    }
+    watch.stop();
+    double time_filter = watch.getClockTime() / repeats;
+
+    double max_deviation = 0.0;
+    for (Size i = 0; i < mz.size(); ++i)
+    {
+      max_deviation = max(max_deviation, fabs(intensities_out[i] - intensities_exact[i]) / intensities_exact[i]);
+    }
+
+    cout << names[k] << " (" << mz.size() << " data points): exact " << time_exact << " s, filter "
+         << time_filter << " s per spectrum, max. relative deviation " << max_deviation << endl;
+  }
+  return 0;
+}
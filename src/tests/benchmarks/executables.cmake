@@ -0,0 +1,18 @@
+# --------------------------------------------------------------------------
+# list all filenames of the directory here
+set(executables_list
+FileWriter_benchmark
+GaussFilter_benchmark
+)
+
+# --------------------------------------------------------------------------
+# pass source file list to the upper instance
+set(BENCHMARK_executables ${BENCHMARK_executables} ${executables_list})
+
+# --------------------------------------------------------------------------
+# add filenames to Visual Studio solution tree
+set(sources_VS)
+foreach(i ${executables_list})
+	list(APPEND sources_VS "${i}.cpp")
+endforeach(i)
+source_group("BENCHMARKS" FILES ${sources_VS})
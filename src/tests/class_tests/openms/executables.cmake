@@ -111,6 +111,7 @@ set(system_executables_list
   File_test
   FileWatcher_test
   JavaInfo_test
+  Profiler_test
   StopWatch_test
   SysInfo_test
 )
@@ -149,6 +150,7 @@ set(format_executables_list
   Base64_test
   MSNumpressCoder_test
   BigString_test
+  BinaryDataFile_test
   Bzip2Ifstream_test
   Bzip2InputStream_test
   CVMappingFile_test
@@ -232,6 +234,7 @@ set(format_executables_list
   MSDataCachedConsumer_test
   MSDataTransformingConsumer_test
   MSDataChainingConsumer_test
+  MSDataFilteringConsumer_test
   SpectrumAccessQuadMZTransforming_test
 )
 
@@ -577,6 +580,7 @@ if(NOT DISABLE_OPENSWATH)
     MRMIonSeries_test
     MRMRTNormalizer_test
     TransitionTSVReader_test
+    TransitionBinaryFile_test
     ChromatogramExtractor_test
     ChromatogramExtractorAlgorithm_test
     OpenSwathHelper_test
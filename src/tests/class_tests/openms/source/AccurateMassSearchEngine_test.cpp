@@ -177,6 +177,39 @@ START_SECTION((void queryByMZ(const double& observed_mz, const Int& observed_cha
 }
 END_SECTION
 
+START_SECTION([EXTRA] adduct compatibility table (computed in init()) agrees with AdductInfo::isCompatible())
+{
+  // 'M-H2O-H;1-' needs an 'O' to lose: C17H20N2S has none, C16H15NO4 has
+  AdductInfo water_loss = AdductInfo::parseAdductString("M-H2O-H;1-");
+  String formulas[] = {"C17H20N2S", "C16H15NO4"};
+  for (Size f = 0; f < 2; ++f)
+  {
+    EmpiricalFormula ef(formulas[f]);
+    std::vector<AccurateMassSearchResult> results;
+    ams.queryByMZ(water_loss.getMZ(ef.getMonoWeight()), 1, "negative", results);
+    bool found(false);
+    for (Size i = 0; i < results.size(); ++i)
+    {
+      if (results[i].getMatchingIndex() == (Size)-1) continue; // 'not-found' dummy
+      // every reported hit must pass the per-query check used before the table was introduced
+      TEST_EQUAL(AdductInfo::parseAdductString(results[i].getFoundAdduct()).isCompatible(EmpiricalFormula(results[i].getFormulaString())), true)
+      if (results[i].getFormulaString() == formulas[f] && results[i].getFoundAdduct() == water_loss.getName()) found = true;
+    }
+    TEST_EQUAL(found, water_loss.isCompatible(ef))
+  }
+
+  // same for all hits of a positive mode query
+  std::vector<AccurateMassSearchResult> results_pos;
+  ams.queryByMZ(EmpiricalFormula("C17H11N5").getMonoWeight() + EmpiricalFormula("Na").getMonoWeight() - Constants::ELECTRON_MASS_U, 1, "positive", results_pos);
+  TEST_EQUAL(results_pos.empty(), false)
+  for (Size i = 0; i < results_pos.size(); ++i)
+  {
+    if (results_pos[i].getMatchingIndex() == (Size)-1) continue; // 'not-found' dummy
+    TEST_EQUAL(AdductInfo::parseAdductString(results_pos[i].getFoundAdduct()).isCompatible(EmpiricalFormula(results_pos[i].getFormulaString())), true)
+  }
+}
+END_SECTION
+
 AccurateMassSearchEngine ams_feat_test;
 ams_feat_test.setParameters(ams_param);
 ams_feat_test.init();
@@ -0,0 +1,252 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/BinaryDataFile.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(BinaryDataFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+BinaryDataFile* ptr = 0;
+BinaryDataFile* null_ptr = 0;
+START_SECTION(BinaryDataFile())
+{
+  ptr = new BinaryDataFile();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+}
+END_SECTION
+
+START_SECTION(~BinaryDataFile())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(void store(const String& filename, const FeatureMap& feature_map))
+{
+  NOT_TESTABLE // tested below
+}
+END_SECTION
+
+START_SECTION(void load(const String& filename, FeatureMap& feature_map))
+{
+  FeatureMap in, out;
+  FeatureXMLFile().load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), in);
+  // add what the test file lacks
+  in[0].getSubordinates().push_back(in[1]);
+  in[0].setMetaValue("int_list", IntList(3, -2));
+  in[1].setMetaValue("double_list", DoubleList(2, 0.1));
+
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  BinaryDataFile().store(tmp_filename, in);
+  BinaryDataFile().load(tmp_filename, out);
+
+  TEST_EQUAL(out.size(), in.size())
+  for (Size i = 0; i < in.size(); ++i)
+  {
+    TEST_EQUAL(out[i] == in[i], true)
+  }
+  TEST_EQUAL(out.getIdentifier(), in.getIdentifier())
+  TEST_EQUAL(out.getUniqueId(), in.getUniqueId())
+  TEST_EQUAL(out.getProteinIdentifications() == in.getProteinIdentifications(), true)
+  TEST_EQUAL(out.getUnassignedPeptideIdentifications() == in.getUnassignedPeptideIdentifications(), true)
+  TEST_EQUAL(out.getDataProcessing() == in.getDataProcessing(), true)
+  TEST_EQUAL((MetaInfoInterface)out == (MetaInfoInterface)in, true)
+  TEST_EQUAL(out.getLoadedFilePath(), tmp_filename)
+  TEST_EQUAL(out.getMin() == in.getMin(), true)
+  TEST_EQUAL(out.getMax() == in.getMax(), true)
+
+  // a file of another kind cannot be loaded as feature map
+  vector<ProteinIdentification> proteins;
+  vector<PeptideIdentification> peptides;
+  TEST_EXCEPTION(Exception::ParseError, BinaryDataFile().load(tmp_filename, proteins, peptides))
+  TEST_EXCEPTION(Exception::ParseError, BinaryDataFile().load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), out))
+  TEST_EXCEPTION(Exception::FileNotFound, BinaryDataFile().load("this_file_does_not_exist.featureBin", out))
+}
+END_SECTION
+
+START_SECTION(void store(const String& filename, const ConsensusMap& consensus_map))
+{
+  NOT_TESTABLE // tested below
+}
+END_SECTION
+
+START_SECTION(void load(const String& filename, ConsensusMap& consensus_map))
+{
+  ConsensusMap in, out;
+  ConsensusXMLFile().load(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), in);
+  ConsensusFeature::Ratio ratio;
+  ratio.ratio_value_ = 0.5;
+  ratio.numerator_ref_ = "light";
+  ratio.denominator_ref_ = "heavy";
+  ratio.description_.push_back("test ratio");
+  in[0].addRatio(ratio);
+
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  BinaryDataFile().store(tmp_filename, in);
+  BinaryDataFile().load(tmp_filename, out);
+
+  TEST_EQUAL(out.size(), in.size())
+  for (Size i = 0; i < in.size(); ++i)
+  {
+    TEST_EQUAL(out[i] == in[i], true)
+    TEST_EQUAL(out[i].getRatios().size(), in[i].getRatios().size())
+  }
+  TEST_REAL_SIMILAR(out[0].getRatios()[0].ratio_value_, 0.5)
+  TEST_EQUAL(out[0].getRatios()[0].description_[0], "test ratio")
+  TEST_EQUAL(out.getFileDescriptions().size(), in.getFileDescriptions().size())
+  TEST_EQUAL(out.getFileDescriptions()[0].filename, in.getFileDescriptions()[0].filename)
+  TEST_EQUAL(out.getFileDescriptions()[0].label, in.getFileDescriptions()[0].label)
+  TEST_EQUAL(out.getFileDescriptions()[0].size, in.getFileDescriptions()[0].size)
+  TEST_EQUAL(out.getExperimentType(), in.getExperimentType())
+  TEST_EQUAL(out.getProteinIdentifications() == in.getProteinIdentifications(), true)
+  TEST_EQUAL(out.getUnassignedPeptideIdentifications() == in.getUnassignedPeptideIdentifications(), true)
+  TEST_EQUAL(out.getDataProcessing() == in.getDataProcessing(), true)
+}
+END_SECTION
+
+START_SECTION(void store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids))
+{
+  NOT_TESTABLE // tested below
+}
+END_SECTION
+
+START_SECTION(void load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids))
+{
+  vector<ProteinIdentification> proteins_in, proteins_out;
+  vector<PeptideIdentification> peptides_in, peptides_out;
+  String document_id;
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), proteins_in, peptides_in, document_id);
+
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  BinaryDataFile().store(tmp_filename, proteins_in, peptides_in);
+  BinaryDataFile().load(tmp_filename, proteins_out, peptides_out);
+
+  TEST_EQUAL(proteins_out.size(), proteins_in.size())
+  TEST_EQUAL(proteins_out == proteins_in, true)
+  TEST_EQUAL(peptides_out.size(), peptides_in.size())
+  TEST_EQUAL(peptides_out == peptides_in, true)
+}
+END_SECTION
+
+START_SECTION(([EXTRA] load corrupt files))
+{
+  vector<ProteinIdentification> proteins_in(1), proteins_out;
+  vector<PeptideIdentification> peptides_in, peptides_out;
+  proteins_in[0].setIdentifier("run_1");
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  BinaryDataFile().store(tmp_filename, proteins_in, peptides_in);
+  std::string content;
+  {
+    std::ifstream is(tmp_filename.c_str(), std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+  }
+
+  // after the header (20 bytes): number of protein identifications, id and length of the first string
+  const Size count_positions[] = {20, 28};
+  const UInt32 counts[] = {std::numeric_limits<UInt32>::max(), 1000000};
+  for (Size p = 0; p < 2; ++p)
+  {
+    for (Size c = 0; c < 2; ++c)
+    {
+      std::string corrupt = content;
+      std::memcpy(&corrupt[count_positions[p]], &counts[c], sizeof(UInt32));
+      String corrupt_filename;
+      NEW_TMP_FILE(corrupt_filename);
+      {
+        std::ofstream os(corrupt_filename.c_str(), std::ios::binary);
+        os.write(corrupt.data(), corrupt.size());
+      }
+      TEST_EXCEPTION(Exception::ParseError, BinaryDataFile().load(corrupt_filename, proteins_out, peptides_out))
+    }
+  }
+
+  // truncated file
+  String truncated_filename;
+  NEW_TMP_FILE(truncated_filename);
+  {
+    std::ofstream os(truncated_filename.c_str(), std::ios::binary);
+    os.write(content.data(), content.size() - 1);
+  }
+  TEST_EXCEPTION(Exception::ParseError, BinaryDataFile().load(truncated_filename, proteins_out, peptides_out))
+}
+END_SECTION
+
+START_SECTION(static FileTypes::Type getFileType(const String& filename))
+{
+  String feature_file, consensus_file, id_file;
+  NEW_TMP_FILE(feature_file);
+  NEW_TMP_FILE(consensus_file);
+  NEW_TMP_FILE(id_file);
+  BinaryDataFile().store(feature_file, FeatureMap());
+  BinaryDataFile().store(consensus_file, ConsensusMap());
+  BinaryDataFile().store(id_file, vector<ProteinIdentification>(), vector<PeptideIdentification>());
+
+  TEST_EQUAL(BinaryDataFile::getFileType(feature_file), FileTypes::FEATUREBIN)
+  TEST_EQUAL(BinaryDataFile::getFileType(consensus_file), FileTypes::CONSENSUSBIN)
+  TEST_EQUAL(BinaryDataFile::getFileType(id_file), FileTypes::IDBIN)
+  TEST_EQUAL(BinaryDataFile::getFileType(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML")), FileTypes::UNKNOWN)
+  TEST_EQUAL(BinaryDataFile::getFileType("this_file_does_not_exist.featureBin"), FileTypes::UNKNOWN)
+
+  // temporary files have no meaningful extension, so the type is determined by content
+  TEST_EQUAL(FileHandler::getTypeByContent(feature_file), FileTypes::FEATUREBIN)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
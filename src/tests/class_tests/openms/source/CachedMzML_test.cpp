@@ -196,6 +196,32 @@ START_SECTION(( void writeMetadata(MapType exp, String out_meta, bool addCacheMe
 }
 END_SECTION
 
+START_SECTION(( static void createMetadata(MapType& exp, bool addCacheMetaValue=false) ))
+{
+  MSExperiment<> exp;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp);
+
+  // without adding the cache value, only the data should be gone
+  MSExperiment<> meta_exp = exp;
+  CachedmzML::createMetadata(meta_exp, false);
+  TEST_EQUAL(meta_exp.size(), exp.size())
+  TEST_EQUAL(meta_exp.getChromatograms().size(), exp.getChromatograms().size())
+  TEST_EQUAL(meta_exp[0].empty(), true)
+  TEST_EQUAL(meta_exp.getChromatogram(0).empty(), true)
+  TEST_EQUAL( (ExperimentalSettings)(meta_exp), (ExperimentalSettings)(exp) )
+  TEST_EQUAL( (SpectrumSettings)(meta_exp.getSpectrum(0)), (SpectrumSettings)(exp.getSpectrum(0)) )
+  TEST_EQUAL( (ChromatogramSettings)(meta_exp.getChromatogram(0)), (ChromatogramSettings)(exp.getChromatogram(0)) )
+
+  // adding the cache value appends a data processing entry to each spectrum / chromatogram
+  meta_exp = exp;
+  CachedmzML::createMetadata(meta_exp, true);
+  TEST_EQUAL(meta_exp[0].getDataProcessing().size(), exp[0].getDataProcessing().size() + 1)
+  TEST_EQUAL(meta_exp[0].getDataProcessing().back()->metaValueExists("cached_data"), true)
+  TEST_EQUAL(meta_exp.getChromatogram(0).getDataProcessing().back()->metaValueExists("cached_data"), true)
+  TEST_EQUAL( (ExperimentalSettings)(meta_exp), (ExperimentalSettings)(exp) )
+}
+END_SECTION
+
 // Create a single CachedMzML file and use it for the following computations
 // (may be somewhat faster)
 std::string tmp_filename;
@@ -147,6 +147,88 @@ START_SECTION((void operator()(DistanceMatrix< float > &original_distance, std::
 }
 END_SECTION
 
+START_SECTION(([EXTRA] void operator()(DistanceMatrix< float > &original_distance, std::vector<BinaryTreeNode>& cluster_tree, const float threshold=1) const))
+{
+	// tied distances, merge trees as given by the previous greedy implementation
+	DistanceMatrix<float> matrix(9,666);
+	matrix.setValue(1,0,0.75f);
+	matrix.setValue(2,0,0.75f);
+	matrix.setValue(2,1,0.5f);
+	matrix.setValue(3,0,1.0f);
+	matrix.setValue(3,1,1.0f);
+	matrix.setValue(3,2,1.0f);
+	matrix.setValue(4,0,0.5f);
+	matrix.setValue(4,1,0.5f);
+	matrix.setValue(4,2,0.75f);
+	matrix.setValue(4,3,0.5f);
+	matrix.setValue(5,0,1.0f);
+	matrix.setValue(5,1,0.5f);
+	matrix.setValue(5,2,0.5f);
+	matrix.setValue(5,3,0.75f);
+	matrix.setValue(5,4,0.75f);
+	matrix.setValue(6,0,0.5f);
+	matrix.setValue(6,1,0.5f);
+	matrix.setValue(6,2,1.0f);
+	matrix.setValue(6,3,0.5f);
+	matrix.setValue(6,4,0.25f);
+	matrix.setValue(6,5,0.25f);
+	matrix.setValue(7,0,1.0f);
+	matrix.setValue(7,1,0.5f);
+	matrix.setValue(7,2,0.5f);
+	matrix.setValue(7,3,0.25f);
+	matrix.setValue(7,4,0.25f);
+	matrix.setValue(7,5,1.0f);
+	matrix.setValue(7,6,0.25f);
+	matrix.setValue(8,0,0.25f);
+	matrix.setValue(8,1,1.0f);
+	matrix.setValue(8,2,0.75f);
+	matrix.setValue(8,3,0.75f);
+	matrix.setValue(8,4,0.5f);
+	matrix.setValue(8,5,1.0f);
+	matrix.setValue(8,6,0.5f);
+	matrix.setValue(8,7,0.25f);
+	DistanceMatrix<float> matrix2(matrix);
+
+	vector< BinaryTreeNode > result;
+	vector< BinaryTreeNode > tree;
+	tree.push_back(BinaryTreeNode(4,6,0.25f));
+	tree.push_back(BinaryTreeNode(3,7,0.25f));
+	tree.push_back(BinaryTreeNode(0,8,0.25f));
+	tree.push_back(BinaryTreeNode(1,2,0.5f));
+	tree.push_back(BinaryTreeNode(0,4,0.5f));
+	tree.push_back(BinaryTreeNode(1,5,0.5f));
+	tree.push_back(BinaryTreeNode(0,1,1.0f));
+	tree.push_back(BinaryTreeNode(0,3,1.0f));
+
+	(*ptr)(matrix,result,2.0f);
+	TEST_EQUAL(tree.size(), result.size());
+	for (Size i = 0; i < result.size(); ++i)
+	{
+			TEST_EQUAL(tree[i].left_child, result[i].left_child);
+			TEST_EQUAL(tree[i].right_child, result[i].right_child);
+			TOLERANCE_ABSOLUTE(0.0001);
+			TEST_REAL_SIMILAR(tree[i].distance, result[i].distance);
+	}
+
+	float th(0.6f);
+	tree.pop_back();
+	tree.pop_back();
+	tree.push_back(BinaryTreeNode(0,1,-1.0f));
+	tree.push_back(BinaryTreeNode(0,3,-1.0f));
+	result.clear();
+
+	(*ptr)(matrix2,result,th);
+	TEST_EQUAL(tree.size(), result.size());
+	for (Size i = 0; i < result.size(); ++i)
+	{
+			TEST_EQUAL(tree[i].left_child, result[i].left_child);
+			TEST_EQUAL(tree[i].right_child, result[i].right_child);
+			TOLERANCE_ABSOLUTE(0.0001);
+			TEST_REAL_SIMILAR(tree[i].distance, result[i].distance);
+	}
+}
+END_SECTION
+
 START_SECTION((static const String getProductName()))
 {
   TEST_EQUAL(ptr->getProductName(), "CompleteLinkage")
@@ -180,7 +180,7 @@ START_SECTION(bool hasElement(const Element* element) const)
   TEST_EQUAL(e_ptr->hasElement(e), false)
 END_SECTION
 
-START_SECTION(bool contains(const EmpiricalFormula& ef))
+START_SECTION(bool contains(const EmpiricalFormula& ef) const)
 
   EmpiricalFormula metabolite("C12H36N2");
 
@@ -39,6 +39,7 @@
 
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/FileTypes.h>
+#include <OpenMS/SYSTEM/File.h>
 
 ///////////////////////////
 
@@ -237,6 +238,85 @@ TEST_EQUAL(fh.getTypeByContent(filename), FileTypes::MZML)
 //other types cannot be tested, because the NEW_TMP_FILE template does not support file extensions...
 END_SECTION
 
+START_SECTION((bool storeFeatures(const String &filename, const FeatureMap &map)))
+FileHandler fh;
+FeatureMap map, map2;
+fh.loadFeatures(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_2_options.featureXML"), map);
+String filename;
+NEW_TMP_FILE(filename)
+// the type is taken from the extension
+TEST_EQUAL(fh.storeFeatures(filename, map), false)
+String bin_filename = filename + ".featureBin";
+TEST_EQUAL(fh.storeFeatures(bin_filename, map), true)
+TEST_EQUAL(fh.getType(bin_filename), FileTypes::FEATUREBIN)
+TEST_EQUAL(fh.loadFeatures(bin_filename, map2), true)
+TEST_EQUAL(map2.size(), 7)
+File::remove(bin_filename);
+END_SECTION
+
+START_SECTION((bool loadConsensusFeatures(const String &filename, ConsensusMap &map, FileTypes::Type force_type = FileTypes::UNKNOWN)))
+FileHandler fh;
+ConsensusMap map, map2;
+TEST_EQUAL(fh.loadConsensusFeatures("test.bla", map), false)
+TEST_EQUAL(fh.loadConsensusFeatures(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), map), true)
+TEST_EQUAL(map.empty(), false)
+
+// binary files are recognized by content
+String filename;
+NEW_TMP_FILE(filename)
+BinaryDataFile().store(filename, map);
+TEST_EQUAL(fh.loadConsensusFeatures(filename, map2), true)
+TEST_EQUAL(map2.size(), map.size())
+END_SECTION
+
+START_SECTION((bool storeConsensusFeatures(const String &filename, const ConsensusMap &map)))
+FileHandler fh;
+ConsensusMap map, map2;
+fh.loadConsensusFeatures(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), map);
+String filename;
+NEW_TMP_FILE(filename)
+TEST_EQUAL(fh.storeConsensusFeatures(filename, map), false)
+String bin_filename = filename + ".consensusBin";
+TEST_EQUAL(fh.storeConsensusFeatures(bin_filename, map), true)
+TEST_EQUAL(fh.loadConsensusFeatures(bin_filename, map2), true)
+TEST_EQUAL(map2.size(), map.size())
+File::remove(bin_filename);
+END_SECTION
+
+START_SECTION((bool loadIdentifications(const String &filename, std::vector<ProteinIdentification> &protein_ids, std::vector<PeptideIdentification> &peptide_ids, FileTypes::Type force_type = FileTypes::UNKNOWN)))
+FileHandler fh;
+vector<ProteinIdentification> proteins, proteins2;
+vector<PeptideIdentification> peptides, peptides2;
+TEST_EQUAL(fh.loadIdentifications("test.bla", proteins, peptides), false)
+TEST_EQUAL(fh.loadIdentifications(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), proteins, peptides), true)
+TEST_EQUAL(proteins.empty(), false)
+TEST_EQUAL(peptides.empty(), false)
+
+// binary files are recognized by content
+String filename;
+NEW_TMP_FILE(filename)
+BinaryDataFile().store(filename, proteins, peptides);
+TEST_EQUAL(fh.loadIdentifications(filename, proteins2, peptides2), true)
+TEST_EQUAL(proteins2 == proteins, true)
+TEST_EQUAL(peptides2 == peptides, true)
+END_SECTION
+
+START_SECTION((bool storeIdentifications(const String &filename, const std::vector<ProteinIdentification> &protein_ids, const std::vector<PeptideIdentification> &peptide_ids)))
+FileHandler fh;
+vector<ProteinIdentification> proteins, proteins2;
+vector<PeptideIdentification> peptides, peptides2;
+fh.loadIdentifications(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), proteins, peptides);
+String filename;
+NEW_TMP_FILE(filename)
+TEST_EQUAL(fh.storeIdentifications(filename, proteins, peptides), false)
+String bin_filename = filename + ".idBin";
+TEST_EQUAL(fh.storeIdentifications(bin_filename, proteins, peptides), true)
+TEST_EQUAL(fh.loadIdentifications(bin_filename, proteins2, peptides2), true)
+TEST_EQUAL(proteins2 == proteins, true)
+TEST_EQUAL(peptides2 == peptides, true)
+File::remove(bin_filename);
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -41,13 +41,42 @@
 
 ///////////////////////////
 
+using namespace OpenMS;
+
+// gives access to the exact integration, which is used for data that is not (nearly) equally spaced
+class GaussFilterAlgorithmExact :
+  public GaussFilterAlgorithm
+{
+public:
+  void filterExact(const std::vector<double> & mz, const std::vector<double> & intensities, std::vector<double> & intensities_out)
+  {
+    intensities_out.resize(mz.size());
+    for (Size i = 0; i < mz.size(); ++i)
+    {
+      intensities_out[i] = integrate_(mz.begin() + i, intensities.begin() + i, mz.begin(), mz.end());
+    }
+  }
+};
+
+// profile spectrum with the given spacing at m/z 400, growing with m/z to the power of 'exponent'
+void createProfileSpectrum(double spacing, double exponent, std::vector<double> & mz, std::vector<double> & intensities)
+{
+  mz.clear();
+  intensities.clear();
+  for (double pos = 400.0; pos < 1600.0; pos += spacing * pow(pos / 400.0, exponent))
+  {
+    mz.push_back(pos);
+    // a peak every 1.3 Th on a constant background
+    double offset = fmod(pos, 1.3) - 0.65;
+    intensities.push_back(100.0 + 1e5 * exp(-offset * offset / (2 * 0.004 * 0.004)));
+  }
+}
+
 START_TEST(GaussFilterAlgorithm<D>, "$Id$")
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 
-using namespace OpenMS;
-
 GaussFilterAlgorithm* dgauss_ptr = 0;
 GaussFilterAlgorithm* dgauss_nullPointer = 0;
 
@@ -187,6 +216,84 @@ START_SECTION((bool filter(OpenMS::Interfaces::ChromatogramPtr chromatogram)))
   TEST_REAL_SIMILAR(chromatogram->getIntensityArray()->data[8],0.000881793)
 END_SECTION 
 
+START_SECTION(([EXTRA] equally spaced data))
+{
+  // uses the precomputed kernel, which has to give the same result as the exact integration
+  std::vector<double> mz, intensities, mz_out, intensities_out, intensities_exact;
+  for (Size i = 0; i < 500; ++i)
+  {
+    mz.push_back(500.0 + 0.002 * i);
+    intensities.push_back((i % 7) * 10.0 + (i % 3));
+  }
+  mz_out.resize(mz.size());
+  intensities_out.resize(mz.size());
+
+  TOLERANCE_RELATIVE(1.0 + 1e-8)
+  // kernel widths which are / are not a multiple of the data spacing
+  double widths[] = {0.01, 0.02, 0.037, 0.1};
+  for (Size w = 0; w < 4; ++w)
+  {
+    GaussFilterAlgorithmExact gauss;
+    gauss.initialize(widths[w], 0.01, 10.0, false);
+    gauss.filter(mz.begin(), mz.end(), intensities.begin(), mz_out.begin(), intensities_out.begin());
+    gauss.filterExact(mz, intensities, intensities_exact);
+    for (Size i = 0; i < mz.size(); ++i)
+    {
+      TEST_REAL_SIMILAR(mz_out[i], mz[i])
+      TEST_REAL_SIMILAR(intensities_out[i], intensities_exact[i])
+    }
+  }
+}
+END_SECTION
+
+START_SECTION(([EXTRA] nearly equally spaced profile data))
+{
+  // Orbitrap: spacing grows with m/z^1.5, TOF: spacing grows with sqrt(m/z)
+  double spacings[] = {0.0015, 0.005};
+  double exponents[] = {1.5, 0.5};
+  for (Size k = 0; k < 2; ++k)
+  {
+    std::vector<double> mz, intensities, intensities_exact;
+    createProfileSpectrum(spacings[k], exponents[k], mz, intensities);
+    // gaps in the data, where the tabulated kernel cannot be used
+    for (Size i = mz.size() / 3; i < mz.size() / 3 + 100; ++i)
+    {
+      mz[i] += 0.5;
+    }
+    for (Size i = mz.size() / 3 + 100; i < mz.size(); ++i)
+    {
+      mz[i] += 1.0;
+    }
+    std::vector<double> mz_out(mz.size()), intensities_out(mz.size());
+
+    // the kernel is off by at most 1e-4 of its maximum for every neighbor
+    TOLERANCE_RELATIVE(1.0 + 2e-3)
+    GaussFilterAlgorithmExact gauss;
+    gauss.initialize(0.2, 0.01, 10.0, false);
+    gauss.filter(mz.begin(), mz.end(), intensities.begin(), mz_out.begin(), intensities_out.begin());
+    gauss.filterExact(mz, intensities, intensities_exact);
+    TEST_EQUAL(mz_out == mz, true)
+    for (Size i = 0; i < mz.size(); ++i)
+    {
+      TEST_REAL_SIMILAR(intensities_out[i], intensities_exact[i])
+    }
+
+    // m/z values with single precision are not equally spaced enough, they are integrated exactly
+    for (Size i = 0; i < mz.size(); ++i)
+    {
+      mz[i] = (float)mz[i];
+    }
+    TOLERANCE_RELATIVE(1.0 + 1e-8)
+    gauss.filter(mz.begin(), mz.end(), intensities.begin(), mz_out.begin(), intensities_out.begin());
+    gauss.filterExact(mz, intensities, intensities_exact);
+    for (Size i = 0; i < mz.size(); ++i)
+    {
+      TEST_REAL_SIMILAR(intensities_out[i], intensities_exact[i])
+    }
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
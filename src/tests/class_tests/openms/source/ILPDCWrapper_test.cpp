@@ -42,6 +42,8 @@
 #include <OpenMS/DATASTRUCTURES/MassExplainer.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/CHEMISTRY/EmpiricalFormula.h>
+#include <OpenMS/DATASTRUCTURES/ChargePair.h>
+#include <OpenMS/DATASTRUCTURES/Compomer.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -67,7 +69,7 @@ START_SECTION(virtual ~ILPDCWrapper())
 END_SECTION
 
 
-START_SECTION((double compute(const FeatureMap fm, PairsType &pairs, Size verbose_level) const))
+START_SECTION((double compute(const FeatureMap &fm, PairsType &pairs, Size verbose_level) const))
 {
   EmpiricalFormula ef("H1");
   Adduct a(+1, 1, ef.getMonoWeight(), "H1", 0.1, 0, "");
@@ -83,6 +85,30 @@ START_SECTION((double compute(const FeatureMap fm, PairsType &pairs, Size verbos
   // check that it runs without pairs (i.e. all clusters are singletons)
   TEST_EQUAL(pairs.size(), 0);
 
+  // many independent components, which are split into several slices
+  FeatureMap fm_large;
+  fm_large.resize(3000);
+  for (Size i = 0; i < 1500; ++i)
+  {
+    pairs.push_back(ChargePair(2 * i, 2 * i + 1, 1, 1, Compomer(), 0.0, false));
+  }
+  double score = iw.compute(fm_large, pairs, 1);
+  TEST_REAL_SIMILAR(score, 1500.0) // objective summed over all slices
+  ABORT_IF(pairs.size() != 1500)
+  Size active(0);
+  double active_edge_score(0);
+  for (Size i = 0; i < pairs.size(); ++i)
+  {
+    if (pairs[i].isActive())
+    {
+      ++active;
+      active_edge_score += pairs[i].getEdgeScore();
+    }
+  }
+  TEST_EQUAL(active, 1500)
+  // the edge scores of all slices are written back (once) to the pairs
+  TEST_REAL_SIMILAR(active_edge_score, score)
+
   // real data test
 
 
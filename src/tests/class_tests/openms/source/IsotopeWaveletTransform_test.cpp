@@ -46,6 +46,35 @@
 using namespace OpenMS;
 using namespace std;
 
+// the convolution of getTransform() evaluated at a single data point, as it was computed before the
+// transforms of all charge states were distributed over the threads together
+double serialTransform(const MSSpectrum<Peak1D>& c_ref, const Int my_local_pos, const UInt c, const double min_spacing)
+{
+  Int spec_size((Int)c_ref.size());
+  Int from_max_to_left((UInt) (Constants::IW_QUARTER_NEUTRON_MASS / min_spacing));
+  UInt charge = c + 1;
+  double T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(c_ref[my_local_pos].getMZ(), charge) / (double)charge;
+  double old = 0, value = 0, c_diff = 0;
+  double old_pos = (my_local_pos - from_max_to_left - 1 >= 0) ? c_ref[my_local_pos - from_max_to_left - 1].getMZ() : c_ref[0].getMZ() - min_spacing;
+  double my_local_lambda = IsotopeWavelet::getLambdaL(c_ref[my_local_pos].getMZ() * charge);
+  double origin = -c_ref[my_local_pos].getMZ() + Constants::IW_QUARTER_NEUTRON_MASS / (double)charge;
+  for (Int current_conv_pos = std::max(0, my_local_pos - from_max_to_left); c_diff < T_boundary_right; ++current_conv_pos)
+  {
+    if (current_conv_pos >= spec_size)
+    {
+      value += 0.5 * old * min_spacing;
+      break;
+    }
+    double c_mz = c_ref[current_conv_pos].getMZ();
+    c_diff = c_mz + origin;
+    double current = c_diff > 0 && c_diff <= T_boundary_right ? IsotopeWavelet::getValueByLambda(my_local_lambda, c_diff * charge + 1.) * c_ref[current_conv_pos].getIntensity() : 0;
+    value += 0.5 * (current + old) * (c_mz - old_pos);
+    old = current;
+    old_pos = c_mz;
+  }
+  return value;
+}
+
 START_TEST(IsotopeWaveletTransform, "$Id$")
 
 MSExperiment<> map;
@@ -196,6 +225,40 @@ START_SECTION(double getLinearInterpolation(const double mz_a, const double inte
 END_SECTION
 
 
+START_SECTION(void getTransforms(std::vector<MSSpectrum<PeakType> >& c_trans, const MSSpectrum<PeakType>& c_ref, const bool high_res=false))
+	IsotopeWaveletTransform<Peak1D> iw3 (map[0].begin()->getMZ(), (map[0].end()-1)->getMZ(), 3);
+	iw3.initializeScan (map[0]);
+
+	std::vector<MSSpectrum<Peak1D> > c_trans (3, map[0]);
+	iw3.getTransforms (c_trans, map[0]);
+	for (UInt c = 0; c < 3; ++c)
+	{
+		MSSpectrum<Peak1D> single (map[0]);
+		iw3.getTransform (single, map[0], c);
+		TEST_EQUAL (c_trans[c].size(), map[0].size())
+		for (Size k = 0; k < single.size(); ++k)
+		{
+			TEST_REAL_SIMILAR (c_trans[c][k].getIntensity(), single[k].getIntensity())
+		}
+		for (Size k = 0; k < map[0].size(); k += 25)
+		{
+			TEST_REAL_SIMILAR (c_trans[c][k].getIntensity(), serialTransform(map[0], (Int)k, c, iw3.getMinSpacing()))
+		}
+	}
+
+	std::vector<MSSpectrum<Peak1D> > c_trans_hr (3, map[0]);
+	iw3.getTransforms (c_trans_hr, map[0], true);
+	for (UInt c = 0; c < 3; ++c)
+	{
+		MSSpectrum<Peak1D> single (map[0]);
+		iw3.getTransformHighRes (single, map[0], c);
+		for (Size k = 0; k < single.size(); ++k)
+		{
+			TEST_REAL_SIMILAR (c_trans_hr[c][k].getIntensity(), single[k].getIntensity())
+		}
+	}
+END_SECTION
+
 START_SECTION(~IsotopeWaveletTransform())
 	delete (iw);
 END_SECTION
@@ -48,6 +48,8 @@
 
 #include <boost/regex.hpp>
 
+#include <QtCore/QThread>
+
 // OpenMP support
 #ifdef _OPENMP
 	#include <omp.h>
@@ -58,6 +60,25 @@
 
 using namespace OpenMS;
 using namespace Logger;
+
+// writes an unfinished line to the given log
+class UnfinishedLineThread :
+  public QThread
+{
+public:
+  explicit UnfinishedLineThread(LogStream & log) :
+    log_(log)
+  {
+  }
+
+protected:
+  void run()
+  {
+    log_ << "unfinished";
+  }
+
+  LogStream & log_;
+};
 using namespace std;
 
 class TestTarget
@@ -141,6 +162,38 @@ START_SECTION((virtual ~LogStream()))
 	}
 	TEST_EQUAL(stream_by_logger.str(),"flushtest\nunfinishedline...\n")
 
+  // unfinished lines of all threads are distributed, not only the one of the destructing thread
+  ostringstream stream_by_threads;
+  Size num_threads = 1;
+  {
+    LogStream* l2 = new LogStream(new LogStreamBuf());
+    l2->insert(stream_by_threads);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(4)
+#endif
+    {
+      *l2 << "unfinished";
+#ifdef _OPENMP
+#pragma omp master
+      num_threads = omp_get_num_threads();
+#endif
+    }
+    TEST_EQUAL(stream_by_threads.str(), "")
+    delete l2;
+  }
+  TEST_EQUAL(stream_by_threads.str().size(), num_threads * String("unfinished\n").size())
+
+  // the unfinished line of a thread is distributed when the thread ends
+  ostringstream stream_by_thread;
+  {
+    LogStream l3(new LogStreamBuf());
+    l3.insert(stream_by_thread);
+    UnfinishedLineThread thread(l3);
+    thread.start();
+    thread.wait();
+    TEST_EQUAL(stream_by_thread.str(), "unfinished\n")
+  }
+  TEST_EQUAL(stream_by_thread.str(), "unfinished\n")
 }
 END_SECTION
 
@@ -210,6 +263,21 @@ START_SECTION((void remove(std::ostream &s)))
 }
 END_SECTION
 
+START_SECTION((bool hasStreams() const))
+{
+  LogStream l1(new LogStreamBuf());
+  TEST_EQUAL(l1.hasStreams(), false)
+  ostringstream stream_by_logger;
+  l1.insert(stream_by_logger);
+  TEST_EQUAL(l1.hasStreams(), true)
+  l1.remove(stream_by_logger);
+  TEST_EQUAL(l1.hasStreams(), false)
+
+  LogStream l2(0);
+  TEST_EQUAL(l2.hasStreams(), false)
+}
+END_SECTION
+
 START_SECTION((void insertNotification(std::ostream &s, LogStreamNotifier &target)))
 {
   LogStream l1(new LogStreamBuf());
@@ -504,6 +572,12 @@ START_SECTION(([EXTRA] Macro test - LOG_DEBUG))
     std::cerr << i << ":" << to_validate_list[i] << std::endl;
     TEST_EQUAL(regex_match(to_validate_list[i], rx), true)
   }
+
+  // without attached streams, the arguments are not evaluated at all
+  Log_debug.remove(stream_by_logger);
+  Size evaluated = 0;
+  LOG_DEBUG << ++evaluated << endl;
+  TEST_EQUAL(evaluated, 0)
 }
 END_SECTION
 
@@ -40,6 +40,7 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/MRMTransitionGroupPicker.h>
 ///////////////////////////
 #include <OpenMS/ANALYSIS/OPENSWATH/MRMFeatureFinderScoring.h>
 
@@ -50,6 +51,62 @@ using namespace std;
 
 typedef std::map<String, MRMTransitionGroup< MSSpectrum <ChromatogramPeak>, OpenSwath::LightTransition > > TransitionGroupMapType;
 
+// spectrum access which counts the spectra retrieved from the underlying map
+class CountingSpectrumAccess :
+  public OpenSwath::ISpectrumAccess
+{
+public:
+  CountingSpectrumAccess(OpenSwath::SpectrumAccessPtr sptr) :
+    sptr_(sptr),
+    spectra_retrieved(0)
+  {
+  }
+
+  boost::shared_ptr<OpenSwath::ISpectrumAccess> lightClone() const
+  {
+    return boost::shared_ptr<CountingSpectrumAccess>(new CountingSpectrumAccess(*this));
+  }
+
+  OpenSwath::SpectrumPtr getSpectrumById(int id)
+  {
+    ++spectra_retrieved;
+    return sptr_->getSpectrumById(id);
+  }
+
+  std::vector<std::size_t> getSpectraByRT(double RT, double deltaRT) const
+  {
+    return sptr_->getSpectraByRT(RT, deltaRT);
+  }
+
+  size_t getNrSpectra() const
+  {
+    return sptr_->getNrSpectra();
+  }
+
+  OpenSwath::SpectrumMeta getSpectrumMetaById(int id) const
+  {
+    return sptr_->getSpectrumMetaById(id);
+  }
+
+  OpenSwath::ChromatogramPtr getChromatogramById(int id)
+  {
+    return sptr_->getChromatogramById(id);
+  }
+
+  std::size_t getNrChromatograms() const
+  {
+    return sptr_->getNrChromatograms();
+  }
+
+  std::string getChromatogramNativeID(int id) const
+  {
+    return sptr_->getChromatogramNativeID(id);
+  }
+
+  OpenSwath::SpectrumAccessPtr sptr_;
+  Size spectra_retrieved;
+};
+
 START_TEST(MRMFeatureFinderScoring, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -162,6 +219,18 @@ START_SECTION(void pickExperiment(OpenSwath::SpectrumAccessPtr input, FeatureMap
   TEST_REAL_SIMILAR(feature.getMetaValue("sn_ratio"), 30.18);
   TEST_REAL_SIMILAR(feature.getMetaValue("var_log_sn_score"), 3.40718216971789);
 
+  // exceptions thrown while picking (in parallel) reach the caller with their type
+  MRMFeatureFinderScoring ff_throw;
+  Param throw_param = ff_throw.getDefaults();
+  throw_param.setValue("TransitionGroupPicker:background_subtraction", "smoothed");
+  ff_throw.setParameters(throw_param);
+  FeatureMap throw_features;
+  TransitionGroupMapType throw_transition_group_map;
+#ifdef USE_SP_INTERFACE
+  TEST_EXCEPTION(Exception::NotImplemented, ff_throw.pickExperiment(chromatogram_ptr, throw_features, transitions, trafo, swath_ptr, throw_transition_group_map))
+#else
+  TEST_EXCEPTION(Exception::NotImplemented, ff_throw.pickExperiment(exp, throw_features, transitions, trafo, *swath_map, throw_transition_group_map))
+#endif
 }
 END_SECTION
 
@@ -310,7 +379,67 @@ END_SECTION
 
 START_SECTION( void scorePeakgroups(MRMTransitionGroupType& transition_group, TransformationDescription & trafo, OpenSwath::SpectrumAccessPtr swath_map, FeatureMap& output) ) 
 {
-  NOT_TESTABLE // tested above
+  // the scores are tested above, here we test that the (added) spectra are
+  // reused across transition groups
+  MRMFeatureFinderScoring ff;
+  FeatureMap featureFile;
+  TransformationDescription trafo;
+  TransitionGroupMapType transition_group_map;
+
+  boost::shared_ptr<PeakMap> exp (new PeakMap);
+  OpenSwath::LightTargetedExperiment transitions;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("OpenSwath_generic_input.mzML"), *exp);
+  {
+    TargetedExperiment transition_exp_;
+    TraMLFile().load(OPENMS_GET_TEST_DATA_PATH("OpenSwath_generic_input.TraML"), transition_exp_);
+    OpenSwathDataAccessHelper::convertTargetedExp(transition_exp_, transitions);
+  }
+
+  // a single SWATH spectrum after all peakgroups: it is the closest spectrum of all of them
+  boost::shared_ptr<PeakMap> swath_map (new PeakMap);
+  MSSpectrum<> s;
+  Peak1D p;
+  p.setMZ(500.0);
+  p.setIntensity(100.0);
+  s.push_back(p);
+  p.setMZ(600.0);
+  s.push_back(p);
+  s.setRT(5000.0);
+  swath_map->addSpectrum(s);
+  CountingSpectrumAccess* counting_swath = new CountingSpectrumAccess(SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(swath_map));
+  OpenSwath::SpectrumAccessPtr swath_ptr(counting_swath);
+
+  ff.prepareProteinPeptideMaps_(transitions);
+  OpenSwath::SpectrumAccessPtr chromatogram_ptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+  ff.mapExperimentToTransitionList(chromatogram_ptr, transitions, transition_group_map, trafo, -1);
+  TEST_EQUAL(transition_group_map.size(), 2)
+
+  MRMTransitionGroupPicker trgroup_picker;
+  trgroup_picker.setParameters(ff.getParameters().copy("TransitionGroupPicker:", true));
+  for (TransitionGroupMapType::iterator trgroup_it = transition_group_map.begin(); trgroup_it != transition_group_map.end(); ++trgroup_it)
+  {
+    trgroup_picker.pickTransitionGroup(trgroup_it->second);
+    ff.scorePeakgroups(trgroup_it->second, trafo, swath_ptr, featureFile);
+  }
+
+  // all three peakgroups of both transition groups were scored against the
+  // SWATH spectrum, but it was only retrieved once
+  TEST_EQUAL(featureFile.size(), 3)
+  TEST_EQUAL(counting_swath->spectra_retrieved, 1)
+  TEST_EQUAL(featureFile[0].metaValueExists("var_dotprod_score"), true)
+  TEST_EQUAL(featureFile[2].metaValueExists("var_dotprod_score"), true)
+
+  // setting the same parameters keeps the cached spectrum ...
+  ff.setParameters(ff.getParameters());
+  ff.scorePeakgroups(transition_group_map["tr_gr1"], trafo, swath_ptr, featureFile);
+  TEST_EQUAL(counting_swath->spectra_retrieved, 1)
+
+  // ... while changing how spectra are added up requires new spectra
+  Param ff_param = ff.getParameters();
+  ff_param.setValue("add_up_spectra", 3);
+  ff.setParameters(ff_param);
+  ff.scorePeakgroups(transition_group_map["tr_gr1"], trafo, swath_ptr, featureFile);
+  TEST_EQUAL(counting_swath->spectra_retrieved, 2)
 }
 END_SECTION
 
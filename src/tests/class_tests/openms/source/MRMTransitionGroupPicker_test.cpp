@@ -216,6 +216,51 @@ START_SECTION((template < typename SpectrumT, typename TransitionT > void pickTr
 }
 END_SECTION
 
+START_SECTION(([EXTRA] pickTransitionGroup with a reused picker and peak quality gives the same features for every group))
+{
+  // the resampling scratch chromatograms are reused for all transitions of a
+  // feature: picking several groups (also computing the peak quality, which
+  // resamples with wider boundaries) must give the same features every time
+  MRMTransitionGroupPicker trgroup_picker;
+  Param picker_param = trgroup_picker.getDefaults();
+  picker_param.setValue("compute_peak_quality", "true");
+  trgroup_picker.setParameters(picker_param);
+
+  std::vector<MRMFeature> features;
+  for (Size i = 0; i < 3; ++i)
+  {
+    MRMTransitionGroupType transition_group;
+    setup_transition_group(transition_group);
+    trgroup_picker.pickTransitionGroup(transition_group);
+    TEST_EQUAL(transition_group.getFeatures().size(), 1)
+    ABORT_IF(transition_group.getFeatures().size() != 1)
+    features.push_back(transition_group.getFeatures()[0]);
+  }
+
+  // same values as with the default parameters (see above)
+  TEST_REAL_SIMILAR(features[0].getRT(), 1492.83060);
+  TEST_REAL_SIMILAR(features[0].getMetaValue("leftWidth"), 1481.84);
+  TEST_REAL_SIMILAR(features[0].getMetaValue("rightWidth"), 1501.23);
+  TEST_REAL_SIMILAR(features[0].getFeature("2").getIntensity(), 507385.32);
+  TEST_REAL_SIMILAR(features[0].getFeature("1").getIntensity(), 59989.8287208466);
+  TEST_REAL_SIMILAR(features[0].getPrecursorFeature("Precursor_i0").getIntensity(), 53900 - 875.9514);
+  TEST_EQUAL(features[0].metaValueExists("initialPeakQuality"), true)
+
+  for (Size i = 1; i < features.size(); ++i)
+  {
+    TEST_EQUAL(features[i].getRT(), features[0].getRT())
+    TEST_EQUAL(features[i].getIntensity(), features[0].getIntensity())
+    TEST_EQUAL(features[i].getOverallQuality(), features[0].getOverallQuality())
+    TEST_EQUAL(features[i].getMetaValue("potentialOutlier"), features[0].getMetaValue("potentialOutlier"))
+    TEST_EQUAL(features[i].getFeature("1").getIntensity(), features[0].getFeature("1").getIntensity())
+    TEST_EQUAL(features[i].getFeature("2").getIntensity(), features[0].getFeature("2").getIntensity())
+    TEST_EQUAL(features[i].getFeature("1").getConvexHulls()[0].getHullPoints() == features[0].getFeature("1").getConvexHulls()[0].getHullPoints(), true)
+    TEST_EQUAL(features[i].getFeature("2").getConvexHulls()[0].getHullPoints() == features[0].getFeature("2").getConvexHulls()[0].getHullPoints(), true)
+    TEST_EQUAL(features[i].getPrecursorFeature("Precursor_i0").getIntensity(), features[0].getPrecursorFeature("Precursor_i0").getIntensity())
+  }
+}
+END_SECTION
+
 START_SECTION((template <typename SpectrumT, typename TransitionT> MRMFeature createMRMFeature(MRMTransitionGroup<SpectrumT, TransitionT>& transition_group, std::vector<SpectrumT>& picked_chroms, int& chr_idx, int& peak_idx)))
 {
   MRMTransitionGroupType transition_group;
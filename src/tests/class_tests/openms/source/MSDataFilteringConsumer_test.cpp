@@ -0,0 +1,151 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataFilteringConsumer.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FILTERING/SMOOTHING/GaussFilter.h>
+#include <OpenMS/FILTERING/BASELINE/MorphologicalFilter.h>
+
+using namespace OpenMS;
+
+// collects everything it consumes, in order
+class CollectingConsumer :
+  public Interfaces::IMSDataConsumer<>
+{
+public:
+  void consumeSpectrum(SpectrumType & s) { exp.addSpectrum(s); }
+  void consumeChromatogram(ChromatogramType & c) { exp.addChromatogram(c); }
+  void setExpectedSize(Size, Size) {}
+  void setExperimentalSettings(const ExperimentalSettings &) {}
+
+  MSExperiment<> exp;
+};
+
+START_TEST(MSDataFilteringConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+MSDataFilteringConsumer<GaussFilter>* ptr = 0;
+MSDataFilteringConsumer<GaussFilter>* null_ptr = 0;
+CollectingConsumer collector;
+
+START_SECTION((MSDataFilteringConsumer(const FilterType & filter, Interfaces::IMSDataConsumer<> * next_consumer, bool filter_chromatograms = true, Size batch_size = 100)))
+  ptr = new MSDataFilteringConsumer<GaussFilter>(GaussFilter(), &collector);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+END_SECTION
+
+START_SECTION((virtual ~MSDataFilteringConsumer()))
+  delete ptr;
+END_SECTION
+
+START_SECTION((void flush()))
+{
+  MSExperiment<> exp;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp);
+  TEST_EQUAL(exp.getNrSpectra() > 0, true)
+  TEST_EQUAL(exp.getNrChromatograms() > 0, true)
+
+  // batches smaller than the data: the result is the same as filtering the experiment
+  GaussFilter gauss;
+  Param p = gauss.getParameters();
+  p.setValue("gaussian_width", 1.0);
+  gauss.setParameters(p);
+  MSExperiment<> expected = exp;
+  gauss.filterExperiment(expected);
+
+  CollectingConsumer next;
+  MSDataFilteringConsumer<GaussFilter> consumer(gauss, &next, true, 2);
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    consumer.consumeSpectrum(exp[i]);
+  }
+  for (Size i = 0; i < exp.getChromatograms().size(); ++i)
+  {
+    consumer.consumeChromatogram(exp.getChromatogram(i));
+  }
+  TEST_EQUAL(next.exp.size() < exp.size(), true) // the last batch is still pending
+  consumer.flush();
+
+  ABORT_IF(next.exp.size() != expected.size())
+  for (Size i = 0; i < expected.size(); ++i)
+  {
+    TEST_EQUAL(next.exp[i] == expected[i], true)
+  }
+  ABORT_IF(next.exp.getChromatograms().size() != expected.getChromatograms().size())
+  for (Size i = 0; i < expected.getChromatograms().size(); ++i)
+  {
+    TEST_EQUAL(next.exp.getChromatogram(i) == expected.getChromatogram(i), true)
+  }
+}
+END_SECTION
+
+START_SECTION((virtual void consumeChromatogram(ChromatogramType & c)))
+{
+  // chromatograms are passed on unchanged if requested
+  MSExperiment<> exp;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp);
+  CollectingConsumer next;
+  {
+    MSDataFilteringConsumer<MorphologicalFilter> consumer(MorphologicalFilter(), &next, false);
+    consumer.consumeChromatogram(exp.getChromatogram(0));
+  } // flushed on destruction
+  ABORT_IF(next.exp.getChromatograms().size() != 1)
+  TEST_EQUAL(next.exp.getChromatogram(0) == exp.getChromatogram(0), true)
+}
+END_SECTION
+
+START_SECTION((virtual void consumeSpectrum(SpectrumType & s)))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((virtual void setExpectedSize(Size expectedSpectra, Size expectedChromatograms)))
+  NOT_TESTABLE // passed on to the next consumer
+END_SECTION
+
+START_SECTION((virtual void setExperimentalSettings(const ExperimentalSettings & exp)))
+  NOT_TESTABLE // passed on to the next consumer
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
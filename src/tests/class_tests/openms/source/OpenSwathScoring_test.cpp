@@ -213,6 +213,35 @@ START_SECTION((OpenSwath::SpectrumPtr getAddedSpectra_(OpenSwath::SpectrumAccess
 
     TEST_REAL_SIMILAR(sp->getMZArray()->data[0], 20.0);
     TEST_REAL_SIMILAR(sp->getIntensityArray()->data[0], 400.0);
+
+    // repeated requests for the same spectra are served from the cache
+    OpenSwath::SpectrumPtr sp_cached = sc.getAddedSpectra_(swath_ptr, 19.0, 3);
+    TEST_EQUAL(sp_cached == sp, true)
+    OpenSwath::SpectrumPtr sp_single = sc.getAddedSpectra_(swath_ptr, 20.0, 1);
+    TEST_EQUAL(sp_single == sp, false)
+    TEST_REAL_SIMILAR(sp_single->getIntensityArray()->data[0], 200.0);
+
+    // initialize() with the same settings for adding up spectra keeps the cache ...
+    OpenSwath_Scores_Usage su;
+    sc.initialize(2.0, 1, 0.005, su);
+    TEST_EQUAL(sc.getAddedSpectra_(swath_ptr, 20.0, 3) == sp, true)
+
+    // ... while changing how spectra are added clears it
+    sc.initialize(1.0, 3, 0.005, su);
+    OpenSwath::SpectrumPtr sp_initialized = sc.getAddedSpectra_(swath_ptr, 20.0, 3);
+    TEST_EQUAL(sp_initialized == sp, false)
+    TEST_REAL_SIMILAR(sp_initialized->getIntensityArray()->data[0], 400.0);
+
+    // spectra of a different map are never returned from the cache
+    OpenSwath::SpectrumAccessPtr other_swath_ptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(swath_map);
+    OpenSwath::SpectrumPtr sp_other = sc.getAddedSpectra_(other_swath_ptr, 20.0, 3);
+    TEST_EQUAL(sp_other == sp_initialized, false)
+    TEST_REAL_SIMILAR(sp_other->getIntensityArray()->data[0], 400.0);
+
+    // the cache does not keep the map alive
+    boost::weak_ptr<OpenSwath::ISpectrumAccess> weak_swath_ptr(other_swath_ptr);
+    other_swath_ptr.reset();
+    TEST_EQUAL(weak_swath_ptr.expired(), true)
   }
 }
 END_SECTION
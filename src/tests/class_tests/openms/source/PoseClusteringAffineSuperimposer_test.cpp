@@ -183,6 +183,41 @@ START_SECTION((virtual void run(const std::vector<Peak2D> & map_model, const std
 }
 END_SECTION
 
+START_SECTION(([EXTRA] run with sampled anchor points))
+{
+  std::vector<Peak2D> map_model, map_scene;
+
+  for (Size i = 0; i < 10; i++)
+  {
+    Peak2D p;
+    p.setRT(1.0 + 10.0 * i);
+    p.setMZ(100.0 + 10.0 * i);
+    p.setIntensity(100.0f);
+    map_model.push_back(p);
+    p.setRT(1.4 + 10.0 * i);
+    p.setMZ(100.02 + 10.0 * i);
+    map_scene.push_back(p);
+  }
+
+  Param parameters;
+  parameters.setValue(String("scaling_bucket_size"), 0.01);
+  parameters.setValue(String("shift_bucket_size"), 0.1);
+  parameters.setValue(String("anchor_point_stride"), 3);
+
+  TransformationDescription transformation;
+  PoseClusteringAffineSuperimposer pcat;
+  pcat.setParameters(parameters);
+
+  pcat.run(map_model, map_scene, transformation);
+
+  TEST_STRING_EQUAL(transformation.getModelType(), "linear")
+  parameters = transformation.getModelParameters();
+  TEST_EQUAL(parameters.size(), 2)
+  TEST_REAL_SIMILAR(parameters.getValue("slope"), 1.0)
+  TEST_REAL_SIMILAR(parameters.getValue("intercept"), -0.4)
+}
+END_SECTION
+
 START_SECTION(([EXTRA]virtual void run(const std::vector<Peak2D> & map_model, const std::vector<Peak2D> & map_scene, TransformationDescription& transformation)))
 {
   std::vector<Peak2D> map_model, map_scene;
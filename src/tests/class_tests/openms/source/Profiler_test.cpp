@@ -0,0 +1,287 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/SYSTEM/Profiler.h>
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/FORMAT/TextFile.h>
+
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(Profiler, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+START_SECTION((static void setEnabled(bool enabled)))
+{
+  TEST_EQUAL(Profiler::isEnabled(), false)
+  Profiler::setEnabled(true);
+  TEST_EQUAL(Profiler::isEnabled(), true)
+  Profiler::setEnabled(false);
+  TEST_EQUAL(Profiler::isEnabled(), false)
+}
+END_SECTION
+
+START_SECTION((static bool isEnabled()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((static void startPhase(const String& name)))
+{
+  // disabled: nothing is recorded
+  Profiler::startPhase("phase");
+  Profiler::endPhase();
+  TEST_EQUAL(Profiler::getPhases().size(), 0)
+
+  Profiler::setEnabled(true);
+  Profiler::startPhase("outer");
+  Profiler::startPhase("inner");
+  Profiler::endPhase();
+  Profiler::startPhase("inner");
+  Profiler::endPhase();
+  TEST_EQUAL(Profiler::getPhases().size(), 1)
+  Profiler::endPhase();
+  // unmatched end is ignored
+  Profiler::endPhase();
+  Profiler::setEnabled(false);
+
+  std::map<String, Profiler::PhaseStatistics> phases = Profiler::getPhases();
+  TEST_EQUAL(phases.size(), 2)
+  TEST_EQUAL(phases["outer"].calls, 1)
+  TEST_EQUAL(phases["inner"].calls, 2)
+  TEST_EQUAL(phases["outer"].wall_time >= phases["inner"].wall_time, true)
+  Profiler::clear();
+}
+END_SECTION
+
+START_SECTION((static void endPhase()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((static void addCount(const String& name, UInt64 count = 1)))
+{
+  Profiler::addCount("spectra", 5);
+  TEST_EQUAL(Profiler::getCounters().size(), 0)
+
+  Profiler::setEnabled(true);
+  Profiler::addCount("spectra", 5);
+  Profiler::addCount("spectra");
+  Profiler::addCount("peaks", 100);
+  Profiler::setEnabled(false);
+
+  std::map<String, UInt64> counters = Profiler::getCounters();
+  TEST_EQUAL(counters.size(), 2)
+  TEST_EQUAL(counters["spectra"], 6)
+  TEST_EQUAL(counters["peaks"], 100)
+}
+END_SECTION
+
+START_SECTION((static std::map<String, PhaseStatistics> getPhases()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((static std::map<String, UInt64> getCounters()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((static void clear()))
+{
+  TEST_EQUAL(Profiler::getCounters().size(), 2)
+  Profiler::clear();
+  TEST_EQUAL(Profiler::getCounters().size(), 0)
+  TEST_EQUAL(Profiler::getPhases().size(), 0)
+}
+END_SECTION
+
+START_SECTION((ScopedPhase(const String& name)))
+{
+  Profiler::setEnabled(true);
+  {
+    Profiler::ScopedPhase phase("scoped");
+  }
+  // progress sections are recorded as phases
+  ProgressLogger logger;
+  logger.startProgress(0, 10, "progress");
+  logger.endProgress();
+  Profiler::setEnabled(false);
+
+  std::map<String, Profiler::PhaseStatistics> phases = Profiler::getPhases();
+  TEST_EQUAL(phases.size(), 2)
+  TEST_EQUAL(phases["scoped"].calls, 1)
+  TEST_EQUAL(phases["progress"].calls, 1)
+  Profiler::clear();
+}
+END_SECTION
+
+START_SECTION((~ScopedPhase()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(([EXTRA] phases within parallel regions))
+{
+  Profiler::setEnabled(true);
+  Profiler::startPhase("outer");
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < 8; ++i)
+  {
+    // progress sections of worker threads are not recorded ...
+    ProgressLogger logger;
+    logger.startProgress(0, 10, "worker");
+    logger.endProgress();
+    // ... but counters are
+    Profiler::addCount("iterations");
+  }
+  Profiler::endPhase();
+  Profiler::setEnabled(false);
+
+  std::map<String, Profiler::PhaseStatistics> phases = Profiler::getPhases();
+#ifdef _OPENMP
+  TEST_EQUAL(phases.size(), 1)
+  TEST_EQUAL(phases.count("worker"), 0)
+#endif
+  TEST_EQUAL(phases["outer"].calls, 1)
+  TEST_EQUAL(Profiler::getCounters()["iterations"], 8)
+  Profiler::clear();
+}
+END_SECTION
+
+START_SECTION((ScopedReport(const String& filename, const String& tool_name, Int threads)))
+{
+  // no file name: profiling stays disabled and no report is written
+  {
+    Profiler::ScopedReport report("", "TestTool", 1);
+    TEST_EQUAL(Profiler::isEnabled(), false)
+  }
+
+  String filename;
+  NEW_TMP_FILE(filename)
+  {
+    Profiler::ScopedReport report(filename, "TestTool", 1);
+    TEST_EQUAL(Profiler::isEnabled(), true)
+    Profiler::ScopedPhase phase("finished");
+    report.setExitCode(0);
+  }
+  TEST_EQUAL(Profiler::isEnabled(), false)
+  TextFile finished_report(filename);
+  String content;
+  content.concatenate(finished_report.begin(), finished_report.end());
+  TEST_EQUAL(content.hasSubstring("\"exit_code\": 0"), true)
+  TEST_EQUAL(content.hasSubstring("{\"name\": \"finished\", \"calls\": 1"), true)
+
+  // the report is written when the scope is left by an exception
+  NEW_TMP_FILE(filename)
+  try
+  {
+    Profiler::ScopedReport report(filename, "TestTool", 1);
+    Profiler::ScopedPhase phase("aborted");
+    throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "abort", "");
+  }
+  catch (Exception::InvalidValue&)
+  {
+  }
+  TEST_EQUAL(Profiler::isEnabled(), false)
+  TextFile aborted_report(filename);
+  content.clear();
+  content.concatenate(aborted_report.begin(), aborted_report.end());
+  TEST_EQUAL(content.hasSubstring("\"exit_code\": null"), true)
+  TEST_EQUAL(content.hasSubstring("{\"name\": \"aborted\", \"calls\": 1"), true)
+  Profiler::clear();
+}
+END_SECTION
+
+START_SECTION((~ScopedReport()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void setExitCode(Int exit_code)))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((static void writeReport(const String& filename, const String& tool_name, Int exit_code, const StopWatch& total_time, Int threads)))
+{
+  Profiler::setEnabled(true);
+  Profiler::startPhase("loading \"data\"");
+  Profiler::endPhase();
+  Profiler::addCount("spectra", 3);
+  Profiler::setEnabled(false);
+
+  StopWatch sw;
+  sw.start();
+  sw.stop();
+
+  String filename;
+  NEW_TMP_FILE(filename)
+  Profiler::writeReport(filename, "TestTool", 0, sw, 2);
+  TextFile report(filename);
+  String content;
+  content.concatenate(report.begin(), report.end());
+  TEST_EQUAL(content.hasSubstring("\"tool\": \"TestTool\""), true)
+  TEST_EQUAL(content.hasSubstring("\"exit_code\": 0"), true)
+  TEST_EQUAL(content.hasSubstring("\"threads\": 2"), true)
+  TEST_EQUAL(content.hasSubstring("\"peak_memory_kb\""), true)
+  TEST_EQUAL(content.hasSubstring("{\"name\": \"loading \\\"data\\\"\", \"calls\": 1"), true)
+  TEST_EQUAL(content.hasSubstring("\"spectra\": 3"), true)
+  Profiler::clear();
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, Profiler::writeReport("/does/not/exist/report.json", "TestTool", 0, sw, 1))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -1056,6 +1056,93 @@ START_SECTION((void getSVCProbabilities(struct svm_problem *problem, std::vector
 	}
 
 END_SECTION
+
+START_SECTION((void setCrossValidationMemoryLimit(Size bytes)))
+  SVMWrapper svm3;
+  svm3.setCrossValidationMemoryLimit(12345);
+  TEST_EQUAL(svm3.getCrossValidationMemoryLimit(), 12345)
+END_SECTION
+
+START_SECTION((Size getCrossValidationMemoryLimit() const))
+  SVMWrapper svm3;
+  TEST_EQUAL(svm3.getCrossValidationMemoryLimit(), Size(1) << 30)
+END_SECTION
+
+START_SECTION([EXTRA] cross validation with the kernel cache and parallel folds gives the same results as the uncached serial path)
+{
+  // labeled oligo data from a few peptides with distinct retention labels
+  String peptides[] = {"ACNNGTATCA", "AACNNGTACCA", "GGTACA", "CANTGGA", "TTACGNA", "NNACGTA",
+                       "ACACACGT", "GTGTAC", "CCATNGA", "AGCTAGCT", "TNACGGA", "GATTACA"};
+  Size count = sizeof(peptides) / sizeof(peptides[0]);
+  String allowed_characters = "ACNGT";
+  Int border_length = 5;
+  vector<AASequence> sequences;
+  vector<double> labels;
+  for (Size i = 0; i < count; ++i)
+  {
+    sequences.push_back(AASequence::fromString(peptides[i]));
+    labels.push_back(i * 0.7 + (i % 3) * 0.2);
+  }
+  LibSVMEncoder encoder;
+  vector<vector<pair<Int, double> > > data;
+  encoder.encodeProblemWithOligoBorderVectors(sequences, 1, allowed_characters, border_length, data);
+  SVMData problem;
+  problem.sequences = data;
+  problem.labels = labels;
+
+  map<SVMWrapper::SVM_parameter_type, double> start_values;
+  map<SVMWrapper::SVM_parameter_type, double> step_sizes;
+  map<SVMWrapper::SVM_parameter_type, double> end_values;
+  start_values.insert(make_pair(SVMWrapper::C, 1));
+  step_sizes.insert(make_pair(SVMWrapper::C, 100));
+  end_values.insert(make_pair(SVMWrapper::C, 201));
+  start_values.insert(make_pair(SVMWrapper::NU, 0.4));
+  step_sizes.insert(make_pair(SVMWrapper::NU, 0.1));
+  end_values.insert(make_pair(SVMWrapper::NU, 0.6));
+  start_values.insert(make_pair(SVMWrapper::SIGMA, 1));
+  step_sizes.insert(make_pair(SVMWrapper::SIGMA, 2));
+  end_values.insert(make_pair(SVMWrapper::SIGMA, 3));
+
+  // memory limit 0: no kernel cache, the folds compute their own matrices one at a time (the previous implementation)
+  double cv_quality[2];
+  map<SVMWrapper::SVM_parameter_type, double> best_parameters[2];
+  Size memory_limits[] = {Size(1) << 30, 0};
+  for (Size m = 0; m < 2; ++m)
+  {
+    SVMWrapper svm3;
+    svm3.setParameter(SVMWrapper::KERNEL_TYPE, SVMWrapper::OLIGO);
+    svm3.setParameter(SVMWrapper::BORDER_LENGTH, border_length);
+    svm3.setParameter(SVMWrapper::SIGMA, 1);
+    svm3.setParameter(SVMWrapper::SVM_TYPE, NU_SVR);
+    svm3.setCrossValidationMemoryLimit(memory_limits[m]);
+    srand(42); // same random partitions in both runs
+    cv_quality[m] = svm3.performCrossValidation(0, problem, true, start_values, step_sizes, end_values, 3, 2, best_parameters[m], true, false);
+  }
+  TEST_EQUAL(cv_quality[0] == cv_quality[1] || (cv_quality[0] != cv_quality[0] && cv_quality[1] != cv_quality[1]), true)
+  TEST_EQUAL(best_parameters[0] == best_parameters[1], true)
+
+  // the (parallel) kernel matrix agrees with the oligo kernel of each pair
+  SVMWrapper svm3;
+  double sigma = 2;
+  svm3.setParameter(SVMWrapper::KERNEL_TYPE, SVMWrapper::OLIGO);
+  svm3.setParameter(SVMWrapper::BORDER_LENGTH, border_length);
+  svm3.setParameter(SVMWrapper::SIGMA, sigma);
+  vector<double> gauss_table;
+  SVMWrapper::calculateGaussTable(border_length, sigma, gauss_table);
+  svm_problem* kernel_matrix = svm3.computeKernelMatrix(problem, problem);
+  TEST_EQUAL(kernel_matrix->l, (Int) count)
+  for (Size i = 0; i < count; ++i)
+  {
+    for (Size j = 0; j < count; ++j)
+    {
+      // the upper triangle is computed and mirrored
+      double expected = SVMWrapper::kernelOligo(data[std::min(i, j)], data[std::max(i, j)], gauss_table);
+      TEST_REAL_SIMILAR(kernel_matrix->x[i][j + 1].value, expected)
+    }
+  }
+  LibSVMEncoder::destroyProblem(kernel_matrix);
+}
+END_SECTION
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 
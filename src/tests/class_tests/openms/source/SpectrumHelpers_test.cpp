@@ -120,6 +120,54 @@ START_SECTION ( [EXTRA] testscorefunction)
 }
 END_SECTION
 
+START_SECTION ( [EXTRA] integrateWindows with window boundaries)
+{
+  OpenSwath::SpectrumPtr sptr = (OpenSwath::SpectrumPtr)(new OpenSwath::Spectrum);
+  OpenSwath::BinaryDataArrayPtr data1(new OpenSwath::BinaryDataArray);
+  OpenSwath::BinaryDataArrayPtr data2(new OpenSwath::BinaryDataArray);
+
+  static const double arr1[] = {
+    10, 20, 50, 100, 50, 20, 10, // peak at 499
+    3, 7, 15, 30, 15, 7, 3,      // peak at 500
+    1, 3, 9, 15, 9, 3, 1,        // peak at 501
+    3, 9, 3                      // peak at 502
+  };
+  static const double arr2[] = {
+    498.97, 498.98, 498.99, 499.0, 499.01, 499.02, 499.03,
+    499.97, 499.98, 499.99, 500.0, 500.01, 500.02, 500.03,
+    500.97, 500.98, 500.99, 501.0, 501.01, 501.02, 501.03,
+    501.99, 502.0, 502.01
+  };
+  data1->data = std::vector<double>(arr2, arr2 + sizeof(arr2) / sizeof(arr2[0]));
+  data2->data = std::vector<double>(arr1, arr1 + sizeof(arr1) / sizeof(arr1[0]));
+  sptr->setMZArray(data1);
+  sptr->setIntensityArray(data2);
+
+  // unsorted and overlapping windows, one of them without signal
+  std::vector<double> left, right, intresv, mzresv;
+  left.push_back(499.6);  right.push_back(501.4);
+  left.push_back(499.);   right.push_back(501.);
+  left.push_back(300.);   right.push_back(301.);
+  left.push_back(501.5);  right.push_back(502.5);
+  OpenSwath::integrateWindows(sptr, left, right, intresv, mzresv);
+
+  TEST_EQUAL(intresv.size(), 4)
+  TEST_EQUAL(mzresv.size(), 4)
+  for (Size i = 0; i < left.size(); ++i)
+  {
+    double mzres, intensityres;
+    OpenSwath::integrateWindow(sptr, left[i], right[i], mzres, intensityres);
+    TEST_EQUAL(intresv[i], intensityres)
+    TEST_EQUAL(mzresv[i], mzres)
+  }
+  TEST_REAL_SIMILAR(mzresv[0], 500.338842975207);
+  TEST_REAL_SIMILAR(intresv[0], 121);
+  TEST_REAL_SIMILAR(mzresv[2], -1);
+  TEST_REAL_SIMILAR(intresv[2], 0);
+  TEST_REAL_SIMILAR(intresv[3], 15);
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
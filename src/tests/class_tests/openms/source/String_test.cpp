@@ -38,9 +38,13 @@
 ///////////////////////////
 
 #include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/CONCEPT/PrecisionWrapper.h>
 #include <OpenMS/DATASTRUCTURES/DataValue.h>
+#include <cstdio>
 #include <iostream>
 #include <iomanip>
+#include <limits>
+#include <sstream>
 #include <vector>
 
 #include <QtCore/QString>
@@ -167,6 +171,66 @@ START_SECTION((String(long double ld)))
 	TEST_EQUAL(s,"17.012345")
 END_SECTION
 
+START_SECTION(([EXTRA] String(double d) and String(float f) give the same result as streaming with writtenDigits() precision))
+{
+  // zero, rounding boundaries, switches to scientific notation and values that need printf
+  double values[] = {0.0, -0.0, 1.0, -2.5, 0.1, 7.4, 1234.56789012345678, 445.1200012345678, 1e-4, 9.99999999999999e-5,
+                     0.000123456789012345, 999999999999999.4, 999999999999999.6, 1e15, 123456789012345678.0, 1e100, -3.5e-200,
+                     5e-324, 1.7976931348623157e308, 0.1234567890123455, 999999.5, 1.0 / 3.0, std::numeric_limits<double>::infinity()};
+  for (Size i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+  {
+    stringstream ss;
+    ss.precision(writtenDigits<double>());
+    ss << values[i];
+    TEST_STRING_EQUAL(String(values[i]), ss.str())
+
+    if (fabs(values[i]) < 1e38) // larger values are out of float range
+    {
+      stringstream ss_float;
+      ss_float.precision(writtenDigits<float>());
+      ss_float << float(values[i]);
+      TEST_STRING_EQUAL(String(float(values[i])), ss_float.str())
+    }
+  }
+}
+END_SECTION
+
+START_SECTION(([EXTRA] formatFloatingPoint() limits the precision to the buffer size))
+{
+  char buffer[64];
+  Size length = formatFloatingPoint(buffer, 1.0 / 3.0, 1000);
+  TEST_EQUAL(length <= 50, true)
+  char expected[64];
+  sprintf(expected, "%.40g", 1.0 / 3.0);
+  TEST_STRING_EQUAL(std::string(buffer, length), expected)
+
+  length = formatFloatingPoint(buffer, -std::numeric_limits<long double>::min(), 1000);
+  TEST_EQUAL(length <= 50, true)
+  sprintf(expected, "%.40Lg", -std::numeric_limits<long double>::min());
+  TEST_STRING_EQUAL(std::string(buffer, length), expected)
+}
+END_SECTION
+
+START_SECTION(([EXTRA] String(double d) gives the same result as a stringstream))
+{
+  // typical values of a featureXML file: m/z, RT and intensities
+  // (the speed is measured by the FileWriter benchmark)
+  Size differences = 0;
+  for (Size i = 0; i < 20000; ++i)
+  {
+    double values[] = {100.0 + i * 0.0123456789, i * 0.37, 1e3 + i * 12345.678};
+    for (Size j = 0; j < 3; ++j)
+    {
+      stringstream ss;
+      ss.precision(writtenDigits<double>());
+      ss << values[j];
+      if (String(values[j]) != ss.str()) ++differences;
+    }
+  }
+  TEST_EQUAL(differences, 0)
+}
+END_SECTION
+
 START_SECTION((String(long long unsigned int i)))
 	String s((long long unsigned int)(12345678));
 	TEST_EQUAL(s,"12345678")
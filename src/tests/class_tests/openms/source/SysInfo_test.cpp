@@ -72,4 +72,29 @@ START_SECTION(static bool getProcessMemoryConsumption(size_t& mem_virtual))
 }
 END_SECTION
 
+START_SECTION(static bool getProcessPeakMemoryConsumption(size_t& mem_peak))
+{
+  size_t peak;
+  TEST_EQUAL(SysInfo::getProcessPeakMemoryConsumption(peak), true);
+  std::cout << "Peak memory: " << peak << " KB" << std::endl;
+  // includes the mzML file loaded above, although it was released again
+  TEST_EQUAL(peak > 10000, true)
+}
+END_SECTION
+
+START_SECTION(static bool getProcessIOStatistics(UInt64& bytes_read, UInt64& bytes_written))
+{
+  UInt64 bytes_read, bytes_written;
+#ifndef __APPLE__
+  TEST_EQUAL(SysInfo::getProcessIOStatistics(bytes_read, bytes_written), true);
+  std::cout << "Bytes read: " << bytes_read << ", bytes written: " << bytes_written << std::endl;
+  // at least the 20 MB mzML file loaded above
+  TEST_EQUAL(bytes_read > 10000000, true)
+#else
+  TEST_EQUAL(SysInfo::getProcessIOStatistics(bytes_read, bytes_written), false);
+  TEST_EQUAL(bytes_read, 0)
+#endif
+}
+END_SECTION
+
 END_TEST
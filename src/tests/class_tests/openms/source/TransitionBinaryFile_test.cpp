@@ -0,0 +1,251 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinaryFile.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/CachedMzML.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+using namespace OpenMS;
+
+START_TEST(TransitionBinaryFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+TransitionBinaryFile* ptr = 0;
+TransitionBinaryFile* nullPointer = 0;
+
+START_SECTION(TransitionBinaryFile())
+  ptr = new TransitionBinaryFile;
+  TEST_NOT_EQUAL(ptr, nullPointer)
+END_SECTION
+
+START_SECTION(virtual ~TransitionBinaryFile())
+  delete ptr;
+END_SECTION
+
+OpenSwath::LightTargetedExperiment exp;
+{
+  OpenSwath::LightProtein protein;
+  protein.id = "PROT_1";
+  protein.sequence = "PEPTIDEKPEPTIDER";
+  exp.proteins.push_back(protein);
+
+  OpenSwath::LightCompound compound;
+  compound.id = "PEPTIDEK_2";
+  compound.sequence = "PEPTIDEK";
+  compound.peptide_group_label = "group_1";
+  compound.rt = 44.5;
+  compound.charge = 2;
+  compound.protein_refs.push_back("PROT_1");
+  compound.protein_refs.push_back("PROT_2");
+  OpenSwath::LightModification modification;
+  modification.location = 3;
+  modification.unimod_id = "UniMod:21";
+  compound.modifications.push_back(modification);
+  exp.compounds.push_back(compound);
+
+  compound.id = "PEPTIDER_3";
+  compound.sequence = "PEPTIDER";
+  compound.rt = 12.0;
+  compound.charge = 3;
+  compound.protein_refs.clear();
+  compound.modifications.clear();
+  exp.compounds.push_back(compound);
+
+  OpenSwath::LightTransition transition;
+  transition.transition_name = "tr_1";
+  transition.peptide_ref = "PEPTIDER_3";
+  transition.library_intensity = 1000.0;
+  transition.product_mz = 500.25;
+  transition.precursor_mz = 400.125;
+  transition.fragment_charge = 1;
+  transition.decoy = true;
+  transition.detecting_transition = true;
+  transition.quantifying_transition = false;
+  transition.identifying_transition = true;
+  exp.transitions.push_back(transition);
+
+  // reference to a compound which is not part of the library
+  transition.transition_name = "tr_2";
+  transition.peptide_ref = "UNKNOWN";
+  transition.decoy = false;
+  transition.detecting_transition = false;
+  transition.quantifying_transition = true;
+  transition.identifying_transition = false;
+  exp.transitions.push_back(transition);
+}
+
+START_SECTION(void store(const String & filename, const OpenSwath::LightTargetedExperiment & exp))
+{
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  TransitionBinaryFile().store(tmp_filename, exp);
+  TEST_EQUAL(TransitionBinaryFile::isBinaryLibrary(tmp_filename), true)
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, TransitionBinaryFile().store("/does/not/exist/library.oslib", exp))
+}
+END_SECTION
+
+START_SECTION(void load(const String & filename, OpenSwath::LightTargetedExperiment & exp))
+{
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  TransitionBinaryFile().store(tmp_filename, exp);
+
+  OpenSwath::LightTargetedExperiment loaded;
+  TransitionBinaryFile().load(tmp_filename, loaded);
+
+  TEST_EQUAL(loaded.proteins.size(), 1)
+  TEST_EQUAL(loaded.proteins[0].id, "PROT_1")
+  TEST_EQUAL(loaded.proteins[0].sequence, "PEPTIDEKPEPTIDER")
+
+  TEST_EQUAL(loaded.compounds.size(), 2)
+  TEST_EQUAL(loaded.compounds[0].id, "PEPTIDEK_2")
+  TEST_EQUAL(loaded.compounds[0].sequence, "PEPTIDEK")
+  TEST_EQUAL(loaded.compounds[0].peptide_group_label, "group_1")
+  TEST_REAL_SIMILAR(loaded.compounds[0].rt, 44.5)
+  TEST_EQUAL(loaded.compounds[0].charge, 2)
+  TEST_EQUAL(loaded.compounds[0].protein_refs.size(), 2)
+  TEST_EQUAL(loaded.compounds[0].protein_refs[1], "PROT_2")
+  TEST_EQUAL(loaded.compounds[0].modifications.size(), 1)
+  TEST_EQUAL(loaded.compounds[0].modifications[0].location, 3)
+  TEST_EQUAL(loaded.compounds[0].modifications[0].unimod_id, "UniMod:21")
+  TEST_EQUAL(loaded.compounds[1].id, "PEPTIDER_3")
+  TEST_EQUAL(loaded.compounds[1].charge, 3)
+  TEST_EQUAL(loaded.compounds[1].protein_refs.size(), 0)
+  TEST_EQUAL(loaded.compounds[1].modifications.size(), 0)
+
+  TEST_EQUAL(loaded.transitions.size(), 2)
+  TEST_EQUAL(loaded.transitions[0].transition_name, "tr_1")
+  TEST_EQUAL(loaded.transitions[0].peptide_ref, "PEPTIDER_3")
+  TEST_REAL_SIMILAR(loaded.transitions[0].library_intensity, 1000.0)
+  TEST_REAL_SIMILAR(loaded.transitions[0].product_mz, 500.25)
+  TEST_REAL_SIMILAR(loaded.transitions[0].precursor_mz, 400.125)
+  TEST_EQUAL(loaded.transitions[0].fragment_charge, 1)
+  TEST_EQUAL(loaded.transitions[0].decoy, true)
+  TEST_EQUAL(loaded.transitions[0].detecting_transition, true)
+  TEST_EQUAL(loaded.transitions[0].quantifying_transition, false)
+  TEST_EQUAL(loaded.transitions[0].identifying_transition, true)
+  TEST_EQUAL(loaded.transitions[1].peptide_ref, "UNKNOWN")
+  TEST_EQUAL(loaded.transitions[1].decoy, false)
+  TEST_EQUAL(loaded.transitions[1].quantifying_transition, true)
+
+  // the compound lookup works on the loaded library
+  TEST_EQUAL(loaded.getCompoundByRef("PEPTIDER_3").sequence, "PEPTIDER")
+
+  TEST_EXCEPTION(Exception::FileNotFound, TransitionBinaryFile().load("/does/not/exist/library.oslib", loaded))
+  TEST_EXCEPTION(Exception::ParseError, TransitionBinaryFile().load(OPENMS_GET_TEST_DATA_PATH("SwathWindowFile.txt"), loaded))
+}
+END_SECTION
+
+START_SECTION(static bool isBinaryLibrary(const String & filename))
+{
+  TEST_EQUAL(TransitionBinaryFile::isBinaryLibrary(OPENMS_GET_TEST_DATA_PATH("SwathWindowFile.txt")), false)
+  TEST_EQUAL(TransitionBinaryFile::isBinaryLibrary("/does/not/exist/library.oslib"), false)
+
+  // cached mzML files are binary as well, but must not be taken for an assay library
+  MSExperiment<> exp;
+  MSSpectrum<> spectrum;
+  Peak1D peak;
+  peak.setMZ(500.0);
+  peak.setIntensity(100.0);
+  spectrum.push_back(peak);
+  exp.addSpectrum(spectrum);
+  String cached_filename;
+  NEW_TMP_FILE(cached_filename);
+  CachedmzML().writeMemdump(exp, cached_filename);
+  TEST_EQUAL(TransitionBinaryFile::isBinaryLibrary(cached_filename), false)
+  OpenSwath::LightTargetedExperiment loaded;
+  TEST_EXCEPTION(Exception::ParseError, TransitionBinaryFile().load(cached_filename, loaded))
+}
+END_SECTION
+
+START_SECTION(([EXTRA] load corrupt files))
+{
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  TransitionBinaryFile().store(tmp_filename, exp);
+  std::string content;
+  {
+    std::ifstream ifs(tmp_filename.c_str(), std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+  }
+
+  // header: identifier (8 bytes), byte order (4), version (4), number of proteins, compounds, transitions (8 each),
+  // followed by the number of entries of the first column (8)
+  const Size count_positions[] = {16, 24, 32, 40};
+  const UInt64 counts[] = {std::numeric_limits<UInt64>::max(), std::numeric_limits<UInt64>::max() / 2, 1000000};
+  for (Size p = 0; p < 4; ++p)
+  {
+    for (Size c = 0; c < 3; ++c)
+    {
+      std::string corrupt = content;
+      std::memcpy(&corrupt[count_positions[p]], &counts[c], sizeof(UInt64));
+      String corrupt_filename;
+      NEW_TMP_FILE(corrupt_filename);
+      {
+        std::ofstream ofs(corrupt_filename.c_str(), std::ios::binary);
+        ofs.write(corrupt.data(), corrupt.size());
+      }
+      OpenSwath::LightTargetedExperiment loaded;
+      TEST_EXCEPTION(Exception::ParseError, TransitionBinaryFile().load(corrupt_filename, loaded))
+    }
+  }
+
+  // truncated file
+  String truncated_filename;
+  NEW_TMP_FILE(truncated_filename);
+  {
+    std::ofstream ofs(truncated_filename.c_str(), std::ios::binary);
+    ofs.write(content.data(), content.size() / 2);
+  }
+  OpenSwath::LightTargetedExperiment loaded;
+  TEST_EXCEPTION(Exception::ParseError, TransitionBinaryFile().load(truncated_filename, loaded))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,204 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+
+///////////////////////////
+
+#include <OpenMS/VISUAL/MaxIntensityPyramid.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(MaxIntensityPyramid, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// 4 MS1 spectra (RT 0-3) with peaks at m/z 100-400 and intensity 10 * RT + peak index,
+// plus one intense MS2 spectrum that has to be ignored
+MSExperiment<> exp;
+for (Size i = 0; i < 4; ++i)
+{
+  MSSpectrum<> spec;
+  spec.setRT(i);
+  spec.setMSLevel(1);
+  for (Size j = 0; j < 4; ++j)
+  {
+    Peak1D p;
+    p.setMZ(100.0 * (j + 1));
+    p.setIntensity(10.0 * i + j);
+    spec.push_back(p);
+  }
+  exp.addSpectrum(spec);
+  if (i == 1)
+  {
+    MSSpectrum<> ms2;
+    ms2.setRT(1.5);
+    ms2.setMSLevel(2);
+    Peak1D p;
+    p.setMZ(250.0);
+    p.setIntensity(1000.0);
+    ms2.push_back(p);
+    exp.addSpectrum(ms2);
+  }
+}
+exp.updateRanges();
+
+MaxIntensityPyramid* ptr = 0;
+MaxIntensityPyramid* null_ptr = 0;
+START_SECTION((MaxIntensityPyramid()))
+  ptr = new MaxIntensityPyramid();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->getNumberOfLevels(), 0)
+END_SECTION
+
+START_SECTION((~MaxIntensityPyramid()))
+  delete ptr;
+END_SECTION
+
+START_SECTION((void build(const MSExperiment<> & map, Size rt_bins = 2048, Size mz_bins = 2048)))
+  MaxIntensityPyramid pyramid;
+  pyramid.build(exp, 4, 4);
+  TEST_EQUAL(pyramid.empty(), false)
+  // 4x4, 2x2, 1x1
+  TEST_EQUAL(pyramid.getNumberOfLevels(), 3)
+
+  // the RT resolution is limited by the number of MS1 spectra
+  pyramid.build(exp, 100, 4);
+  TEST_EQUAL(pyramid.getNumberOfLevels(), 3)
+
+  // no MS1 data
+  pyramid.build(MSExperiment<>());
+  TEST_EQUAL(pyramid.empty(), true)
+END_SECTION
+
+START_SECTION((void clear()))
+  MaxIntensityPyramid pyramid;
+  pyramid.build(exp, 4, 4);
+  pyramid.clear();
+  TEST_EQUAL(pyramid.empty(), true)
+  TEST_EQUAL(pyramid.isBuiltFrom(exp), false)
+END_SECTION
+
+START_SECTION((bool empty() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((Size getNumberOfLevels() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((bool isBuiltFrom(const MSExperiment<> & map) const))
+  MaxIntensityPyramid pyramid;
+  TEST_EQUAL(pyramid.isBuiltFrom(exp), false)
+  pyramid.build(exp, 4, 4);
+  TEST_EQUAL(pyramid.isBuiltFrom(exp), true)
+  MSExperiment<> copy = exp;
+  TEST_EQUAL(pyramid.isBuiltFrom(copy), false)
+  copy.clear(true);
+  pyramid.build(copy);
+  copy.addSpectrum(exp[0]);
+  copy.updateRanges();
+  TEST_EQUAL(pyramid.isBuiltFrom(copy), false)
+END_SECTION
+
+START_SECTION((bool render(double rt_min, double rt_max, double mz_min, double mz_max, Size rt_pixel_count, Size mz_pixel_count, std::vector<float> & max_intensities) const))
+  MaxIntensityPyramid pyramid;
+  vector<float> max_intensities;
+  TEST_EQUAL(pyramid.render(0.0, 4.0, 100.0, 500.0, 1, 1, max_intensities), false)
+
+  pyramid.build(exp, 4, 4);
+  TEST_EQUAL(pyramid.render(0.0, 4.0, 100.0, 500.0, 1, 1, max_intensities), true)
+  TEST_EQUAL(max_intensities.size(), 1)
+  TEST_REAL_SIMILAR(max_intensities[0], 33.0)
+
+  // RT x m/z raster: every pixel contains at least the maximum of its own peaks
+  TEST_EQUAL(pyramid.render(0.0, 4.0, 100.0, 500.0, 2, 2, max_intensities), true)
+  TEST_EQUAL(max_intensities.size(), 4)
+  TEST_EQUAL(max_intensities[0] >= 11.0, true)
+  TEST_EQUAL(max_intensities[1] >= 13.0, true)
+  TEST_EQUAL(max_intensities[2] >= 31.0, true)
+  TEST_REAL_SIMILAR(max_intensities[3], 33.0)
+
+  // area without data
+  TEST_EQUAL(pyramid.render(0.0, 4.0, 1000.0, 1400.0, 2, 2, max_intensities), true)
+  TEST_REAL_SIMILAR(max_intensities[0], -1.0)
+  TEST_REAL_SIMILAR(max_intensities[3], -1.0)
+
+  // zoomed in beyond the base resolution: use the raw data
+  max_intensities.clear();
+  TEST_EQUAL(pyramid.render(0.0, 4.0, 100.0, 500.0, 100, 100, max_intensities), false)
+  TEST_EQUAL(max_intensities.size(), 0)
+END_SECTION
+
+START_SECTION(([EXTRA] render uses the pyramid only while zoomed out))
+{
+  // synthetic map: 2000 MS1 spectra with 2000 peaks each
+  MSExperiment<> large;
+  for (Size i = 0; i < 2000; ++i)
+  {
+    MSSpectrum<> spec;
+    spec.setRT(i * 1.5);
+    spec.setMSLevel(1);
+    spec.resize(2000);
+    for (Size j = 0; j < spec.size(); ++j)
+    {
+      spec[j].setMZ(300.0 + j * 0.6 + (i % 7) * 0.01);
+      spec[j].setIntensity(float((i * 31 + j * 17) % 1000));
+    }
+    large.addSpectrum(spec);
+  }
+  large.updateRanges();
+
+  MaxIntensityPyramid pyramid;
+  pyramid.build(large);
+
+  // full view and two zoom steps on a 800x800 pixel canvas
+  vector<float> max_intensities;
+  for (Size zoom = 1; zoom <= 4; zoom *= 2)
+  {
+    double rt_max = large.getMaxRT() / zoom;
+    double mz_max = 300.0 + (large.getMaxMZ() - 300.0) / zoom;
+    bool rendered = pyramid.render(0.0, rt_max, 300.0, mz_max, 800, 800, max_intensities);
+    TEST_EQUAL(rendered, zoom <= 2)
+  }
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,108 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+
+///////////////////////////
+
+#include <OpenMS/VISUAL/TOPPASScene.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(TOPPASScene, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+START_SECTION((static int selectNextProcess(const QList<TOPPProcess> & queue, int threads_active, int allowed_threads)))
+{
+  QList<TOPPASScene::TOPPProcess> queue;
+  TEST_EQUAL(TOPPASScene::selectNextProcess(queue, 0, 1), -1)
+
+  // default budget of one thread: a tool configured with more threads still runs, but alone and with all its threads
+  queue << TOPPASScene::TOPPProcess(0, "tool", QStringList(), 0, 4);
+  TEST_EQUAL(TOPPASScene::selectNextProcess(queue, 0, 1), 0)
+  TEST_EQUAL(TOPPASScene::selectNextProcess(queue, 1, 1), -1)
+  TEST_EQUAL(queue[0].threads, 4)
+
+  // the highest priority comes first, first come first served for ties
+  queue.clear();
+  queue << TOPPASScene::TOPPProcess(0, "first", QStringList(), 0, 1);
+  queue << TOPPASScene::TOPPProcess(0, "second", QStringList(), 0, 2);
+  queue << TOPPASScene::TOPPProcess(0, "third", QStringList(), 0, 2);
+  queue[1].priority = 3;
+  queue[2].priority = 3;
+  TEST_EQUAL(TOPPASScene::selectNextProcess(queue, 0, 4), 1)
+  TEST_EQUAL(TOPPASScene::selectNextProcess(queue, 2, 4), 1)
+
+  // processes with a lower priority which fit are started ahead of one that waits for threads
+  TEST_EQUAL(TOPPASScene::selectNextProcess(queue, 3, 4), 0)
+  TEST_EQUAL(TOPPASScene::selectNextProcess(queue, 4, 4), -1)
+
+  // start processes like TOPPASScene::runNextProcess does, until the budget is used up
+  int threads_active = 0;
+  QStringList started;
+  int next;
+  while ((next = TOPPASScene::selectNextProcess(queue, threads_active, 4)) != -1)
+  {
+    TOPPASScene::TOPPProcess tp = queue.takeAt(next);
+    threads_active += tp.threads;
+    started << tp.command;
+  }
+  TEST_EQUAL(started.join(",").toStdString(), "second,third")
+  TEST_EQUAL(threads_active, 4)
+  TEST_EQUAL(queue.size(), 1)
+
+  // once one of them finished, the remaining process can start
+  threads_active -= 2;
+  TEST_EQUAL(TOPPASScene::selectNextProcess(queue, threads_active, 4), 0)
+
+  // a process that needs more threads than allowed only runs when nothing else is running
+  queue.clear();
+  queue << TOPPASScene::TOPPProcess(0, "big", QStringList(), 0, 8);
+  queue << TOPPASScene::TOPPProcess(0, "small", QStringList(), 0, 1);
+  queue[0].priority = 2;
+  TEST_EQUAL(TOPPASScene::selectNextProcess(queue, 0, 4), 1)
+  TEST_EQUAL(TOPPASScene::selectNextProcess(queue, 1, 4), 1)
+  queue.removeAt(1);
+  TEST_EQUAL(TOPPASScene::selectNextProcess(queue, 1, 4), -1)
+  TEST_EQUAL(TOPPASScene::selectNextProcess(queue, 0, 4), 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
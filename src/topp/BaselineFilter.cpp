@@ -37,6 +37,9 @@
 #include <OpenMS/FORMAT/PeakTypeEstimator.h>
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 
+#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataFilteringConsumer.h>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -109,6 +112,30 @@ protected:
     setValidStrings_("struc_elem_unit", ListUtils::create<String>("Thomson,DataPoints"));
     registerStringOption_("method", "<string>", "tophat", "The name of the morphological filter to be applied. If you are unsure, use the default.", false);
     setValidStrings_("method", ListUtils::create<String>("identity,erosion,dilation,opening,closing,gradient,tophat,bothat,erosion_simple,dilation_simple"));
+
+    registerStringOption_("processOption", "<name>", "inmemory", "Whether to load all data and process them in-memory or whether to process the data on the fly (lowmemory) without loading the whole file into memory first", false, true);
+    setValidStrings_("processOption", ListUtils::create<String>("inmemory,lowmemory"));
+  }
+
+  ExitCodes doLowMemAlgorithm(const MorphologicalFilter& morph_filter, const String& in, const String& out)
+  {
+    ///////////////////////////////////
+    // Create the consumer objects, add data processing
+    ///////////////////////////////////
+    PlainMSDataWritingConsumer writingConsumer(out);
+    writingConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::BASELINE_REDUCTION));
+    // filter batches of spectra in parallel before writing them, chromatograms are written unchanged
+    MSDataFilteringConsumer<MorphologicalFilter> filteringConsumer(morph_filter, &writingConsumer, false);
+
+    ///////////////////////////////////
+    // Create new MSDataReader and set our consumer
+    ///////////////////////////////////
+    MzMLFile mz_data_file;
+    mz_data_file.setLogType(log_type_);
+    mz_data_file.transform(in, &filteringConsumer);
+    filteringConsumer.flush();
+
+    return EXECUTION_OK;
   }
 
   ExitCodes main_(int, const char **)
@@ -118,6 +145,21 @@ protected:
     //-------------------------------------------------------------
     String in = getStringOption_("in");
     String out = getStringOption_("out");
+    String process_option = getStringOption_("processOption");
+
+    MorphologicalFilter morph_filter;
+    morph_filter.setLogType(log_type_);
+
+    Param parameters;
+    parameters.setValue("struc_elem_length", getDoubleOption_("struc_elem_length"));
+    parameters.setValue("struc_elem_unit", getStringOption_("struc_elem_unit"));
+    parameters.setValue("method", getStringOption_("method"));
+    morph_filter.setParameters(parameters);
+
+    if (process_option == "lowmemory")
+    {
+      return doLowMemAlgorithm(morph_filter, in, out);
+    }
 
     //-------------------------------------------------------------
     // loading input
@@ -153,15 +195,6 @@ protected:
     //-------------------------------------------------------------
     // calculations
     //-------------------------------------------------------------
-    MorphologicalFilter morph_filter;
-    morph_filter.setLogType(log_type_);
-
-    Param parameters;
-    parameters.setValue("struc_elem_length", getDoubleOption_("struc_elem_length"));
-    parameters.setValue("struc_elem_unit", getStringOption_("struc_elem_unit"));
-    parameters.setValue("method", getStringOption_("method"));
-
-    morph_filter.setParameters(parameters);
     morph_filter.filterExperiment(ms_exp);
 
     //-------------------------------------------------------------
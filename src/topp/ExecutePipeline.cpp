@@ -108,7 +108,7 @@ protected:
     setValidFormats_("in", ListUtils::create<String>("toppas"));
     registerStringOption_("out_dir", "<directory>", "", "Directory for output files (default: user's home directory)", false);
     registerStringOption_("resource_file", "<file>", "", "A TOPPAS resource file (*.trf) specifying the files this workflow is to be applied to", false);
-    registerIntOption_("num_jobs", "<integer>", 1, "Maximum number of jobs running in parallel", false, false);
+    registerIntOption_("num_jobs", "<integer>", 1, "Maximum number of threads used by all jobs running in parallel. Each job counts with the number of threads it is configured to use (its 'threads' parameter), and waits until enough of the threads are free (jobs which fit may start ahead of it). A job configured with more threads than allowed runs alone.", false, false);
     setMinInt_("num_jobs", 1);
   }
 
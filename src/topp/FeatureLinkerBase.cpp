@@ -75,13 +75,35 @@ protected:
   void registerOptionsAndFlags_()   // only for "unlabeled" algorithms!
   {
     registerInputFileList_("in", "<files>", ListUtils::create<String>(""), "input files separated by blanks", true);
-    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML"));
+    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML,featureBin,consensusBin"));
     registerOutputFile_("out", "<file>", "", "Output file", true);
-    setValidFormats_("out", ListUtils::create<String>("consensusXML"));
+    setValidFormats_("out", ListUtils::create<String>("consensusXML,consensusBin"));
     addEmptyLine_();
     registerFlag_("keep_subelements", "For consensusXML input only: If set, the sub-features of the inputs are transferred to the output.");
   }
 
+  /// Loads a feature map (featureXML or featureBin) without convex hulls and subordinates, which are not needed for grouping
+  void loadFeatures_(const String & filename, FileTypes::Type file_type, FeatureMap & map) const
+  {
+    if (file_type == FileTypes::FEATUREBIN)
+    {
+      BinaryDataFile().load(filename, map);
+      for (FeatureMap::Iterator it = map.begin(); it != map.end(); ++it)
+      {
+        it->getSubordinates().clear();
+        it->getConvexHulls().clear();
+      }
+    }
+    else
+    {
+      // to save memory don't load convex hulls and subordinates
+      FeatureXMLFile f;
+      f.getOptions().setLoadConvexHull(false);
+      f.getOptions().setLoadSubordinates(false);
+      f.load(filename, map);
+    }
+  }
+
   ExitCodes common_main_(FeatureGroupingAlgorithm * algorithm,
                          bool labeled = false)
   {
@@ -120,15 +142,9 @@ protected:
     // load input
     ConsensusMap out_map;
     StringList ms_run_locations;
-    if (file_type == FileTypes::FEATUREXML)
+    if (file_type == FileTypes::FEATUREXML || file_type == FileTypes::FEATUREBIN)
     {
       vector<ConsensusMap > maps(ins.size());
-      FeatureXMLFile f;
-      FeatureFileOptions param = f.getOptions();
-      // to save memory don't load convex hulls and subordinates
-      param.setLoadSubordinates(false);
-      param.setLoadConvexHull(false);
-      f.setOptions(param);
 
       Size progress = 0;
       setLogType(ProgressLogger::CMD);
@@ -136,7 +152,7 @@ protected:
       for (Size i = 0; i < ins.size(); ++i)
       {
         FeatureMap tmp;
-        f.load(ins[i], tmp);
+        loadFeatures_(ins[i], file_type, tmp);
         out_map.getFileDescriptions()[i].filename = ins[i];
         out_map.getFileDescriptions()[i].size = tmp.size();
         out_map.getFileDescriptions()[i].unique_id = tmp.getUniqueId();
@@ -176,10 +192,9 @@ protected:
     else
     {
       vector<ConsensusMap> maps(ins.size());
-      ConsensusXMLFile f;
       for (Size i = 0; i < ins.size(); ++i)
       {
-        f.load(ins[i], maps[i]);
+        FileHandler().loadConsensusFeatures(ins[i], maps[i], file_type);
         maps[i].updateRanges();
         // copy over information on the primary MS run
         const StringList& ms_runs = maps[i].getPrimaryMSRunPath();
@@ -218,7 +233,11 @@ protected:
     out_map.setPrimaryMSRunPath(ms_run_locations);
 
     // write output
-    ConsensusXMLFile().store(out, out_map);
+    // consensusXML, unless the file name asks for consensusBin
+    if (!FileHandler().storeConsensusFeatures(out, out_map))
+    {
+      ConsensusXMLFile().store(out, out_map);
+    }
 
     // some statistics
     map<Size, UInt> num_consfeat_of_size;
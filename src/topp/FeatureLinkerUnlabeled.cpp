@@ -152,14 +152,25 @@ protected:
     // load input
     ConsensusMap out_map;
     StringList ms_run_locations;
-    if (file_type == FileTypes::FEATUREXML)
+    if (file_type == FileTypes::FEATUREXML || file_type == FileTypes::FEATUREBIN)
     {
       // use map with highest number of features as reference:
       Size max_count(0);
       FeatureXMLFile f;
       for (Size i = 0; i < ins.size(); ++i)
       {
-        Size s = f.loadSize(ins[i]);
+        Size s;
+        if (file_type == FileTypes::FEATUREBIN)
+        {
+          // binary files are read quickly, but there is no shortcut for the size
+          FeatureMap tmp_map;
+          BinaryDataFile().load(ins[i], tmp_map);
+          s = tmp_map.size();
+        }
+        else
+        {
+          s = f.loadSize(ins[i]);
+        }
         if (s > max_count)
         {
           max_count = s;
@@ -174,10 +185,7 @@ protected:
       std::vector<ProteinIdentification> ref_protids;
       {
         FeatureMap map_ref;
-        FeatureXMLFile f_fxml_tmp;
-        f_fxml_tmp.getOptions().setLoadConvexHull(false);
-        f_fxml_tmp.getOptions().setLoadSubordinates(false);
-        f_fxml_tmp.load(ins[reference_index], map_ref);
+        loadFeatures_(ins[reference_index], file_type, map_ref);
         algorithm->setReference(reference_index, map_ref);
         ref_id = map_ref.getUniqueId();
         ref_size = map_ref.size();
@@ -190,11 +198,8 @@ protected:
       for (Size i = 0; i < ins.size(); ++i)
       {
 
-        FeatureXMLFile f_fxml_tmp;
         FeatureMap tmp_map;
-        f_fxml_tmp.getOptions().setLoadConvexHull(false);
-        f_fxml_tmp.getOptions().setLoadSubordinates(false);
-        f_fxml_tmp.load(ins[i], tmp_map);
+        loadFeatures_(ins[i], file_type, tmp_map);
 
         // copy over information on the primary MS run
         const StringList& ms_runs = tmp_map.getPrimaryMSRunPath();
@@ -275,10 +280,9 @@ protected:
     else
     {
       vector<ConsensusMap> maps(ins.size());
-      ConsensusXMLFile f;
       for (Size i = 0; i < ins.size(); ++i)
       {
-        f.load(ins[i], maps[i]);
+        loadConsensus_(ins[i], file_type, maps[i]);
         const StringList& ms_runs = maps[i].getPrimaryMSRunPath();
         ms_run_locations.insert(ms_run_locations.end(), ms_runs.begin(), ms_runs.end());
       }
@@ -312,7 +316,7 @@ protected:
 
     out_map.setPrimaryMSRunPath(ms_run_locations);
     // write output
-    ConsensusXMLFile().store(out, out_map);
+    storeConsensus_(out, out_map);
 
     // some statistics
     map<Size, UInt> num_consfeat_of_size;
@@ -39,6 +39,7 @@
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/BinaryDataFile.h>
 #include <OpenMS/FORMAT/MzXMLFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/IBSpectraFile.h>
@@ -111,6 +112,7 @@ using namespace std;
   @ref OpenMS::SpecArrayFile "peplist"
   @ref OpenMS::KroenikFile "kroenik"
   @ref OpenMS::EDTAFile "edta"
+  @ref OpenMS::BinaryDataFile "featureBin/consensusBin"
 
   @note See @ref TOPP_IDFileConverter for similar functionality for protein/peptide identification file formats.
 
@@ -156,7 +158,7 @@ protected:
   {
     registerInputFile_("in", "<file>", "", "Input file to convert.");
     registerStringOption_("in_type", "<type>", "", "Input file type -- default: determined from file extension or content\n", false);
-    String formats("mzData,mzXML,mzML,cachedMzML,dta,dta2d,mgf,featureXML,consensusXML,ms2,fid,tsv,peplist,kroenik,edta");
+    String formats("mzData,mzXML,mzML,cachedMzML,dta,dta2d,mgf,featureXML,consensusXML,featureBin,consensusBin,ms2,fid,tsv,peplist,kroenik,edta");
     setValidFormats_("in", ListUtils::create<String>(formats));
     setValidStrings_("in_type", ListUtils::create<String>(formats));
     
@@ -164,7 +166,7 @@ protected:
     String method("none,ensure,reassign");
     setValidStrings_("UID_postprocessing", ListUtils::create<String>(method));
 
-    formats = "mzData,mzXML,mzML,cachedMzML,dta2d,mgf,featureXML,consensusXML,edta,csv";
+    formats = "mzData,mzXML,mzML,cachedMzML,dta2d,mgf,featureXML,consensusXML,featureBin,consensusBin,edta,csv";
     registerOutputFile_("out", "<file>", "", "Output file");
     setValidFormats_("out", ListUtils::create<String>(formats));
     registerStringOption_("out_type", "<type>", "", "Output file type -- default: determined from file extension or content\nNote: that not all conversion paths work or make sense.", false);
@@ -219,6 +221,19 @@ protected:
       return PARSE_ERROR;
     }
 
+    // binary feature/consensus maps hold the same data as their XML counterparts,
+    // so they are handled like those and only differ when reading and writing
+    bool in_binary = (in_type == FileTypes::FEATUREBIN || in_type == FileTypes::CONSENSUSBIN);
+    if (in_binary)
+    {
+      in_type = (in_type == FileTypes::FEATUREBIN ? FileTypes::FEATUREXML : FileTypes::CONSENSUSXML);
+    }
+    bool out_binary = (out_type == FileTypes::FEATUREBIN || out_type == FileTypes::CONSENSUSBIN);
+    if (out_binary)
+    {
+      out_type = (out_type == FileTypes::FEATUREBIN ? FileTypes::FEATUREXML : FileTypes::CONSENSUSXML);
+    }
+
     bool TIC_DTA2D = getFlag_("TIC_DTA2D");
     bool process_lowmemory = getFlag_("process_lowmemory");
 
@@ -242,7 +257,14 @@ protected:
 
     if (in_type == FileTypes::CONSENSUSXML)
     {
-      ConsensusXMLFile().load(in, cm);
+      if (in_binary)
+      {
+        BinaryDataFile().load(in, cm);
+      }
+      else
+      {
+        ConsensusXMLFile().load(in, cm);
+      }
       cm.sortByPosition();
       if ((out_type != FileTypes::FEATUREXML) &&
           (out_type != FileTypes::CONSENSUSXML))
@@ -269,7 +291,7 @@ protected:
              in_type == FileTypes::PEPLIST ||
              in_type == FileTypes::KROENIK)
     {
-      fh.loadFeatures(in, fm, in_type);
+      fh.loadFeatures(in, fm, in_binary ? FileTypes::FEATUREBIN : in_type);
       fm.sortByPosition();
       if ((out_type != FileTypes::FEATUREXML) &&
           (out_type != FileTypes::CONSENSUSXML))
@@ -489,7 +511,14 @@ protected:
 
       addDataProcessing_(fm, getProcessingInfo_(DataProcessing::
                                                 FORMAT_CONVERSION));
-      FeatureXMLFile().store(out, fm);
+      if (out_binary)
+      {
+        BinaryDataFile().store(out, fm);
+      }
+      else
+      {
+        FeatureXMLFile().store(out, fm);
+      }
     }
     else if (out_type == FileTypes::CONSENSUSXML)
     {
@@ -516,7 +545,14 @@ protected:
 
       addDataProcessing_(cm, getProcessingInfo_(DataProcessing::
                                                 FORMAT_CONVERSION));
-      ConsensusXMLFile().store(out, cm);
+      if (out_binary)
+      {
+        BinaryDataFile().store(out, cm);
+      }
+      else
+      {
+        ConsensusXMLFile().store(out, cm);
+      }
     }
     else if (out_type == FileTypes::EDTA)
     {
@@ -33,6 +33,7 @@
 // Hendrik Weisser
 // --------------------------------------------------------------------------
 
+#include <OpenMS/FORMAT/BinaryDataFile.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
@@ -111,6 +112,7 @@ For Percolator tab-delimited output, information is extracted from the "PSMId" c
 Some information about the supported input types:
 @li @ref OpenMS::MzIdentMLFile "mzIdentML"
 @li @ref OpenMS::IdXMLFile "idXML"
+@li @ref OpenMS::BinaryDataFile "idBin" (binary equivalent of idXML, for fast storage of intermediate results)
 @li @ref OpenMS::PepXMLFile "pepXML"
 @li @ref OpenMS::ProtXMLFile "protXML"
 @li @ref OpenMS::MascotXMLFile "Mascot XML"
@@ -149,10 +151,10 @@ protected:
                        "- a single file in a search engine-specific format (Mascot: mascotXML, OMSSA: omssaXML, X! Tandem: xml, Percolator: psms),\n"
                        "- a single text file (tab separated) with one line for all peptide sequences matching a spectrum (top N hits),\n"
                        "- for Sequest results, a directory containing .out files.\n");
-    setValidFormats_("in", ListUtils::create<String>("pepXML,protXML,mascotXML,omssaXML,xml,psms,tsv,idXML,mzid"));
+    setValidFormats_("in", ListUtils::create<String>("pepXML,protXML,mascotXML,omssaXML,xml,psms,tsv,idXML,idBin,mzid"));
 
     registerOutputFile_("out", "<file>", "", "Output file", true);
-    String formats("idXML,mzid,pepXML,FASTA");
+    String formats("idXML,idBin,mzid,pepXML,FASTA");
     setValidFormats_("out", ListUtils::create<String>(formats));
     registerStringOption_("out_type", "<type>", "", "Output file type (default: determined from file extension)", false);
     setValidStrings_("out_type", ListUtils::create<String>(formats));
@@ -330,6 +332,11 @@ protected:
         IdXMLFile().load(in, protein_identifications, peptide_identifications);
       }
 
+      else if (in_type == FileTypes::IDBIN)
+      {
+        BinaryDataFile().load(in, protein_identifications, peptide_identifications);
+      }
+
       else if (in_type == FileTypes::MZIDENTML)
       {
         LOG_WARN << "Converting from mzid: you might experience loss of information depending on the capabilities of the target format." << endl;
@@ -500,6 +507,11 @@ protected:
       IdXMLFile().store(out, protein_identifications, peptide_identifications);
     }
 
+    else if (out_type == FileTypes::IDBIN)
+    {
+      BinaryDataFile().store(out, protein_identifications, peptide_identifications);
+    }
+
     else if (out_type == FileTypes::MZIDENTML)
     {
       if (!mz_file.empty())
@@ -132,11 +132,11 @@ protected:
   void registerOptionsAndFlags_()
   {
     registerInputFile_("id", "<file>", "", "Protein/peptide identifications file");
-    setValidFormats_("id", ListUtils::create<String>("mzid,idXML"));
+    setValidFormats_("id", ListUtils::create<String>("mzid,idXML,idBin"));
     registerInputFile_("in", "<file>", "", "Feature map/consensus map file");
-    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML,mzq"));
-    registerOutputFile_("out", "<file>", "", "Output file (the format depends on the input file format).");
-    setValidFormats_("out", ListUtils::create<String>("featureXML,consensusXML,mzq"));
+    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML,mzq,featureBin,consensusBin"));
+    registerOutputFile_("out", "<file>", "", "Output file (the format depends on the input file format; feature and consensus maps can be written as XML or binary files).");
+    setValidFormats_("out", ListUtils::create<String>("featureXML,consensusXML,mzq,featureBin,consensusBin"));
 
     addEmptyLine_();
     IDMapper mapper;
@@ -173,16 +173,8 @@ protected:
     String id = getStringOption_("id");
     vector<ProteinIdentification> protein_ids;
     vector<PeptideIdentification> peptide_ids;
-    FileTypes::Type in_type = FileHandler::getType(id);
-    if (in_type == FileTypes::IDXML)
-    {
-      IdXMLFile().load(id, protein_ids, peptide_ids);
-    }
-    else if (in_type == FileTypes::MZIDENTML)
-    {
-      MzIdentMLFile().load(id, protein_ids, peptide_ids);
-    }
-    else
+    FileHandler fh;
+    if (!fh.loadIdentifications(id, protein_ids, peptide_ids))
     {
       throw Exception::IllegalArgument(__FILE__, __LINE__,
                                        OPENMS_PRETTY_FUNCTION,
@@ -191,7 +183,7 @@ protected:
 
     String in = getStringOption_("in");
     String out = getStringOption_("out");
-    in_type = FileHandler::getType(in);
+    FileTypes::Type in_type = FileHandler::getType(in);
     //----------------------------------------------------------------
     //create mapper
     //----------------------------------------------------------------
@@ -208,12 +200,11 @@ protected:
     //----------------------------------------------------------------
     // consensusXML
     //----------------------------------------------------------------
-    if (in_type == FileTypes::CONSENSUSXML)
+    if (in_type == FileTypes::CONSENSUSXML || in_type == FileTypes::CONSENSUSBIN)
     {
       // LOG_DEBUG << "Processing consensus map..." << endl;
-      ConsensusXMLFile file;
       ConsensusMap map;
-      file.load(in, map);
+      fh.loadConsensusFeatures(in, map, in_type);
 
       bool measure_from_subelements = getFlag_("consensus:use_subelements");
       bool annotate_ids_with_subelements = getFlag_("consensus:annotate_ids_with_subelements");
@@ -223,18 +214,21 @@ protected:
       //annotate output with data processing info
       addDataProcessing_(map, getProcessingInfo_(DataProcessing::IDENTIFICATION_MAPPING));
 
-      file.store(out, map);
+      // the output format is taken from the file name (consensusXML by default)
+      if (!fh.storeConsensusFeatures(out, map))
+      {
+        ConsensusXMLFile().store(out, map);
+      }
     }
 
     //----------------------------------------------------------------
     // featureXML
     //----------------------------------------------------------------
-    if (in_type == FileTypes::FEATUREXML)
+    if (in_type == FileTypes::FEATUREXML || in_type == FileTypes::FEATUREBIN)
     {
       // LOG_DEBUG << "Processing feature map..." << endl;
       FeatureMap map;
-      FeatureXMLFile file;
-      file.load(in, map);
+      fh.loadFeatures(in, map, in_type);
 
       mapper.annotate(map, peptide_ids, protein_ids,
                       getFlag_("feature:use_centroid_rt"),
@@ -243,7 +237,11 @@ protected:
       //annotate output with data processing info
       addDataProcessing_(map, getProcessingInfo_(DataProcessing::IDENTIFICATION_MAPPING));
 
-      file.store(out, map);
+      // the output format is taken from the file name (featureXML by default)
+      if (!fh.storeFeatures(out, map))
+      {
+        FeatureXMLFile().store(out, map);
+      }
     }
 
     //----------------------------------------------------------------
@@ -209,23 +209,23 @@ private:
         MzMLFile().load(reference_file, experiment);
         algorithm.setReference(experiment);
       }
-      else if (filetype == FileTypes::FEATUREXML)
+      else if (filetype == FileTypes::FEATUREXML || filetype == FileTypes::FEATUREBIN)
       {
         FeatureMap features;
-        FeatureXMLFile().load(reference_file, features);
+        FileHandler().loadFeatures(reference_file, features, filetype);
         algorithm.setReference(features);
       }
-      else if (filetype == FileTypes::CONSENSUSXML)
+      else if (filetype == FileTypes::CONSENSUSXML || filetype == FileTypes::CONSENSUSBIN)
       {
         ConsensusMap consensus;
-        ConsensusXMLFile().load(reference_file, consensus);
+        FileHandler().loadConsensusFeatures(reference_file, consensus, filetype);
         algorithm.setReference(consensus);
       }
-      else if (filetype == FileTypes::IDXML)
+      else if (filetype == FileTypes::IDXML || filetype == FileTypes::IDBIN)
       {
         vector<ProteinIdentification> proteins;
         vector<PeptideIdentification> peptides;
-        IdXMLFile().load(reference_file, proteins, peptides);
+        FileHandler().loadIdentifications(reference_file, proteins, peptides, filetype);
         algorithm.setReference(peptides);
       }
     }
@@ -235,7 +235,7 @@ private:
 
   void registerOptionsAndFlags_()
   {
-    String formats = "featureXML,consensusXML,idXML";
+    String formats = "featureXML,consensusXML,idXML,featureBin,consensusBin,idBin";
     TOPPMapAlignerBase::registerOptionsAndFlags_(formats, REF_FLEXIBLE);
 
     registerSubsection_("algorithm", "Algorithm parameters section");
@@ -281,10 +281,11 @@ private:
     //-------------------------------------------------------------
     // perform feature alignment
     //-------------------------------------------------------------
-    if (in_type == FileTypes::FEATUREXML)
+    if (in_type == FileTypes::FEATUREXML || in_type == FileTypes::FEATUREBIN)
     {
       vector<FeatureMap> feature_maps(input_files.size());
       FeatureXMLFile fxml_file;
+      BinaryDataFile bin_file;
       if (output_files.empty())
       {
         // store only transformation descriptions, not transformed data =>
@@ -292,43 +293,72 @@ private:
         fxml_file.getOptions().setLoadConvexHull(false);
         fxml_file.getOptions().setLoadSubordinates(false);
       }
-      loadInitialMaps_(feature_maps, input_files, fxml_file);
+      if (in_type == FileTypes::FEATUREBIN)
+      {
+        loadInitialMaps_(feature_maps, input_files, bin_file);
+      }
+      else
+      {
+        loadInitialMaps_(feature_maps, input_files, fxml_file);
+      }
 
       performAlignment_(algorithm, feature_maps, transformations,
                         reference_index);
 
       if (!output_files.empty())
       {
-        storeTransformedMaps_(feature_maps, output_files, fxml_file);
+        if (in_type == FileTypes::FEATUREBIN)
+        {
+          storeTransformedMaps_(feature_maps, output_files, bin_file);
+        }
+        else
+        {
+          storeTransformedMaps_(feature_maps, output_files, fxml_file);
+        }
       }
     }
 
     //-------------------------------------------------------------
     // perform consensus alignment
     //-------------------------------------------------------------
-    else if (in_type == FileTypes::CONSENSUSXML)
+    else if (in_type == FileTypes::CONSENSUSXML || in_type == FileTypes::CONSENSUSBIN)
     {
       std::vector<ConsensusMap> consensus_maps(input_files.size());
       ConsensusXMLFile cxml_file;
-      loadInitialMaps_(consensus_maps, input_files, cxml_file);
+      BinaryDataFile bin_file;
+      if (in_type == FileTypes::CONSENSUSBIN)
+      {
+        loadInitialMaps_(consensus_maps, input_files, bin_file);
+      }
+      else
+      {
+        loadInitialMaps_(consensus_maps, input_files, cxml_file);
+      }
 
       performAlignment_(algorithm, consensus_maps, transformations,
                         reference_index);
 
       if (!output_files.empty())
       {
-        storeTransformedMaps_(consensus_maps, output_files, cxml_file);
+        if (in_type == FileTypes::CONSENSUSBIN)
+        {
+          storeTransformedMaps_(consensus_maps, output_files, bin_file);
+        }
+        else
+        {
+          storeTransformedMaps_(consensus_maps, output_files, cxml_file);
+        }
       }
     }
 
     //-------------------------------------------------------------
     // perform peptide alignment
     //-------------------------------------------------------------
-    else if (in_type == FileTypes::IDXML)
+    else if (in_type == FileTypes::IDXML || in_type == FileTypes::IDBIN)
     {
       vector<vector<ProteinIdentification> > protein_ids(input_files.size());
       vector<vector<PeptideIdentification> > peptide_ids(input_files.size());
-      IdXMLFile idxml_file;
+      FileHandler fh;
       ProgressLogger progresslogger;
       progresslogger.setLogType(log_type_);
       progresslogger.startProgress(0, input_files.size(),
@@ -336,7 +366,7 @@ private:
       for (Size i = 0; i < input_files.size(); ++i)
       {
         progresslogger.setProgress(i);
-        idxml_file.load(input_files[i], protein_ids[i], peptide_ids[i]);
+        fh.loadIdentifications(input_files[i], protein_ids[i], peptide_ids[i], in_type);
       }
       progresslogger.endProgress();
 
@@ -350,7 +380,15 @@ private:
         for (Size i = 0; i < output_files.size(); ++i)
         {
           progresslogger.setProgress(i);
-          idxml_file.store(output_files[i], protein_ids[i], peptide_ids[i]);
+          // same format as the input
+          if (in_type == FileTypes::IDBIN)
+          {
+            BinaryDataFile().store(output_files[i], protein_ids[i], peptide_ids[i]);
+          }
+          else
+          {
+            IdXMLFile().store(output_files[i], protein_ids[i], peptide_ids[i]);
+          }
         }
         progresslogger.endProgress();
       }
@@ -118,7 +118,7 @@ public:
 protected:
   void registerOptionsAndFlags_()
   {
-    TOPPMapAlignerBase::registerOptionsAndFlags_("mzML,featureXML",
+    TOPPMapAlignerBase::registerOptionsAndFlags_("mzML,featureXML,featureBin",
                                                  REF_RESTRICTED);
     registerSubsection_("algorithm", "Algorithm parameters section");
   }
@@ -174,6 +174,12 @@ protected:
         {
           s = f.loadSize(in_files[i]);
         }
+        else if (in_type == FileTypes::FEATUREBIN)
+        {
+          FeatureMap map;
+          BinaryDataFile().load(in_files[i], map);
+          s = map.size();
+        }
         else if (in_type == FileTypes::MZML) // this is expensive!
         {
           MSExperiment<> exp;
@@ -206,6 +212,12 @@ protected:
       f_fxml_tmp.load(file, map_ref);
       algorithm.setReference(map_ref);
     }
+    else if (in_type == FileTypes::FEATUREBIN)
+    {
+      FeatureMap map_ref;
+      BinaryDataFile().load(file, map_ref);
+      algorithm.setReference(map_ref);
+    }
     else if (in_type == FileTypes::MZML)
     {
       MSExperiment<> map_ref;
@@ -225,13 +237,14 @@ protected:
     for (int i = 0; i < static_cast<int>(in_files.size()); ++i)
     {
       TransformationDescription trafo;
-      if (in_type == FileTypes::FEATUREXML)
+      if (in_type == FileTypes::FEATUREXML || in_type == FileTypes::FEATUREBIN)
       {
         FeatureMap map;
         // workaround for loading: use temporary FeatureXMLFile since it is not thread-safe
         FeatureXMLFile f_fxml_tmp; // do not use OMP-firstprivate, since FeatureXMLFile has no copy c'tor
         f_fxml_tmp.getOptions() = f_fxml.getOptions();
-        f_fxml_tmp.load(in_files[i], map);
+        if (in_type == FileTypes::FEATUREBIN) BinaryDataFile().load(in_files[i], map);
+        else f_fxml_tmp.load(in_files[i], map);
         if (i == static_cast<int>(reference_index)) trafo.fitModel("identity");
         else algorithm.align(map, trafo);
         if (out_files.size())
@@ -239,7 +252,8 @@ protected:
           MapAlignmentTransformer::transformRetentionTimes(map, trafo);
           // annotate output with data processing info
           addDataProcessing_(map, getProcessingInfo_(DataProcessing::ALIGNMENT));
-          f_fxml_tmp.store(out_files[i], map);
+          if (in_type == FileTypes::FEATUREBIN) BinaryDataFile().store(out_files[i], map);
+          else f_fxml_tmp.store(out_files[i], map);
         }
       }
       else if (in_type == FileTypes::MZML)
@@ -41,6 +41,7 @@
 #include <OpenMS/DATASTRUCTURES/StringListUtils.h>
 
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataFilteringConsumer.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -99,35 +100,6 @@ public:
   {
   }
 
-  /**
-    @brief Helper class for the Low Memory Noise filtering
-  */
-  class NFGaussMzMLConsumer :
-    public MSDataWritingConsumer 
-  {
-
-  public:
-
-    NFGaussMzMLConsumer(const String& filename, const GaussFilter& gf) :
-      MSDataWritingConsumer(filename) 
-    {
-      gf_ = gf;
-    }
-
-    void processSpectrum_(MapType::SpectrumType& s)
-    {
-      gf_.filter(s);
-    }
-
-    void processChromatogram_(MapType::ChromatogramType& c) 
-    {
-      gf_.filter(c);
-    }
-
-  private:
-    GaussFilter gf_;
-  };
-
   void registerOptionsAndFlags_()
   {
     registerInputFile_("in", "<file>", "", "input raw data file ");
@@ -149,17 +121,20 @@ public:
   ExitCodes doLowMemAlgorithm(const GaussFilter& gauss)
   {
     ///////////////////////////////////
-    // Create the consumer object, add data processing
+    // Create the consumer objects, add data processing
     ///////////////////////////////////
-    NFGaussMzMLConsumer gaussConsumer(out, gauss);
-    gaussConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
+    PlainMSDataWritingConsumer writingConsumer(out);
+    writingConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
+    // smooth batches of spectra in parallel before writing them
+    MSDataFilteringConsumer<GaussFilter> filteringConsumer(gauss, &writingConsumer);
 
     ///////////////////////////////////
     // Create new MSDataReader and set our consumer
     ///////////////////////////////////
     MzMLFile mz_data_file;
     mz_data_file.setLogType(log_type_);
-    mz_data_file.transform(in, &gaussConsumer);
+    mz_data_file.transform(in, &filteringConsumer);
+    filteringConsumer.flush();
 
     return EXECUTION_OK;
   }
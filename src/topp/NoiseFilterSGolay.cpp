@@ -41,6 +41,7 @@
 #include <OpenMS/DATASTRUCTURES/StringListUtils.h>
 
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataFilteringConsumer.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -102,35 +103,6 @@ public:
   {
   }
 
-  /**
-    @brief Helper class for the Low Memory Noise filtering
-  */
-  class NFSGolayMzMLConsumer :
-    public MSDataWritingConsumer 
-  {
-
-  public:
-
-    NFSGolayMzMLConsumer(const String& filename, const SavitzkyGolayFilter& sgf) :
-      MSDataWritingConsumer(filename) 
-    {
-      sgf_ = sgf;
-    }
-
-    void processSpectrum_(MapType::SpectrumType& s)
-    {
-      sgf_.filter(s);
-    }
-
-    void processChromatogram_(MapType::ChromatogramType& c) 
-    {
-      sgf_.filter(c);
-    }
-
-  private:
-    SavitzkyGolayFilter sgf_;
-  };
-
   void registerOptionsAndFlags_()
   {
     registerInputFile_("in", "<file>", "", "input raw data file ");
@@ -152,17 +124,20 @@ public:
   ExitCodes doLowMemAlgorithm(const SavitzkyGolayFilter& sgolay)
   {
     ///////////////////////////////////
-    // Create the consumer object, add data processing
+    // Create the consumer objects, add data processing
     ///////////////////////////////////
-    NFSGolayMzMLConsumer sgolayConsumer(out, sgolay);
-    sgolayConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
+    PlainMSDataWritingConsumer writingConsumer(out);
+    writingConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
+    // smooth batches of spectra in parallel before writing them
+    MSDataFilteringConsumer<SavitzkyGolayFilter> filteringConsumer(sgolay, &writingConsumer);
 
     ///////////////////////////////////
     // Create new MSDataReader and set our consumer
     ///////////////////////////////////
     MzMLFile mz_data_file;
     mz_data_file.setLogType(log_type_);
-    mz_data_file.transform(in, &sgolayConsumer);
+    mz_data_file.transform(in, &filteringConsumer);
+    filteringConsumer.flush();
 
     return EXECUTION_OK;
   }
@@ -346,9 +346,9 @@ protected:
   void registerOptionsAndFlags_()
   {
     registerInputFile_("in", "<file>", "", "Input file");
-    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML,idXML"));
+    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML,idXML,featureBin,consensusBin,idBin"));
     registerInputFile_("protein_groups", "<file>", "", "Protein inference results for the identification runs that were used to annotate the input (e.g. from ProteinProphet via IDFileConverter or Fido via FidoAdapter).\nInformation about indistinguishable proteins will be used for protein quantification.", false);
-    setValidFormats_("protein_groups", ListUtils::create<String>("idXML"));
+    setValidFormats_("protein_groups", ListUtils::create<String>("idXML,idBin"));
     registerOutputFile_("out", "<file>", "", "Output file for protein abundances", false);
     setValidFormats_("out", ListUtils::create<String>("csv"));
     registerOutputFile_("peptide_out", "<file>", "", "Output file for peptide abundances", false);
@@ -670,7 +670,10 @@ protected:
     if (!protein_groups.empty()) // read protein inference data
     {
       vector<ProteinIdentification> proteins;
-      IdXMLFile().load(protein_groups, proteins, peptides_);
+      if (!FileHandler().loadIdentifications(protein_groups, proteins, peptides_))
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Wrong file format of protein inference data '" + protein_groups + "' (expected idXML or idBin)");
+      }
       if (proteins.empty() || 
           proteins[0].getIndistinguishableProteins().empty())
       {
@@ -688,10 +691,10 @@ protected:
 
     FileTypes::Type in_type = FileHandler::getType(in);
 
-    if (in_type == FileTypes::FEATUREXML)
+    if (in_type == FileTypes::FEATUREXML || in_type == FileTypes::FEATUREBIN)
     {
       FeatureMap features;
-      FeatureXMLFile().load(in, features);
+      FileHandler().loadFeatures(in, features, in_type);
       files_[0].filename = in;
       // protein inference results in the featureXML?
       if (protein_groups.empty() &&
@@ -702,12 +705,12 @@ protected:
       }
       quantifier.readQuantData(features);
     }
-    else if (in_type == FileTypes::IDXML)
+    else if (in_type == FileTypes::IDXML || in_type == FileTypes::IDBIN)
     {
       spectral_counting_ = true;
       vector<ProteinIdentification> proteins;
       vector<PeptideIdentification> peptides;
-      IdXMLFile().load(in, proteins, peptides);
+      FileHandler().loadIdentifications(in, proteins, peptides, in_type);
       for (Size i = 0; i < proteins.size(); ++i)
       {
         files_[i].filename = proteins[i].getIdentifier();
@@ -720,10 +723,10 @@ protected:
       }
       quantifier.readQuantData(proteins, peptides);
     }
-    else // consensusXML
+    else // consensusXML or consensusBin
     {
       ConsensusMap consensus;
-      ConsensusXMLFile().load(in, consensus);
+      FileHandler().loadConsensusFeatures(in, consensus, (in_type == FileTypes::CONSENSUSBIN) ? FileTypes::CONSENSUSBIN : FileTypes::CONSENSUSXML);
       files_ = consensus.getFileDescriptions();
       // protein inference results in the consensusXML?
       if (protein_groups.empty() &&
@@ -0,0 +1,159 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2016.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinaryFile.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVReader.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
+
+#include <OpenMS/APPLICATIONS/TOPPBase.h>
+#include <OpenMS/FORMAT/TraMLFile.h>
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/FileTypes.h>
+
+using namespace OpenMS;
+
+//-------------------------------------------------------------
+//Doxygen docu
+//-------------------------------------------------------------
+
+/**
+  @page UTILS_OpenSwathAssayLibraryCacher OpenSwathAssayLibraryCacher
+
+  @brief Converts an assay library to the binary OpenSWATH assay library format (.oslib)
+
+  Parsing large TraML or TSV assay libraries (several million transitions)
+  can take a substantial amount of the total runtime of OpenSwathWorkflow.
+  This tool converts such a library once into a compact, columnar binary
+  file which can be memory-mapped and loaded by OpenSwathWorkflow (parameter
+  -tr) in a fraction of the time. See TransitionBinaryFile for a
+  description of the format.
+
+  The binary file stores all information OpenSwathWorkflow uses from the
+  assay library; it is not meant as an exchange format and should be
+  re-generated from the original library when %OpenMS is updated.
+
+  <B>The command line parameters of this tool are:</B>
+  @verbinclude UTILS_OpenSwathAssayLibraryCacher.cli
+  <B>INI file documentation of this tool:</B>
+  @htmlinclude UTILS_OpenSwathAssayLibraryCacher.html
+*/
+
+// We do not want this class to show up in the docu:
+/// @cond TOPPCLASSES
+class TOPPOpenSwathAssayLibraryCacher :
+  public TOPPBase
+{
+public:
+
+  TOPPOpenSwathAssayLibraryCacher() :
+    TOPPBase("OpenSwathAssayLibraryCacher", "Converts an assay library to the binary OpenSWATH assay library format for fast loading", false)
+  {
+  }
+
+protected:
+
+  void registerOptionsAndFlags_()
+  {
+    registerInputFile_("in", "<file>", "", "Input assay library (TraML, OpenSWATH transition TSV or SpectraST MRM file)");
+    registerStringOption_("in_type", "<type>", "", "input file type -- default: determined from file extension or content\n", false);
+    String formats("traML,tsv,csv,mrm");
+    setValidFormats_("in", ListUtils::create<String>(formats));
+    setValidStrings_("in_type", ListUtils::create<String>(formats));
+
+    registerOutputFile_("out", "<file>", "", "Output binary assay library");
+    setValidFormats_("out", ListUtils::create<String>("oslib"));
+
+    registerSubsection_("algorithm", "Algorithm parameters section (only used for TSV input)");
+  }
+
+  Param getSubsectionDefaults_(const String&) const
+  {
+    return TransitionTSVReader().getDefaults();
+  }
+
+  ExitCodes main_(int, const char**)
+  {
+    String in = getStringOption_("in");
+    String out = getStringOption_("out");
+
+    //input file type
+    FileHandler fh;
+    FileTypes::Type in_type = FileTypes::nameToType(getStringOption_("in_type"));
+
+    if (in_type == FileTypes::UNKNOWN)
+    {
+      in_type = fh.getType(in);
+      writeDebug_(String("Input file type: ") + FileTypes::typeToName(in_type), 2);
+    }
+
+    if (in_type == FileTypes::UNKNOWN)
+    {
+      writeLog_("Error: Could not determine input file type!");
+      return PARSE_ERROR;
+    }
+
+    OpenSwath::LightTargetedExperiment transition_exp;
+    std::cout << "Reading " << in << std::endl;
+    if (in_type == FileTypes::TRAML)
+    {
+      TargetedExperiment targeted_exp;
+      TraMLFile().load(in, targeted_exp);
+      OpenSwathDataAccessHelper::convertTargetedExp(targeted_exp, transition_exp);
+    }
+    else
+    {
+      TransitionTSVReader tsv_reader;
+      tsv_reader.setLogType(log_type_);
+      tsv_reader.setParameters(getParam_().copy("algorithm:", true));
+      tsv_reader.convertTSVToTargetedExperiment(in.c_str(), in_type, transition_exp);
+    }
+
+    std::cout << "Writing " << out << std::endl;
+    TransitionBinaryFile binary_file;
+    binary_file.setLogType(log_type_);
+    binary_file.store(out, transition_exp);
+
+    return EXECUTION_OK;
+  }
+
+};
+
+int main(int argc, const char** argv)
+{
+  TOPPOpenSwathAssayLibraryCacher tool;
+  return tool.main(argc, argv);
+}
+
+/// @endcond
@@ -51,6 +51,7 @@
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/TransformationXMLFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVReader.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinaryFile.h>
 #include <OpenMS/FORMAT/CachedMzML.h>
 #include <OpenMS/FORMAT/SwathFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/SwathWindowLoader.h>
@@ -74,7 +75,12 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/MRMTransitionGroupPicker.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/SwathMapMassCorrection.h>
 
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+#include <QtCore/QWaitCondition>
+
 #include <assert.h>
+#include <deque>
 
 #define OPENSWATH_WORKFLOW_DEBUG
 
@@ -92,15 +98,99 @@ namespace OpenMS
   /**
    * @brief Class to write out an OpenSwath TSV output (mProphet input)
    *
+   * The output is written asynchronously: the scoring threads only format
+   * their lines and hand them over as a single block to a bounded queue
+   * (see writeLines), a dedicated writer thread appends the blocks to the
+   * file in the order in which they were queued. Thus, the file content is
+   * the same as if each block had been written directly by the calling
+   * thread. All queued data is written when the writer is closed or
+   * destroyed.
+   *
    */
   class OpenSwathTSVWriter
   {
+    /// Background thread which writes the queued blocks to disk
+    class WriterThread :
+      public QThread
+    {
+    public:
+      explicit WriterThread(OpenSwathTSVWriter & writer) :
+        writer_(writer)
+      {}
+
+    protected:
+      void run()
+      {
+        writer_.writeQueuedBlocks_();
+      }
+
+    private:
+      OpenSwathTSVWriter & writer_;
+    };
+
     std::ofstream ofs;
     String input_filename_;
     bool doWrite_;
     bool use_ms1_traces_;
     bool enable_uis_scoring_;
 
+    /// Blocks of output waiting to be written (filled by the scoring threads, emptied by writer_thread_)
+    std::deque<String> queue_;
+    /// Maximal number of blocks in the queue before producers have to wait
+    Size max_queue_size_;
+    /// Whether close() was called (no more blocks will be queued)
+    bool finished_;
+    QMutex queue_mutex_;
+    QWaitCondition queue_not_empty_;
+    QWaitCondition queue_not_full_;
+    WriterThread writer_thread_;
+
+    /// Queues a block of output (the content of @p block is moved into the queue)
+    void enqueue_(String & block)
+    {
+      queue_mutex_.lock();
+      while (queue_.size() >= max_queue_size_)
+      {
+        queue_not_full_.wait(&queue_mutex_);
+      }
+      queue_.push_back(String());
+      queue_.back().swap(block);
+      queue_not_empty_.wakeOne();
+      queue_mutex_.unlock();
+    }
+
+    /// Main loop of the writer thread, returns after close() once all blocks are written
+    void writeQueuedBlocks_()
+    {
+      String block;
+      while (true)
+      {
+        queue_mutex_.lock();
+        while (queue_.empty() && !finished_)
+        {
+          queue_not_empty_.wait(&queue_mutex_);
+        }
+        if (queue_.empty())
+        {
+          queue_mutex_.unlock();
+          break;
+        }
+        block.swap(queue_.front());
+        queue_.pop_front();
+        queue_not_full_.wakeOne();
+        queue_mutex_.unlock();
+
+        // the actual I/O happens outside of the lock
+        ofs << block;
+        block.clear();
+      }
+      ofs.flush();
+    }
+
+    // not copyable (owns the output stream and the writer thread)
+    OpenSwathTSVWriter(const OpenSwathTSVWriter & rhs);
+    OpenSwathTSVWriter & operator=(const OpenSwathTSVWriter & rhs);
+
   public:
 
     OpenSwathTSVWriter(String output_filename, String input_filename = "inputfile", bool ms1_scores = false, bool uis_scores = false) :
@@ -108,17 +198,45 @@ namespace OpenMS
       input_filename_(input_filename),
       doWrite_(!output_filename.empty()),
       use_ms1_traces_(ms1_scores),
-      enable_uis_scoring_(uis_scores)
-      {}
+      enable_uis_scoring_(uis_scores),
+      max_queue_size_(64),
+      finished_(false),
+      writer_thread_(*this)
+    {
+      if (doWrite_)
+      {
+        writer_thread_.start();
+      }
+    }
+
+    ~OpenSwathTSVWriter()
+    {
+      close();
+    }
 
     bool isActive() 
     {
       return doWrite_;
     }
 
+    /// Writes all queued output and stops the writer thread
+    void close()
+    {
+      if (!doWrite_) return;
+
+      queue_mutex_.lock();
+      finished_ = true;
+      queue_not_empty_.wakeAll();
+      queue_mutex_.unlock();
+      writer_thread_.wait();
+    }
+
     void writeHeader()
     {
-      ofs << "transition_group_id\tpeptide_group_label\trun_id\tfilename\tRT\tid\tSequence\tFullPeptideName" <<
+      if (!doWrite_) return;
+
+      std::stringstream header;
+      header << "transition_group_id\tpeptide_group_label\trun_id\tfilename\tRT\tid\tSequence\tFullPeptideName" <<
         "\tCharge\tm/z\tIntensity\tProteinName\tdecoy\tassay_rt\tdelta_rt\tleftWidth" <<
         "\tmain_var_xx_swath_prelim_score\tnorm_RT\tnr_peaks\tpeak_apices_sum\tpotentialOutlier" <<
         "\trightWidth\trt_score\tsn_ratio\ttotal_xic\tvar_bseries_score\tvar_dotprod_score" <<
@@ -130,17 +248,17 @@ namespace OpenMS
         "\tvar_yseries_score\tvar_elution_model_fit_score";
       if (use_ms1_traces_)
       {
-        ofs << "\tvar_ms1_ppm_diff\tvar_ms1_isotope_corr\tvar_ms1_isotope_overlap\tvar_ms1_xcorr_coelution\tvar_ms1_xcorr_shape";
+        header << "\tvar_ms1_ppm_diff\tvar_ms1_isotope_corr\tvar_ms1_isotope_overlap\tvar_ms1_xcorr_coelution\tvar_ms1_xcorr_shape";
       }
-      ofs << "\txx_lda_prelim_score\txx_swath_prelim_score";
+      header << "\txx_lda_prelim_score\txx_swath_prelim_score";
       if (use_ms1_traces_)
       {
-        ofs << "\taggr_prec_Peak_Area\taggr_prec_Peak_Apex\taggr_prec_Fragment_Annotation";
+        header << "\taggr_prec_Peak_Area\taggr_prec_Peak_Apex\taggr_prec_Fragment_Annotation";
       }
-      ofs << "\taggr_Peak_Area\taggr_Peak_Apex\taggr_Fragment_Annotation";
+      header << "\taggr_Peak_Area\taggr_Peak_Apex\taggr_Fragment_Annotation";
       if (enable_uis_scoring_)
       {
-        ofs << "\tuis_target_transition_names"
+        header << "\tuis_target_transition_names"
             << "\tuis_target_var_ind_log_intensity"
             << "\tuis_target_num_transitions"
             << "\tuis_target_var_ind_xcorr_coelution"
@@ -159,7 +277,10 @@ namespace OpenMS
             << "\tuis_decoy_var_ind_isotope_correlation"
             << "\tuis_decoy_var_ind_isotope_overlap";
       }
-      ofs << "\n";
+      header << "\n";
+
+      String block = header.str();
+      enqueue_(block);
     }
 
     String prepareLine(const OpenSwath::LightCompound& pep,
@@ -333,9 +454,23 @@ namespace OpenMS
       return result;
     }
 
-    void writeLines(std::vector<String> to_output)
+    /**
+     * @brief Queues the given lines for writing
+     *
+     * The lines are concatenated into a single, pre-sized block which is
+     * written by the writer thread. This function may be called from
+     * multiple threads concurrently; it only blocks while the queue is full.
+     */
+    void writeLines(const std::vector<String> & to_output)
     {
-      for (Size i = 0; i < to_output.size(); i++) { ofs << to_output[i]; }
+      if (!doWrite_ || to_output.empty()) return;
+
+      Size total_size = 0;
+      for (Size i = 0; i < to_output.size(); i++) { total_size += to_output[i].size(); }
+      String block;
+      block.reserve(total_size);
+      for (Size i = 0; i < to_output.size(); i++) { block += to_output[i]; }
+      enqueue_(block);
     }
 
   };
@@ -469,7 +604,6 @@ namespace OpenMS
 
       std::cout << "Will analyze " << transition_exp.transitions.size() << " transitions in total." << std::endl;
       int progress = 0;
-      this->startProgress(0, swath_maps.size(), "Extracting and scoring transitions");
 
       // (i) Obtain precursor chromatograms (MS1) if precursor extraction is enabled
       std::map< std::string, OpenSwath::ChromatogramPtr > ms1_chromatograms;
@@ -511,10 +645,11 @@ namespace OpenMS
         }
       }
 
-      // (ii) Perform extraction and scoring of fragment ion chromatograms (MS2)
-      // We set dynamic scheduling such that the maps are worked on in the order
-      // in which they were given to the program / acquired. This gives much
-      // better load balancing than static allocation.
+      // (ii) Select the transitions of each SWATH map and split them into
+      // work units of (SWATH map, batch). Scheduling these units instead of
+      // whole maps keeps all threads busy even if the number of assays per
+      // map is very uneven (e.g. variable window sizes).
+      std::vector< OpenSwath::LightTargetedExperiment > transition_exp_per_map(swath_maps.size());
 #ifdef _OPENMP
 #pragma omp parallel for schedule(dynamic,1)
 #endif
@@ -522,112 +657,187 @@ namespace OpenMS
       {
         if (!swath_maps[i].ms1) // skip MS1
         {
+          OpenSwathHelper::selectSwathTransitions(transition_exp, transition_exp_per_map[i],
+              cp.min_upper_edge_dist, swath_maps[i].lower, swath_maps[i].upper);
+        }
+      }
 
-          OpenSwath::SpectrumAccessPtr current_swath_map = swath_maps[i].sptr;
+      std::vector< std::pair<Size, Size> > work_units; // (SWATH map index, batch index)
+      std::vector< int > batch_size_per_map(swath_maps.size(), 0);
+      std::vector< Size > open_units_per_map(swath_maps.size(), 0);
+      for (Size i = 0; i < swath_maps.size(); ++i)
+      {
+        const Size nr_compounds = transition_exp_per_map[i].getCompounds().size();
+        if (transition_exp_per_map[i].getTransitions().empty()) continue; // skip if no transitions found
 
-          if (load_into_memory)
-          {
-            // This creates an InMemory object that keeps all data in memory
-            // but provides the same access functionality to the raw data as
-            // any object implementing ISpectrumAccess 
-            current_swath_map = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*current_swath_map) );
-            std::cout << " loading all data completely into memory !!! " << std::endl;
-          }
+        int batch_size;
+        if (batchSize <= 0 || batchSize >= (int)nr_compounds)
+        {
+          batch_size = nr_compounds;
+        }
+        else
+        {
+          batch_size = batchSize;
+        }
+        batch_size_per_map[i] = batch_size;
 
-          // Step 1: select which transitions to extract (proceed in batches)
-          OpenSwath::LightTargetedExperiment transition_exp_used_all;
-          OpenSwathHelper::selectSwathTransitions(transition_exp, transition_exp_used_all,
-              cp.min_upper_edge_dist, swath_maps[i].lower, swath_maps[i].upper);
-          if (transition_exp_used_all.getTransitions().size() > 0) // skip if no transitions found
-          {
+        const Size nr_batches = (nr_compounds + batch_size - 1) / batch_size;
+        for (Size pep_idx = 0; pep_idx < nr_batches; ++pep_idx)
+        {
+          work_units.push_back(std::make_pair(i, pep_idx));
+        }
+        open_units_per_map[i] = nr_batches;
+
+        std::cout << "Will analyze " << nr_compounds <<  " compounds and "
+          << transition_exp_per_map[i].getTransitions().size() <<  " transitions "
+          "from SWATH " << i << " in batches of " << batch_size << std::endl;
+      }
 
-            int batch_size;
-            if (batchSize <= 0 || batchSize >= (int)transition_exp_used_all.getCompounds().size())
+      // (iii) Perform extraction and scoring of fragment ion chromatograms (MS2)
+      // The work units are ordered by SWATH map and dynamic scheduling hands
+      // them out in this order, so only a few maps are worked on at the same
+      // time. The features of each unit are stored separately and merged in
+      // the order of the units at the end, thus the output does not depend
+      // on the thread timing.
+      std::vector< FeatureMap > features_per_unit(store_features ? work_units.size() : 0);
+      // maps loaded into memory (shared by all units of a map, released after its last unit)
+      std::vector< OpenSwath::SpectrumAccessPtr > in_memory_maps(swath_maps.size());
+      std::vector< bool > map_loading(swath_maps.size(), false);
+      this->startProgress(0, work_units.size(), "Extracting and scoring transitions");
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+      for (SignedSize unit_idx = 0; unit_idx < boost::numeric_cast<SignedSize>(work_units.size()); ++unit_idx)
+      {
+        const Size i = work_units[unit_idx].first;
+        const Size pep_idx = work_units[unit_idx].second;
+
+        OpenSwath::SpectrumAccessPtr current_swath_map;
+        if (load_into_memory)
+        {
+          // This creates an InMemory object that keeps all data in memory
+          // but provides the same access functionality to the raw data as
+          // any object implementing ISpectrumAccess. Read access to it is
+          // thread-safe, so all units of this map share a single copy. The
+          // first unit of a map loads it outside of the critical section,
+          // thus several maps can be loaded at the same time.
+          bool load_map = false;
+#ifdef _OPENMP
+#pragma omp critical (inMemoryMaps)
+#endif
+          {
+            if (in_memory_maps[i])
             {
-              batch_size = transition_exp_used_all.getCompounds().size();
+              current_swath_map = in_memory_maps[i];
             }
-            else
+            else if (!map_loading[i])
             {
-              batch_size = batchSize;
+              map_loading[i] = true;
+              load_map = true;
             }
-
+          }
+          if (load_map)
+          {
+            LOG_DEBUG << "Loading all data of SWATH " << i << " completely into memory" << std::endl;
+            OpenSwath::SpectrumAccessPtr loaded_map = swath_maps[i].sptr->lightClone();
+            loaded_map = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*loaded_map) );
 #ifdef _OPENMP
-#pragma omp critical (featureFinder)
+#pragma omp critical (inMemoryMaps)
 #endif
             {
-              std::cout << "Thread " <<
-#ifdef _OPENMP
-              omp_get_thread_num() << " " <<
-#endif
-              "will analyze " << transition_exp_used_all.getCompounds().size() <<  " compounds and "
-              << transition_exp_used_all.getTransitions().size() <<  " transitions "
-              "from SWATH " << i << " in batches of " << batch_size << std::endl;
+              in_memory_maps[i] = loaded_map;
             }
+            current_swath_map = loaded_map;
+          }
+        }
+        if (!current_swath_map)
+        {
+          // Several threads may work on the same map (or its in-memory copy
+          // is still being loaded by another thread), thus each of them
+          // needs its own (light) clone of the spectrum access.
+          current_swath_map = swath_maps[i].sptr->lightClone();
+        }
 
-            for (size_t pep_idx = 0; pep_idx <= (transition_exp_used_all.getCompounds().size() / batch_size); pep_idx++)
-            {
-              // Create the new, batch-size transition experiment
-              OpenSwath::LightTargetedExperiment transition_exp_used;
-              selectCompoundsForBatch_(transition_exp_used_all, transition_exp_used, batch_size, pep_idx);
-
-              // Step 2.1: extract these transitions
-              ChromatogramExtractor extractor;
-              boost::shared_ptr<MSExperiment<Peak1D> > chrom_exp(new MSExperiment<Peak1D>);
-              std::vector< OpenSwath::ChromatogramPtr > chrom_list;
-              std::vector< ChromatogramExtractor::ExtractionCoordinates > coordinates;
-
-              // Step 2.2: prepare the extraction coordinates & extract chromatograms
-              prepare_coordinates_wrap(chrom_list, coordinates, transition_exp_used, false, trafo_inverse, cp);
-              extractor.extractChromatograms(current_swath_map, chrom_list, coordinates, cp.mz_extraction_window,
-                  cp.ppm, cp.extraction_function);
-
-              // Step 2.3: convert chromatograms back and write to output
-              std::vector< OpenMS::MSChromatogram<> > chromatograms;
-              extractor.return_chromatogram(chrom_list, coordinates, transition_exp_used,  SpectrumSettings(), chromatograms, false);
-              chrom_exp->setChromatograms(chromatograms);
-              OpenSwath::SpectrumAccessPtr chromatogram_ptr = OpenSwath::SpectrumAccessPtr(new OpenMS::SpectrumAccessOpenMS(chrom_exp));
-
-              // Step 3: score these extracted transitions
-              FeatureMap featureFile;
-              scoreAllChromatograms(chromatogram_ptr, current_swath_map, transition_exp_used,
-                  feature_finder_param, trafo, cp.rt_extraction_window, featureFile, tsv_writer, 
-                  ms1_chromatograms);
-
-              // Step 4: write all chromatograms and features out into an output object / file
-              // (this needs to be done in a critical section since we only have one
-              // output file and one output map).
+        // Step 1: Create the new, batch-size transition experiment
+        OpenSwath::LightTargetedExperiment transition_exp_used;
+        selectCompoundsForBatch_(transition_exp_per_map[i], transition_exp_used, batch_size_per_map[i], pep_idx);
+
+        // Step 2.1: extract these transitions
+        ChromatogramExtractor extractor;
+        boost::shared_ptr<MSExperiment<Peak1D> > chrom_exp(new MSExperiment<Peak1D>);
+        std::vector< OpenSwath::ChromatogramPtr > chrom_list;
+        std::vector< ChromatogramExtractor::ExtractionCoordinates > coordinates;
+
+        // Step 2.2: prepare the extraction coordinates & extract chromatograms
+        prepare_coordinates_wrap(chrom_list, coordinates, transition_exp_used, false, trafo_inverse, cp);
+        extractor.extractChromatograms(current_swath_map, chrom_list, coordinates, cp.mz_extraction_window,
+            cp.ppm, cp.extraction_function);
+
+        // Step 2.3: convert chromatograms back and write to output
+        std::vector< OpenMS::MSChromatogram<> > chromatograms;
+        extractor.return_chromatogram(chrom_list, coordinates, transition_exp_used,  SpectrumSettings(), chromatograms, false);
+        chrom_exp->setChromatograms(chromatograms);
+        OpenSwath::SpectrumAccessPtr chromatogram_ptr = OpenSwath::SpectrumAccessPtr(new OpenMS::SpectrumAccessOpenMS(chrom_exp));
+
+        // Step 3: score these extracted transitions
+        FeatureMap featureFile;
+        scoreAllChromatograms(chromatogram_ptr, current_swath_map, transition_exp_used,
+            feature_finder_param, trafo, cp.rt_extraction_window, featureFile, tsv_writer, 
+            ms1_chromatograms);
+
+        // Step 4: keep the features of this unit for the final merge
+        if (store_features)
+        {
+          features_per_unit[unit_idx].swap(featureFile);
+        }
+
+        // Step 5: write all chromatograms out into the output consumer (this
+        // needs to be done in a critical section since we only have one
+        // output file).
 #ifdef _OPENMP
 #pragma omp critical (featureFinder)
 #endif
-              {
-                // write chromatograms to output if so desired
-                for (Size chrom_idx = 0; chrom_idx < chromatograms.size(); ++chrom_idx)
-                {
-                  chromConsumer->consumeChromatogram(chromatograms[chrom_idx]);
-                }
+        {
+          for (Size chrom_idx = 0; chrom_idx < chromatograms.size(); ++chrom_idx)
+          {
+            chromConsumer->consumeChromatogram(chromatograms[chrom_idx]);
+          }
+          this->setProgress(progress++);
+        }
 
-                // write features to output if so desired
-                if (store_features)
-                {
-                  for (FeatureMap::iterator feature_it = featureFile.begin();
-                       feature_it != featureFile.end(); ++feature_it)
-                  {
-                    out_featureFile.push_back(*feature_it);
-                  }
-                  for (std::vector<ProteinIdentification>::iterator protid_it =
-                         featureFile.getProteinIdentifications().begin();
-                       protid_it != featureFile.getProteinIdentifications().end();
-                       ++protid_it)
-                  {
-                    out_featureFile.getProteinIdentifications().push_back(*protid_it);
-                  }
-                  this->setProgress(progress++);
-                }
-              }
-            }
+        // release the in-memory copy and the transitions of the map after its last unit
+        current_swath_map.reset();
+#ifdef _OPENMP
+#pragma omp critical (inMemoryMaps)
+#endif
+        {
+          if (--open_units_per_map[i] == 0)
+          {
+            in_memory_maps[i].reset();
+            OpenSwath::LightTargetedExperiment().transitions.swap(transition_exp_per_map[i].transitions);
+            OpenSwath::LightTargetedExperiment().compounds.swap(transition_exp_per_map[i].compounds);
+            OpenSwath::LightTargetedExperiment().proteins.swap(transition_exp_per_map[i].proteins);
+          }
+        }
+      }
 
-          } // continue 2 (no continue due to OpenMP)
-        } // continue 1 (no continue due to OpenMP)
+      // (iv) Merge the features of all units
+      for (Size unit_idx = 0; unit_idx < features_per_unit.size(); ++unit_idx)
+      {
+        FeatureMap & featureFile = features_per_unit[unit_idx];
+        for (FeatureMap::iterator feature_it = featureFile.begin();
+             feature_it != featureFile.end(); ++feature_it)
+        {
+          out_featureFile.push_back(*feature_it);
+        }
+        for (std::vector<ProteinIdentification>::iterator protid_it =
+               featureFile.getProteinIdentifications().begin();
+             protid_it != featureFile.getProteinIdentifications().end();
+             ++protid_it)
+        {
+          out_featureFile.getProteinIdentifications().push_back(*protid_it);
+        }
+        featureFile.clear(true);
       }
       this->endProgress();
     }
@@ -1080,15 +1290,11 @@ namespace OpenMS
         }
       }
 
-      // Only write at the very end since this is a step needs a barrier
+      // Only write at the very end (the writer is thread-safe and performs
+      // the I/O in its own thread)
       if (tsv_writer.isActive())
       {
-#ifdef _OPENMP
-#pragma omp critical (scoreAll)
-#endif
-        {
-          tsv_writer.writeLines(to_output);
-        }
+        tsv_writer.writeLines(to_output);
       }
     }
 
@@ -1542,10 +1748,10 @@ protected:
     registerInputFileList_("in", "<files>", StringList(), "Input files separated by blank");
     setValidFormats_("in", ListUtils::create<String>("mzML,mzXML"));
 
-    registerInputFile_("tr", "<file>", "", "transition file ('TraML','tsv' or 'csv')");
-    setValidFormats_("tr", ListUtils::create<String>("traML,tsv,csv"));
+    registerInputFile_("tr", "<file>", "", "transition file ('TraML','tsv', 'csv' or a binary 'oslib' library created by OpenSwathAssayLibraryCacher)");
+    setValidFormats_("tr", ListUtils::create<String>("traML,tsv,csv,oslib"));
     registerStringOption_("tr_type", "<type>", "", "input file type -- default: determined from file extension or content\n", false);
-    setValidStrings_("tr_type", ListUtils::create<String>("traML,tsv,csv"));
+    setValidStrings_("tr_type", ListUtils::create<String>("traML,tsv,csv,oslib"));
 
     // one of the following two needs to be set
     registerInputFile_("tr_irt", "<file>", "", "transition file ('TraML')", false);
@@ -1969,7 +2175,13 @@ protected:
     progresslogger.setLogType(log_type_);
     progresslogger.startProgress(0, swath_maps.size(), "Load TraML file");
     FileTypes::Type tr_file_type = FileTypes::nameToType(tr_file);
-    if (tr_file_type == FileTypes::TRAML || tr_file.suffix(5).toLower() == "traml"  )
+    if (tr_type == FileTypes::OSLIB || TransitionBinaryFile::isBinaryLibrary(tr_file))
+    {
+      TransitionBinaryFile binary_file;
+      binary_file.setLogType(log_type_);
+      binary_file.load(tr_file, transition_exp);
+    }
+    else if (tr_file_type == FileTypes::TRAML || tr_file.suffix(5).toLower() == "traml"  )
     {
       TargetedExperiment targeted_exp;
       TraMLFile().load(tr_file, targeted_exp);
@@ -2013,6 +2225,7 @@ protected:
 
     wf.performExtraction(swath_maps, trafo_rtnorm, cp, feature_finder_param, transition_exp,
         out_featureFile, !out.empty(), tsvwriter, chromConsumer, batchSize, load_into_memory);
+    tsvwriter.close();
     if (!out.empty())
     {
       addDataProcessing_(out_featureFile, getProcessingInfo_(DataProcessing::QUANTITATION));
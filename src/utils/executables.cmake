@@ -62,6 +62,7 @@ if(NOT DISABLE_OPENSWATH)
     ConvertTraMLToTSV
     OpenSwathDIAPreScoring
     OpenSwathMzMLFileCacher
+    OpenSwathAssayLibraryCacher
     OpenSwathWorkflow
     OpenSwathFileSplitter
     OpenSwathRewriteToFeatureXML